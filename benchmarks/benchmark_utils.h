@@ -0,0 +1,256 @@
+/**
+ * @file                benchmark_utils.h
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Helpers shared by the benchmark programs (timing, printing tables and formatting numbers)
+ */
+
+#ifndef AG_BENCHMARK_UTILS_GUARD_H
+
+#define     AG_BENCHMARK_UTILS_GUARD_H
+
+#include <iostream>
+#include <chrono>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
+
+#include <cstdint>
+#include <cstdlib>
+
+
+struct Timer {
+
+    private:
+
+    std::chrono::high_resolution_clock::time_point      mStart;
+    std::chrono::high_resolution_clock::time_point      mEnd;
+
+    public:
+
+    Timer ()
+    {
+        reset ();
+    }
+
+    int64_t
+    elapsed_ms ()
+    {
+        mEnd        = std::chrono::high_resolution_clock::now ();
+        auto diff   = std::chrono::duration_cast<std::chrono::milliseconds> (mEnd - mStart).count ();
+
+        return diff;
+    }
+
+    int64_t
+    elapsed_us ()
+    {
+        mEnd        = std::chrono::high_resolution_clock::now ();
+        auto diff   = std::chrono::duration_cast<std::chrono::microseconds> (mEnd - mStart).count ();
+
+        return diff;
+    }
+
+    int64_t
+    elapsed_ns ()
+    {
+        mEnd        = std::chrono::high_resolution_clock::now ();
+        auto diff   = std::chrono::duration_cast<std::chrono::nanoseconds> (mEnd - mStart).count ();
+
+        return diff;
+    }
+
+    void
+    reset ()
+    {
+        mStart      = std::chrono::high_resolution_clock::now ();
+    }
+};
+
+struct table {
+
+    private:
+
+    std::vector<std::string>                mHeaders;
+    std::vector<std::vector<std::string>>   mRows;
+
+    public:
+
+    table ()
+    {}
+
+    void
+    add_headers (std::initializer_list<std::string> pHeaders)
+    {
+        if (pHeaders.size () == 0)
+        {
+            std::cout << "ZERO COLOUMNS NOT ALLOWED IN TABLE\n";
+            std::exit (1);
+        }
+        mHeaders            = pHeaders;
+    }
+
+    void
+    add_row (std::initializer_list<std::string> pElems)
+    {
+        if (pElems.size () != mHeaders.size ())
+        {
+            std::cout << "NUMBER OF COLOUMNS IN ROW MUST MATCH NUMBER OF COLOUMNS IN HEADER\n";
+            std::exit (1);
+        }
+
+        mRows.push_back (pElems);
+    }
+
+    friend std::ostream
+    &operator<< (std::ostream &stream, const table &pOther)
+    {
+        int32_t                 cols    = (int32_t)pOther.mHeaders.size ();
+        int32_t                 width   = 0;
+
+        std::vector<int32_t>    sz (cols);
+
+        for(int32_t col = 0; col < cols; ++col) {
+            sz[col] = (int32_t)pOther.mHeaders[col].size ();
+        }
+
+        for (auto &e : pOther.mRows) {
+            for (int32_t col = 0; col < cols; ++col) {
+
+                sz[col] = std::max (sz[col], (int32_t)e[col].size ());
+            }
+        }
+
+        for (auto &e : sz) {
+            e       += 4;
+            width   += e;
+        }
+
+        // print the headers
+        for (int32_t i = 0; i < width; ++i) {
+            stream << '-';
+        }
+        stream << '-' << '\n';
+
+        for (int32_t i = 0; i < cols; ++i) {
+            stream << "| ";
+            stream << pOther.mHeaders[i];
+            for (int32_t pad = (int32_t)pOther.mHeaders[i].size () + 2; pad < sz[i]; ++pad) {
+                stream << ' ';
+            }
+        }
+        stream << '|' << '\n';
+
+        for (int32_t i = 0; i < width; ++i) {
+            stream << '-';
+        }
+        stream << '-' << '\n';
+
+        for (auto &row : pOther.mRows) {
+            for (int32_t i = 0; i < cols; ++i) {
+                stream << "| ";
+                stream << row[i];
+                for (int32_t pad = (int32_t)row[i].size () + 2; pad < sz[i]; ++pad) {
+                    stream << ' ';
+                }
+            }
+            stream << '|' << '\n';
+        }
+
+        if (pOther.mRows.size () == 0) {
+            return stream;
+        }
+
+        for (int32_t i = 0; i < width; ++i) {
+            stream << '-';
+        }
+        stream << '-' << '\n';
+
+        return stream;
+    }
+};
+
+template <typename T>
+std::string
+format_integer (T pNum)
+{
+
+    T           cpy {pNum};
+    int32_t     len {};
+
+    std::string res;
+
+    if(pNum == 0) {
+        return "0";
+    }
+
+    while (cpy) {
+        ++len, cpy /= 10;
+    }
+
+    for (int32_t i = 0, d; i < len; ++i) {
+
+        d = pNum % 10;
+        pNum /= 10;
+
+        res += (char) (d + '0');
+        if (i % 3 == 2 && i != len - 1) {
+            res += ',';
+        }
+    }
+
+    for (auto i = 0; i < (int32_t)(res.size () / 2); ++i) {
+        std::swap (res[i], res[res.size () - i - 1]);
+    }
+
+    return res;
+}
+
+/**
+ * @brief               Parses the positive quantities given on the command line (starting at the given argument)
+ *
+ * @param argc          Number of arguments
+ * @param argv          Arguments
+ * @param pFirst        Position of the first argument which is a quantity
+ *
+ * @return              Valid quantities (invalid ones are reported and ignored)
+ */
+inline std::vector<int64_t>
+parse_quantities (int argc, char *argv[], int pFirst)
+{
+    std::vector<int64_t>    res;
+
+    for (int32_t i = pFirst; i < argc; ++i) {
+
+        int64_t     quantity    = atoll (argv[i]);
+
+        if (quantity <= 0) {
+            std::cout << "Ignoring invalid quantity \"" << argv[i] << "\"\n";
+            continue;
+        }
+
+        res.push_back (quantity);
+    }
+
+    return res;
+}
+
+/**
+ * @brief               Returns the next value of a xorshift64 generator (threads which share it should each keep their own state)
+ *
+ * @param pState        State of the generator
+ *
+ * @return uint64_t     Next pseudo random value
+ */
+inline uint64_t
+next_random (uint64_t &pState)
+{
+    pState  ^= pState << 13;
+    pState  ^= pState >> 7;
+    pState  ^= pState << 17;
+
+    return pState;
+}
+
+#endif          // Header Guard
@@ -0,0 +1,160 @@
+/**
+ * @file                frozen_lookup.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to benchmark building frozen tables, and searching them compared to the other tables
+ *
+ * Usage: frozen_lookup <keys1 [keys2...]>
+ *
+ * keys:           Number of keys to insert into the tables before freezing them
+ *
+ * Example: frozen_lookup 1000000 10000000
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include <unordered_set>
+
+#include "AgHashTable.h"
+#include "AgFrozenHashTable.h"
+#include "benchmark_utils.h"
+
+
+/**
+ * @brief               Searches a table for every key (which all exist) and for as many keys which do not exist, and adds a row with the
+ *                      times taken
+ *
+ * @tparam table_t      Type of table
+ *
+ * @param pName         Name of the table to print
+ * @param pTable        Table to search
+ * @param pHits         Keys which exist in the table
+ * @param pMisses       Keys which do not exist in the table
+ * @param pBytes        Number of bytes used by the table in addition to its keys (empty if not known)
+ * @param pResults      Table of results to add the row to
+ */
+template <typename table_t>
+void
+run_lookups (const std::string &pName, const table_t &pTable, const std::vector<int64_t> &pHits, const std::vector<int64_t> &pMisses,
+             const std::string &pBytes, table &pResults)
+{
+    Timer                               timer;
+    int64_t                             hitMs;
+    int64_t                             missMs;
+    uint64_t                            found   {0};
+
+    timer.reset ();
+    for (auto &key : pHits) {
+        found   += (uint64_t)(pTable.find (key) != pTable.end ());
+    }
+    hitMs       = timer.elapsed_ms ();
+
+    timer.reset ();
+    for (auto &key : pMisses) {
+        found   += (uint64_t)(pTable.find (key) != pTable.end ());
+    }
+    missMs      = timer.elapsed_ms ();
+
+    pResults.add_row ({pName, format_integer (found), format_integer (hitMs), format_integer (missMs), pBytes});
+}
+
+void
+run_benchmark (int64_t pN)
+{
+    table                               buildResults;
+    table                               lookupResults;
+    uint64_t                            threads     = std::thread::hardware_concurrency ();
+
+    std::vector<int64_t>                hits;
+    std::vector<int64_t>                misses;
+    uint64_t                            state       {0x9E3779B97F4A7C15ULL};
+
+    AgHashTable<int64_t>                                                                                        chained;
+    AgHashTable<int64_t, ag_default_hash<int64_t, size_t> (), ag_hashtable_default_equals<int64_t>, AgCuckooLayout<>>  cuckoo;
+
+    Timer                               timer;
+    int64_t                             measured;
+
+    std::cout << '\n';
+    std::cout << format_integer (pN) << " Keys\n";
+    std::cout << '\n';
+
+    // the keys are searched for in a different order than they are inserted in
+    for (int64_t i = 0; i < pN; ++i) {
+        hits.push_back ((int64_t)next_random (state));
+        misses.push_back ((int64_t)next_random (state));
+    }
+
+    for (auto &key : hits) {
+        chained.insert (key);
+        cuckoo.insert (key);
+    }
+
+    for (int64_t i = pN - 1; i > 0; --i) {
+        std::swap (hits[i], hits[next_random (state) % (uint64_t)(i + 1)]);
+    }
+
+    buildResults.add_headers ({"Build", "Keys", "Time (ms)", "Overhead (bits/key)"});
+
+    timer.reset ();
+    auto        frozen      = ag_freeze (chained);
+    measured    = timer.elapsed_ms ();
+
+    buildResults.add_row ({"ag_freeze (1 thread)", format_integer (frozen.size ()), format_integer (measured),
+                           std::to_string (8.0 * (double)frozen.get_overhead_bytes () / (double)frozen.size ())});
+
+    // building the levels and placing the keys is split across every hardware thread
+    if (threads > 1) {
+        timer.reset ();
+        auto    frozenParallel  = ag_freeze (chained, threads);
+        measured    = timer.elapsed_ms ();
+
+        buildResults.add_row ({"ag_freeze (" + std::to_string (threads) + " threads)", format_integer (frozenParallel.size ()),
+                               format_integer (measured), std::to_string (8.0 * (double)frozenParallel.get_overhead_bytes () / (double)frozenParallel.size ())});
+    }
+
+    std::cout << buildResults << '\n';
+
+    lookupResults.add_headers ({"Class", "Found", "Hits (ms)", "Misses (ms)", "Overhead (bytes)"});
+
+    run_lookups ("AgHashTable", chained, hits, misses, "", lookupResults);
+    run_lookups ("AgHashTable (Cuckoo)", cuckoo, hits, misses, format_integer (sizeof (int64_t) * (cuckoo.get_slot_count () - cuckoo.size ())), lookupResults);
+    run_lookups ("AgFrozenHashTable", frozen, hits, misses, format_integer (frozen.get_overhead_bytes ()), lookupResults);
+
+    std::cout << lookupResults << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <keys1 [keys2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "keys:\t\tNumber of keys to insert into the tables before freezing them\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 1000000 10000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    for (auto &quantity : args) {
+        run_benchmark (quantity);
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file                growth_policies.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to compare the memory used by AgHashTable and its throughput under each preset growth policy
+ *
+ * Usage: growth_policies <keys1 [keys2...]>
+ *
+ * keys:           Number of keys to insert
+ *
+ * Example: growth_policies 1000000 10000000
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+// the amount of memory held by the table is only tracked in debug mode
+#define AG_DBG_MODE
+#include "AgHashTable.h"
+#include "benchmark_utils.h"
+
+
+/**
+ * @brief               Formats a floating point number with two decimal places
+ *
+ */
+std::string
+format_decimal (double pNum)
+{
+    std::ostringstream      stream;
+
+    stream << std::fixed << std::setprecision (2) << pNum;
+    return stream.str ();
+}
+
+/**
+ * @brief               Inserts pN pseudo random keys into a fresh table with the given growth policy, searches for each of them and for
+ *                      as many absent keys, and adds a row with the time taken and the memory held by the table after the insertions
+ *
+ * @param pName         Name of the growth policy to print
+ * @param pGrowth       Growth policy
+ * @param pN            Number of keys
+ * @param pResults      Table of results to add the row to
+ */
+void
+run_one (const char *pName, const AgGrowthPolicy &pGrowth, int64_t pN, table &pResults)
+{
+    AgHashTable<int64_t>    container;
+
+    Timer                   timer;
+    int64_t                 insertMs;
+    int64_t                 hitMs;
+    int64_t                 missMs;
+
+    uint64_t                state       {0x9E3779B97F4A7C15ULL};
+    int64_t                 found       {0};
+
+    container.set_growth_policy (pGrowth);
+
+    timer.reset ();
+    for (int64_t i = 0; i < pN; ++i) {
+        container.insert ((int64_t)next_random (state));
+    }
+    insertMs    = timer.elapsed_ms ();
+
+    // the same sequence is generated again for the keys which were inserted
+    state       = 0x9E3779B97F4A7C15ULL;
+    timer.reset ();
+    for (int64_t i = 0; i < pN; ++i) {
+        found   += container.exists ((int64_t)next_random (state));
+    }
+    hitMs       = timer.elapsed_ms ();
+
+    // keys from a different sequence are (almost certainly) absent
+    state       = 0x2545F4914F6CDD1DULL;
+    timer.reset ();
+    for (int64_t i = 0; i < pN; ++i) {
+        found   += container.exists ((int64_t)next_random (state));
+    }
+    missMs      = timer.elapsed_ms ();
+
+    pResults.add_row ({pName,
+                       format_integer (insertMs),
+                       format_integer (hitMs),
+                       format_integer (missMs),
+                       format_integer (container.get_bucket_count ()),
+                       format_integer (container.get_resize_count ()),
+                       format_decimal ((double)container.get_alloc_amount () / (1024.0 * 1024.0)),
+                       format_decimal ((double)container.get_alloc_amount () / (double)pN),
+                       format_integer (found)});
+}
+
+void
+run_benchmark (int64_t pN)
+{
+    table                   results;
+    AgGrowthPolicy          previous    = AgGrowthPolicy::balanced ();
+
+    std::cout << '\n';
+    std::cout << format_integer (pN) << " Keys\n";
+    std::cout << '\n';
+
+    results.add_headers ({"Growth Policy", "Insertion (ms)", "Hits (ms)", "Misses (ms)", "Buckets", "Resizes", "Memory (MB)", "Bytes / Key", "Found"});
+
+    // the fixed policy used before growth policies could be configured
+    previous.maxBucketCount = 1ULL << 24;
+
+    run_one ("memory_lean", AgGrowthPolicy::memory_lean (), pN, results);
+    run_one ("balanced (default)", AgGrowthPolicy::balanced (), pN, results);
+    run_one ("latency_lean", AgGrowthPolicy::latency_lean (), pN, results);
+    run_one ("balanced (2^24 buckets)", previous, pN, results);
+
+    std::cout << results << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <keys1 [keys2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "keys:\t\tNumber of keys to insert\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 1000000 10000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    for (auto &quantity : args) {
+        run_benchmark (quantity);
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file                hash_collisions.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to measure how evenly 16 bit hashes spread sequential integers
+ *
+ * Usage: hash_collisions <keys1 [keys2...]>
+ *
+ * keys:           Number of sequential integers to hash
+ *
+ * Example: hash_collisions 10000 65536 1000000
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+
+#include "AgHashTable.h"
+#include "benchmark_utils.h"
+
+constexpr uint64_t      hashCount       = 1ULL << 16;       /** Number of distinct 16 bit hashes */
+
+volatile uint64_t       hashSink;                           /** Receives the combined hashes, so that the compiler can not skip computing them */
+
+
+/**
+ * @brief               16 bit hash which ag_pearson_16_hash used to compute (its table was the identity permutation, so it only folded
+ *                      the 16 bit words of the key together with xor), kept for comparison
+ *
+ */
+uint16_t
+xor_fold_16 (const int64_t *pKey)
+{
+    const uint16_t      *words  = (const uint16_t *)pKey;
+
+    return (uint16_t)(words[0] ^ words[1] ^ words[2] ^ words[3]);
+}
+
+/**
+ * @brief               Formats a floating point number with two decimal places
+ *
+ */
+std::string
+format_decimal (double pNum)
+{
+    std::ostringstream      stream;
+
+    stream << std::fixed << std::setprecision (2) << pNum;
+    return stream.str ();
+}
+
+/**
+ * @brief               Hashes the integers 0, pStride, 2 * pStride... and adds a row with the number of distinct hashes, the largest
+ *                      number of keys sharing a hash, and the chi-squared statistic of the counts (divided by its expected value,
+ *                      so that an ideal hash scores close to 1)
+ *
+ * @tparam hash_t       Callable which returns the 16 bit hash of a key
+ *
+ * @param pName         Name of the hash function to print
+ * @param pN            Number of keys
+ * @param pStride       Difference between consecutive keys
+ * @param pHash         Hash function
+ * @param pResults      Table of results to add the row to
+ */
+template <typename hash_t>
+void
+run_one (const char *pName, int64_t pN, int64_t pStride, hash_t pHash, table &pResults)
+{
+    std::vector<uint64_t>   counts      (hashCount);
+
+    Timer                   timer;
+    int64_t                 measured;
+
+    uint64_t                distinct    = 0;
+    uint64_t                maxCount    = 0;
+    uint64_t                sink        = 0;
+    double                  expected    = (double)pN / (double)hashCount;
+    double                  chiSquared  = 0;
+
+    timer.reset ();
+    for (int64_t i = 0; i < pN; ++i) {
+
+        int64_t             key     = i * pStride;
+        uint16_t            hash    = pHash (&key);
+
+        ++counts[hash];
+        sink        += hash;
+    }
+    measured    = timer.elapsed_ns ();
+
+    for (auto &count : counts) {
+        distinct    += (count > 0);
+        maxCount    = std::max (maxCount, count);
+        chiSquared  += ((double)count - expected) * ((double)count - expected) / expected;
+    }
+
+    pResults.add_row ({pName,
+                       format_integer (distinct),
+                       format_integer (maxCount),
+                       format_decimal (chiSquared / (double)(hashCount - 1)),
+                       format_decimal ((double)measured / (double)pN)});
+
+    hashSink    = sink;
+}
+
+void
+run_benchmark (int64_t pN)
+{
+    double                  idealDistinct   = (double)hashCount * (1.0 - std::pow (1.0 - 1.0 / (double)hashCount, (double)pN));
+
+    // consecutive keys, keys whose low bits never change, and keys whose 16 bit words repeat
+    for (int64_t stride : {1LL, 1024LL, 65537LL}) {
+
+        table               results;
+
+        std::cout << '\n';
+        std::cout << format_integer (pN) << " Keys with a stride of " << format_integer (stride) << '\n';
+        std::cout << "(a random function would give about " << format_integer ((uint64_t)idealDistinct) << " distinct hashes)\n";
+        std::cout << '\n';
+
+        results.add_headers ({"Function", "Distinct Hashes", "Max Keys per Hash", "Chi-Squared (ideal 1)", "ns / Hash"});
+
+        run_one ("xor fold (previous)", pN, stride, xor_fold_16, results);
+        run_one ("ag_pearson_16_hash", pN, stride, ag_pearson_16_hash<int64_t>, results);
+        run_one ("ag_fnv1a (low 16 bits)", pN, stride,
+                 [] (const int64_t *pKey) { return (uint16_t)ag_fnv1a<int64_t, uint64_t> (pKey); }, results);
+        run_one ("ag_wyhash (low 16 bits)", pN, stride,
+                 [] (const int64_t *pKey) { return (uint16_t)ag_wyhash<int64_t, uint64_t> (pKey); }, results);
+
+        std::cout << results << '\n';
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <keys1 [keys2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "keys:\t\tNumber of sequential integers to hash\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 10000 65536 1000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    for (auto &quantity : args) {
+        run_benchmark (quantity);
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
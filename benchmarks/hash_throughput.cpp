@@ -0,0 +1,186 @@
+/**
+ * @file                hash_throughput.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to benchmark the throughput of the hash functions in AgHashFunctions.hpp for inputs of a given size
+ *
+ * Usage: hash_throughput <size1 [size2...]>
+ *
+ * size:           Number of bytes in each input to hash
+ *
+ * Example: hash_throughput 8 16 32 64 1024 1048576
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+#include "AgHashTable.h"
+#include "benchmark_utils.h"
+
+constexpr uint64_t      bytesPerRow     = 1ULL << 29;       /** Number of bytes hashed for every row */
+constexpr uint64_t      bufferSize      = 1ULL << 20;       /** Size of the buffer the inputs are taken from (small enough to stay in the cache) */
+
+volatile uint64_t       hashSink;                           /** Receives the combined hashes, so that the compiler can not skip computing them */
+
+
+/**
+ * @brief               Key of a fixed number of bytes, to measure the fixed size variants
+ *
+ * @tparam tSize        Number of bytes
+ */
+template <uint64_t tSize>
+struct bytes_t {
+
+    uint8_t             bytes[tSize];
+};
+
+/**
+ * @brief               Formats a floating point number with two decimal places
+ *
+ */
+std::string
+format_decimal (double pNum)
+{
+    std::ostringstream      stream;
+
+    stream << std::fixed << std::setprecision (2) << pNum;
+    return stream.str ();
+}
+
+/**
+ * @brief               Hashes consecutive inputs of pSize bytes from the buffer until bytesPerRow bytes have been hashed, and adds a row
+ *                      with the throughput
+ *
+ * @tparam hash_t       Callable which hashes pSize bytes starting at a given pointer
+ *
+ * @param pName         Name of the hash function to print
+ * @param pBuffer       Buffer to take the inputs from
+ * @param pSize         Number of bytes in each input
+ * @param pHash         Hash function
+ * @param pResults      Table of results to add the row to
+ */
+template <typename hash_t>
+void
+run_one (const char *pName, const uint8_t *pBuffer, uint64_t pSize, hash_t pHash, table &pResults)
+{
+    uint64_t            count       = std::max (bytesPerRow / pSize, (uint64_t)1);
+    uint64_t            offset      = 0;
+    uint64_t            sink        = 0;
+
+    Timer               timer;
+    int64_t             measured;
+
+    timer.reset ();
+    for (uint64_t i = 0; i < count; ++i) {
+
+        // the result of every hash is used so that none of them can be skipped, while the inputs do not depend on them, so that
+        // consecutive hashes can overlap (which measures throughput rather than latency)
+        sink        ^= pHash (pBuffer + offset);
+
+        offset      += pSize;
+        if (offset + pSize > bufferSize) {
+            offset  = 0;
+        }
+    }
+    measured    = timer.elapsed_ns ();
+
+    pResults.add_row ({pName,
+                       format_integer (count),
+                       format_integer (measured / 1'000'000),
+                       format_decimal ((double)measured / (double)count),
+                       format_decimal ((double)(count * pSize) / (double)measured)});
+
+    hashSink    = sink;
+}
+
+/**
+ * @brief               Adds rows for the fixed size variants, if inputs of the given size can be hashed by them
+ *
+ * @tparam tSize        Size of the fixed size key
+ */
+template <uint64_t tSize>
+void
+run_fixed (const uint8_t *pBuffer, uint64_t pSize, table &pResults)
+{
+    if (pSize != tSize) {
+        return;
+    }
+
+    run_one ("ag_fnv1a", pBuffer, pSize,
+             [] (const uint8_t *pPtr) { return ag_fnv1a<bytes_t<tSize>, uint64_t> ((const bytes_t<tSize> *)pPtr); }, pResults);
+    run_one ("ag_wyhash", pBuffer, pSize,
+             [] (const uint8_t *pPtr) { return ag_wyhash<bytes_t<tSize>, uint64_t> ((const bytes_t<tSize> *)pPtr); }, pResults);
+}
+
+void
+run_benchmark (uint64_t pSize, const uint8_t *pBuffer)
+{
+    table                   results;
+
+    std::cout << '\n';
+    std::cout << format_integer (pSize) << " Bytes per input\n";
+    std::cout << '\n';
+
+    results.add_headers ({"Function", "Hashes", "Time (ms)", "ns / Hash", "GB/s"});
+
+    run_one ("ag_fnv1a_n", pBuffer, pSize,
+             [pSize] (const uint8_t *pPtr) { return ag_fnv1a_n<uint8_t, uint64_t> (pPtr, pSize); }, results);
+    run_one ("ag_wyhash_n", pBuffer, pSize,
+             [pSize] (const uint8_t *pPtr) { return ag_wyhash_n<uint8_t, uint64_t> (pPtr, pSize); }, results);
+
+    run_fixed<4> (pBuffer, pSize, results);
+    run_fixed<8> (pBuffer, pSize, results);
+    run_fixed<16> (pBuffer, pSize, results);
+    run_fixed<32> (pBuffer, pSize, results);
+    run_fixed<64> (pBuffer, pSize, results);
+
+    std::cout << results << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <size1 [size2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "size:\t\tNumber of bytes in each input to hash\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 8 16 32 64 1024 1048576\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+    std::vector<uint8_t>    buffer  (bufferSize);
+    uint64_t                state   {0x9E3779B97F4A7C15ULL};
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    for (auto &byte : buffer) {
+        state   ^= state << 13;
+        state   ^= state >> 7;
+        state   ^= state << 17;
+
+        byte    = (uint8_t)state;
+    }
+
+    for (auto &quantity : args) {
+        if ((uint64_t)quantity > bufferSize) {
+            std::cout << "\nIgnoring size " << format_integer (quantity) << " larger than the buffer (" << format_integer (bufferSize) << " bytes)\n";
+            continue;
+        }
+
+        run_benchmark ((uint64_t)quantity, buffer.data ());
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file                integer_hashing.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to compare the hash functions and bucket mappings for integer keys
+ *
+ * Usage: integer_hashing <input_file> <oper1 [oper2...]>
+ *
+ * input_file:     Path to file containing records (the data generated by sequence_gen shows how sequential keys are spread)
+ * oper:           Number of operations of each type to perform
+ *
+ * Example: integer_hashing ../data/sequence_all.in 1000000 10000000
+ */
+
+#include <iostream>
+#include <fstream>
+#include <limits>
+
+#include <unordered_set>
+
+#include "AgHashTable.h"
+#include "benchmark_utils.h"
+
+
+int32_t     *buffInsert;
+int32_t     *buffFind;
+int32_t     *buffErase;
+
+int32_t     maxN;
+
+void
+read_buffers (const char *pFilepath)
+{
+    std::ifstream       fin (pFilepath);
+
+    if (!fin) {
+        std::cout << "No file with name \"" << pFilepath << "\" exists" << std::endl;
+        std::exit (-1);
+    }
+    fin.tie (NULL);
+
+    fin >> maxN;
+
+    buffInsert          = new (std::nothrow) int32_t[maxN];
+    buffFind            = new (std::nothrow) int32_t[maxN];
+    buffErase           = new (std::nothrow) int32_t[maxN];
+
+    if (buffInsert == nullptr || buffFind == nullptr || buffErase == nullptr) {
+        std::cout << "Could not allocate buffers" << std::endl;
+        std::exit (1);
+    }
+
+    std::cout << "Begin Reading File\n";
+    std::cout << "Found " << format_integer (maxN) << " records each for Insert, Find and Erase\n";
+
+    for (int32_t i = 0; i < maxN; ++i) {
+        fin >> buffInsert[i];
+    }
+    for (int32_t i = 0; i < maxN; ++i) {
+        fin >> buffFind[i];
+    }
+    for (int32_t i = 0; i < maxN; ++i) {
+        fin >> buffErase[i];
+    }
+
+    std::cout << "Done Reading File\n";
+}
+
+/**
+ * @brief               The same multiplication as ag_fibonacci_hash, which AgHashTable does not recognize, so that buckets are
+ *                      selected using the low bits of the product (to show what the high bit mapping of ag_fibonacci_hash avoids)
+ *
+ */
+size_t
+fibonacci_low_bits (const int32_t *pKey)
+{
+    return (size_t)((uint64_t)*pKey * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief               Inserts, searches for and erases pN records with a fresh table, and adds a row with the time taken by each
+ *                      operation and how the keys were spread over the buckets (after all insertions)
+ *
+ * @tparam table_t      Type of the table
+ *
+ * @param pName         Name of the hash function to print
+ * @param pN            Number of operations of each type
+ * @param pResults      Table of results to add the row to
+ */
+template <typename table_t>
+void
+run_one (const char *pName, int32_t pN, table &pResults)
+{
+    table_t             container;
+
+    Timer               timer;
+    int64_t             insertMs;
+    int64_t             findMs;
+    int64_t             eraseMs;
+
+    int64_t             found       = 0;
+    uint64_t            bucketCount;
+    uint64_t            maxKeys     = 0;
+
+    timer.reset ();
+    for (int32_t i = 0; i < pN; ++i) {
+        container.insert (buffInsert[i]);
+    }
+    insertMs    = timer.elapsed_ms ();
+
+    bucketCount = container.get_bucket_count ();
+    for (uint64_t bucketId = 0; bucketId < bucketCount; ++bucketId) {
+        maxKeys     = std::max (maxKeys, container.get_bucket_key_count (bucketId));
+    }
+
+    timer.reset ();
+    for (int32_t i = 0; i < pN; ++i) {
+        found       += container.exists (buffFind[i]);
+    }
+    findMs      = timer.elapsed_ms ();
+
+    timer.reset ();
+    for (int32_t i = 0; i < pN; ++i) {
+        container.erase (buffErase[i]);
+    }
+    eraseMs     = timer.elapsed_ms ();
+
+    pResults.add_row ({pName,
+                       format_integer (insertMs),
+                       format_integer (findMs),
+                       format_integer (eraseMs),
+                       format_integer (bucketCount),
+                       format_integer (maxKeys),
+                       format_integer (found)});
+}
+
+void
+run_benchmark (int32_t pN)
+{
+    std::unordered_set<int32_t>         reference;
+
+    Timer                               timer;
+    int64_t                             insertMs;
+    int64_t                             findMs;
+    int64_t                             eraseMs;
+    int64_t                             found       = 0;
+
+    table                               results;
+
+    if (pN > maxN) {
+        std::cout << "\nGiven " << format_integer (pN) << " operations exceeds the number of records supplied by the file\n";
+        return;
+    }
+
+    std::cout << '\n';
+    std::cout << format_integer (pN) << " Operations of each type\n";
+    std::cout << '\n';
+
+    results.add_headers ({"Hash", "Insertion (ms)", "Find (ms)", "Erase (ms)", "Buckets", "Max Keys per Bucket", "Found"});
+
+    timer.reset ();
+    for (int32_t i = 0; i < pN; ++i) {
+        reference.insert (buffInsert[i]);
+    }
+    insertMs    = timer.elapsed_ms ();
+
+    timer.reset ();
+    for (int32_t i = 0; i < pN; ++i) {
+        found       += (int64_t)reference.count (buffFind[i]);
+    }
+    findMs      = timer.elapsed_ms ();
+
+    timer.reset ();
+    for (int32_t i = 0; i < pN; ++i) {
+        reference.erase (buffErase[i]);
+    }
+    eraseMs     = timer.elapsed_ms ();
+
+    results.add_row ({"std::unordered_set", format_integer (insertMs), format_integer (findMs), format_integer (eraseMs), "-", "-", format_integer (found)});
+
+    run_one<AgHashTable<int32_t, ag_fnv1a<int32_t, size_t>>> ("ag_fnv1a", pN, results);
+    run_one<AgHashTable<int32_t, ag_murmur_hash<int32_t, size_t>>> ("ag_murmur_hash", pN, results);
+    run_one<AgHashTable<int32_t, fibonacci_low_bits>> ("Fibonacci (low bits)", pN, results);
+    run_one<AgHashTable<int32_t>> ("ag_fibonacci_hash (default)", pN, results);
+
+    std::cout << results << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <input_file> <oper1 [oper2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "input_file:\tPath to file containing records\n";
+        std::cout << "oper:\t\tNumber of operations of each type to perform\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " ../data/sequence_all.in 1000000 10000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 2);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    read_buffers (argv[1]);
+
+    for (auto &quantity : args) {
+        run_benchmark ((int32_t)std::min<int64_t> (quantity, std::numeric_limits<int32_t>::max ()));
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
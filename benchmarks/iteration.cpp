@@ -0,0 +1,110 @@
+/**
+ * @file                iteration.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to benchmark iterating over every key of a table
+ *
+ * Usage: iteration <keys1 [keys2...]>
+ *
+ * keys:           Number of keys to insert into the tables before iterating over them
+ *
+ * Example: iteration 1000000 10000000
+ */
+
+#include <iostream>
+
+#include <unordered_set>
+
+#include "AgHashTable.h"
+#include "benchmark_utils.h"
+
+
+/**
+ * @brief               Inserts the keys [0, pN) into a table, then iterates over the table and adds a row with the time taken
+ *
+ * @tparam table_t      Type of the table
+ *
+ * @param pName         Name of the table to print
+ * @param pN            Number of keys
+ * @param pResults      Table of results to add the row to
+ */
+template <typename table_t>
+void
+run_one (const char *pName, int64_t pN, table &pResults)
+{
+    table_t                             container;
+
+    Timer                               timer;
+    int64_t                             measured;
+
+    int64_t                             cntr    {0};
+    int64_t                             sum     {0};
+
+    for (int64_t i = 0; i < pN; ++i) {
+        container.insert ((int32_t)i);
+    }
+
+    timer.reset ();
+    for (auto it = container.begin (); it != container.end (); ++it) {
+        sum     += *it;
+        ++cntr;
+    }
+    measured    = timer.elapsed_ms ();
+
+    // make sure every key was visited exactly once (and that the loop can not be optimized away)
+    if (sum != (pN * (pN - 1)) / 2) {
+        std::cout << "Incorrect sum of keys for " << pName << '\n';
+    }
+
+    pResults.add_row ({pName, format_integer (cntr), format_integer (measured)});
+}
+
+void
+run_benchmark (int64_t pN)
+{
+    table                               results;
+
+    std::cout << '\n';
+    std::cout << format_integer (pN) << " Keys\n";
+    std::cout << '\n';
+
+    results.add_headers ({"Class", "Keys Visited", "Time (ms)"});
+
+    run_one<std::unordered_set<int32_t>> ("std::unordered_set", pN, results);
+    run_one<AgHashTable<int32_t>> ("AgHashTable", pN, results);
+    run_one<AgHashTable<int32_t, ag_fnv1a<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgSwissLayout>> ("AgHashTable (Swiss)", pN, results);
+
+    std::cout << results << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <keys1 [keys2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "keys:\t\tNumber of keys to insert into the tables before iterating over them\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 1000000 10000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    for (auto &quantity : args) {
+        run_benchmark (quantity);
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file                multi_threaded_numbers.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to benchmark the throughput of a table shared by an increasing number of threads
+ *
+ * Usage: multi_threaded_numbers <ops1 [ops2...]>
+ *
+ * ops:            Total number of operations to perform (split evenly between the threads)
+ *
+ * Every thread performs a mix of 90% lookups, 5% insertions and 5% erasures on random keys, against a table which is
+ * filled with half the key space before the threads are started
+ *
+ * Example: multi_threaded_numbers 1000000 10000000
+ */
+
+#include <iostream>
+
+#include <thread>
+#include <shared_mutex>
+#include <unordered_set>
+
+#define AG_HASH_TABLE_MULTITHREADED_MODE
+#include "AgHashTable.h"
+#include "AgConcurrentHashSet.h"
+#include "benchmark_utils.h"
+
+
+static constexpr uint64_t   sKeySpace       = 1ULL << 20;       /** Keys are picked from [0, sKeySpace) */
+
+/**
+ * @brief               std::unordered_set guarded by a single reader/writer lock, as a baseline
+ *
+ */
+struct locked_set {
+
+    std::unordered_set<int32_t>     mSet;
+    mutable std::shared_mutex       mLock;
+
+    bool
+    insert (int32_t pKey)
+    {
+        std::unique_lock<std::shared_mutex>     lock    {mLock};
+        return mSet.insert (pKey).second;
+    }
+
+    bool
+    erase (int32_t pKey)
+    {
+        std::unique_lock<std::shared_mutex>     lock    {mLock};
+        return mSet.erase (pKey) > 0;
+    }
+
+    bool
+    exists (int32_t pKey) const
+    {
+        std::shared_lock<std::shared_mutex>     lock    {mLock};
+        return mSet.find (pKey) != mSet.end ();
+    }
+};
+
+/**
+ * @brief               Performs the mixed workload on a table from the given number of threads and returns the time taken
+ *
+ * @tparam table_t      Type of the table
+ *
+ * @param pContainer    Table to use
+ * @param pOps          Total number of operations
+ * @param pThreads      Number of threads
+ *
+ * @return int64_t      Time taken (in microseconds)
+ */
+template <typename table_t>
+int64_t
+run_threads (table_t &pContainer, int64_t pOps, uint32_t pThreads)
+{
+    std::vector<std::thread>    threads;
+    Timer                       timer;
+
+    std::atomic<int64_t>        hits    {0};
+
+    timer.reset ();
+
+    for (uint32_t threadId = 0; threadId < pThreads; ++threadId) {
+        threads.emplace_back ([&pContainer, &hits, pOps, pThreads, threadId] () {
+
+            uint64_t    state       = 0x9E3779B97F4A7C15ULL * (threadId + 1);
+            uint64_t    rnd;
+            int32_t     key;
+            int64_t     localHits   {0};
+
+            for (int64_t i = threadId; i < pOps; i += pThreads) {
+
+                rnd     = next_random (state);
+                key     = (int32_t)((rnd >> 8) & (sKeySpace - 1));
+
+                switch (rnd % 20) {
+                    case 0:
+                        localHits += pContainer.insert (key);
+                        break;
+                    case 1:
+                        localHits += pContainer.erase (key);
+                        break;
+                    default:
+                        localHits += pContainer.exists (key);
+                        break;
+                }
+            }
+
+            hits    += localHits;
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join ();
+    }
+
+    // make sure the operations can not be optimized away
+    if (hits.load () < 0) {
+        std::cout << "Negative number of hits\n";
+    }
+
+    return timer.elapsed_us ();
+}
+
+/**
+ * @brief               Fills a fresh table with every other key, runs the workload and adds a row with the throughput
+ *
+ * @tparam table_t      Type of the table
+ *
+ * @param pName         Name of the table to print
+ * @param pOps          Total number of operations
+ * @param pThreads      Number of threads
+ * @param pResults      Table of results to add the row to
+ */
+template <typename table_t>
+void
+run_one (const char *pName, int64_t pOps, uint32_t pThreads, table &pResults)
+{
+    table_t                             container;
+    int64_t                             measured;
+
+    for (uint64_t key = 0; key < sKeySpace; key += 2) {
+        container.insert ((int32_t)key);
+    }
+
+    measured    = run_threads (container, pOps, pThreads);
+    measured    = (measured > 0) ? (measured) : (1);
+
+    pResults.add_row ({pName, format_integer (pThreads), format_integer (measured / 1000), format_integer ((pOps * 1000) / measured)});
+}
+
+void
+run_benchmark (int64_t pOps)
+{
+    table                               results;
+    uint32_t                            maxThreads  = std::thread::hardware_concurrency ();
+
+    maxThreads  = (maxThreads > 0) ? (maxThreads) : (1);
+
+    std::cout << '\n';
+    std::cout << format_integer (pOps) << " Operations\n";
+    std::cout << '\n';
+
+    results.add_headers ({"Class", "Threads", "Time (ms)", "Throughput (Kops/s)"});
+
+    // double the number of threads each time, making sure the last run uses every hardware thread
+    for (uint32_t threads = 1; ; threads *= 2) {
+
+        threads     = (threads > maxThreads) ? (maxThreads) : (threads);
+
+        run_one<locked_set> ("std::unordered_set + std::shared_mutex", pOps, threads, results);
+        run_one<AgHashTable<int32_t>> ("AgHashTable", pOps, threads, results);
+        run_one<AgHashTable<int32_t, ag_fnv1a<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgSwissLayout>> ("AgHashTable (Swiss)", pOps, threads, results);
+        run_one<AgConcurrentHashSet<int32_t>> ("AgConcurrentHashSet", pOps, threads, results);
+
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+
+    std::cout << results << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <ops1 [ops2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "ops:\t\tTotal number of operations to perform (split evenly between the threads)\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 1000000 10000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency () << '\n';
+
+    for (auto &quantity : args) {
+        run_benchmark (quantity);
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file                rehash_time.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to benchmark individual resizes of tables holding many keys
+ *
+ * Usage: rehash_time <keys1 [keys2...]>
+ *
+ * keys:           Number of keys to insert into the tables before resizing them
+ *
+ * Example: rehash_time 1000000 10000000 50000000
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <unordered_set>
+
+#include "AgHashTable.h"
+#include "benchmark_utils.h"
+
+
+/**
+ * @brief               Inserts pN pseudo random keys into a table with the given growth policy, then times growing it to four times its
+ *                      buckets and shrinking it back to fit its keys (one resize each), and adds a row with the times taken
+ *
+ * @param pName         Name of the table to print
+ * @param pGrowth       Growth policy of the table
+ * @param pThreads      Number of threads the table is grown across
+ * @param pN            Number of keys
+ * @param pResults      Table of results to add the row to
+ */
+void
+run_one (const std::string &pName, const AgGrowthPolicy &pGrowth, uint64_t pThreads, int64_t pN, table &pResults)
+{
+    AgHashTable<int64_t>                container;
+
+    Timer                               timer;
+    int64_t                             growMs;
+    int64_t                             shrinkMs;
+    uint64_t                            bucketCount;
+    uint64_t                            state       {0x9E3779B97F4A7C15ULL};
+
+    container.set_growth_policy (pGrowth);
+    container.set_rehash_threads (pThreads);
+    for (int64_t i = 0; i < pN; ++i) {
+        container.insert ((int64_t)next_random (state));
+    }
+    bucketCount = container.get_bucket_count ();
+
+    timer.reset ();
+    container.rehash (bucketCount * 4);
+    growMs      = timer.elapsed_ms ();
+
+    timer.reset ();
+    container.shrink_to_fit ();
+    shrinkMs    = timer.elapsed_ms ();
+
+    pResults.add_row ({pName, format_integer (bucketCount), format_integer (growMs), format_integer (shrinkMs)});
+}
+
+/**
+ * @brief               Inserts pN pseudo random keys into std::unordered_set, then times growing it to four times its buckets and
+ *                      shrinking it back to fit its keys, and adds a row with the times taken
+ *
+ * @param pN            Number of keys
+ * @param pResults      Table of results to add the row to
+ */
+void
+run_std (int64_t pN, table &pResults)
+{
+    std::unordered_set<int64_t>         container;
+
+    Timer                               timer;
+    int64_t                             growMs;
+    int64_t                             shrinkMs;
+    uint64_t                            bucketCount;
+    uint64_t                            state       {0x9E3779B97F4A7C15ULL};
+
+    for (int64_t i = 0; i < pN; ++i) {
+        container.insert ((int64_t)next_random (state));
+    }
+    bucketCount = container.bucket_count ();
+
+    timer.reset ();
+    container.rehash (bucketCount * 4);
+    growMs      = timer.elapsed_ms ();
+
+    timer.reset ();
+    container.rehash (0);
+    shrinkMs    = timer.elapsed_ms ();
+
+    pResults.add_row ({"std::unordered_set", format_integer (bucketCount), format_integer (growMs), format_integer (shrinkMs)});
+}
+
+void
+run_benchmark (int64_t pN)
+{
+    table                               results;
+    AgGrowthPolicy                      crowded     = AgGrowthPolicy::memory_lean ();
+    uint64_t                            threads     = std::thread::hardware_concurrency ();
+
+    // buckets are allowed to hold many keys, so every destination bucket of a resize already holds a long list of aggregate nodes
+    crowded.numKeysAllowed  = 256ULL;
+
+    std::cout << '\n';
+    std::cout << format_integer (pN) << " Keys\n";
+    std::cout << '\n';
+
+    results.add_headers ({"Class", "Buckets", "Grow x4 (ms)", "Shrink to fit (ms)"});
+
+    run_std (pN, results);
+    run_one ("AgHashTable", AgGrowthPolicy::balanced (), 1, pN, results);
+    run_one ("AgHashTable (memory_lean)", AgGrowthPolicy::memory_lean (), 1, pN, results);
+    run_one ("AgHashTable (256 keys per bucket)", crowded, 1, pN, results);
+
+    // growing is split across every hardware thread (shrinking always runs on a single thread)
+    if (threads > 1) {
+        run_one ("AgHashTable (" + std::to_string (threads) + " threads)", AgGrowthPolicy::balanced (), threads, pN, results);
+    }
+
+    std::cout << results << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <keys1 [keys2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "keys:\t\tNumber of keys to insert into the tables before resizing them\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 1000000 10000000 50000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    for (auto &quantity : args) {
+        run_benchmark (quantity);
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file                resize_latency.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to benchmark the latency of single insertions (which is dominated by the insertions that trigger a resize)
+ *
+ * Usage: resize_latency <keys1 [keys2...]>
+ *
+ * keys:           Number of keys to insert, timing every insertion separately
+ *
+ * Example: resize_latency 1000000 10000000
+ */
+
+#include <iostream>
+
+#include <unordered_set>
+
+#include "AgHashTable.h"
+#include "benchmark_utils.h"
+
+
+/**
+ * @brief               Times every insertion of pN pseudo random keys into a fresh table and adds a row with the latency percentiles
+ *
+ * @tparam table_t      Type of the table
+ *
+ * @param pName         Name of the table to print
+ * @param pContainer    Table to insert into
+ * @param pN            Number of keys
+ * @param pResults      Table of results to add the row to
+ */
+template <typename table_t>
+void
+run_one (const char *pName, table_t &pContainer, int64_t pN, table &pResults)
+{
+    std::vector<int64_t>                latencies   ((size_t)pN);
+
+    Timer                               timer;
+    Timer                               total;
+    int64_t                             totalMs;
+
+    uint64_t                            state       {0x9E3779B97F4A7C15ULL};
+    int64_t                             successCnt  {0};
+
+    total.reset ();
+    for (int64_t i = 0; i < pN; ++i) {
+
+        int64_t     key     = (int64_t)next_random (state);
+        bool        inserted;
+
+        timer.reset ();
+        if constexpr (std::is_same<table_t, std::unordered_set<int64_t>>::value) {
+            inserted    = pContainer.insert (key).second;
+        }
+        else {
+            inserted    = pContainer.insert (key);
+        }
+        latencies[i]    = timer.elapsed_ns ();
+
+        successCnt      += inserted;
+    }
+    totalMs     = total.elapsed_ms ();
+
+    std::sort (latencies.begin (), latencies.end ());
+
+    pResults.add_row ({pName,
+                       format_integer (successCnt),
+                       format_integer (totalMs),
+                       format_integer (latencies[(size_t)(pN / 2)]),
+                       format_integer (latencies[(size_t)((pN * 99) / 100)]),
+                       format_integer (latencies[(size_t)((pN * 999) / 1000)]),
+                       format_integer (latencies.back () / 1000)});
+}
+
+void
+run_benchmark (int64_t pN)
+{
+    table                               results;
+
+    std::cout << '\n';
+    std::cout << format_integer (pN) << " Insertions\n";
+    std::cout << '\n';
+
+    results.add_headers ({"Class", "Successful", "Total (ms)", "p50 (ns)", "p99 (ns)", "p99.9 (ns)", "Max (us)"});
+
+    {
+        std::unordered_set<int64_t>     container;
+        run_one ("std::unordered_set", container, pN, results);
+    }
+    {
+        AgHashTable<int64_t>            container;
+        run_one ("AgHashTable", container, pN, results);
+    }
+    {
+        AgHashTable<int64_t>            container;
+        container.set_incremental_resize (true);
+        run_one ("AgHashTable (incremental)", container, pN, results);
+    }
+
+    std::cout << results << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <keys1 [keys2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "keys:\t\tNumber of keys to insert, timing every insertion separately\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 1000000 10000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    for (auto &quantity : args) {
+        run_benchmark (quantity);
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
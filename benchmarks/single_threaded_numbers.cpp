@@ -305,6 +305,21 @@ run_benchmark (int pN)
     AgHashTable<int32_t>                table2;
     decltype (table2)::iterator         it2;
 
+    AgHashTable<int32_t, ag_fibonacci_hash<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgSwissLayout>  table3;
+    decltype (table3)::iterator         it3;
+
+    AgHashTable<int32_t, ag_fibonacci_hash<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgChainedLayout, AgSlabAllocator<>>  table4;
+    decltype (table4)::iterator         it4;
+
+    AgHashTable<int32_t>                table5;
+    std::vector<decltype (table5)::iterator>    its5;
+
+    AgHashTable<int32_t, ag_fibonacci_hash<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgCuckooLayout<4>>  table6;
+    decltype (table6)::iterator         it6;
+
+    AgHashTable<int32_t, ag_fibonacci_hash<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgCuckooLayout<8>>  table7;
+    decltype (table7)::iterator         it7;
+
     Timer                               timer;
     int64_t                             measured;
 
@@ -390,6 +405,48 @@ run_benchmark (int pN)
     measured    = timer.elapsed_ms ();
     results.add_row ({"Insertion", "AgHashTable", format_integer (cntr), format_integer (measured)});
 
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table3.insert (buffInsert[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Insertion", "AgHashTable (Swiss)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table6.insert (buffInsert[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Insertion", "AgHashTable (Cuckoo x4)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table7.insert (buffInsert[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Insertion", "AgHashTable (Cuckoo x8)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table4.insert (buffInsert[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Insertion", "AgHashTable (Slab)", format_integer (cntr), format_integer (measured)});
+
+    // the same keys as the scalar AgHashTable, inserted through the batched interface
+    timer.reset ();
+    cntr                            = (int32_t)table5.insert_batch (buffInsert, (uint64_t)pN);
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Insertion", "AgHashTable (Batched)", format_integer (cntr), format_integer (measured)});
+
 
     cntr = 0;
     timer.reset ();
@@ -425,6 +482,49 @@ run_benchmark (int pN)
     measured    = timer.elapsed_ms ();
     results.add_row ({"Find", "AgHashTable", format_integer (cntr), format_integer (measured)});
 
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        it3                         = table3.find (buffFind[i]);
+        cntr                        += (int32_t)(it3 != table3.end ());
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Find", "AgHashTable (Swiss)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        it6                         = table6.find (buffFind[i]);
+        cntr                        += (int32_t)(it6 != table6.end ());
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Find", "AgHashTable (Cuckoo x4)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        it7                         = table7.find (buffFind[i]);
+        cntr                        += (int32_t)(it7 != table7.end ());
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Find", "AgHashTable (Cuckoo x8)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        it4                         = table4.find (buffFind[i]);
+        cntr                        += (int32_t)(it4 != table4.end ());
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Find", "AgHashTable (Slab)", format_integer (cntr), format_integer (measured)});
+
+    its5.resize ((size_t)pN);
+
+    timer.reset ();
+    cntr                            = (int32_t)table5.find_batch (buffFind, (uint64_t)pN, its5.data ());
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Find", "AgHashTable (Batched)", format_integer (cntr), format_integer (measured)});
+
 #if defined (AG_DBG_MODE)
     memUsed     = table2.get_alloc_amount ();
 #endif
@@ -471,6 +571,42 @@ run_benchmark (int pN)
     measured    = timer.elapsed_ms ();
     results.add_row ({"Erase", "AgHashTable", format_integer (cntr), format_integer (measured)});;
 
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table3.erase (buffErase[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Erase", "AgHashTable (Swiss)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table6.erase (buffErase[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Erase", "AgHashTable (Cuckoo x4)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table7.erase (buffErase[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Erase", "AgHashTable (Cuckoo x8)", format_integer (cntr), format_integer (measured)});
+
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table4.erase (buffErase[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Erase", "AgHashTable (Slab)", format_integer (cntr), format_integer (measured)});
+
 
     std::cout << results << '\n' << bucketInfo << '\n';
 
@@ -482,6 +618,9 @@ run_benchmark (int pN)
     agMetrics.add_row ({"Memory Allocated", format_integer (memUsed), "bytes"});
     agMetrics.add_row ({"Buckets", format_integer (table2.get_bucket_count ()), "-"});
     agMetrics.add_row ({"Resizes", format_integer (table2.get_resize_count ()), "-"});
+    agMetrics.add_row ({"Slab Chunk Allocations", format_integer (table4.get_pool_alloc_count ()), "-"});
+    agMetrics.add_row ({"Slab Memory Reserved", format_integer (table4.get_pool_reserved_amount ()), "bytes"});
+    agMetrics.add_row ({"Slab Nodes Free For Reuse", format_integer (table4.get_pool_free_count ()), "-"});
 
     std::cout << agMetrics << '\n';
 
@@ -528,6 +667,8 @@ main (int argc, char *argv[])
 
     read_buffers (argv[1]);
 
+    std::cout << "Swiss layout probes " << AgSwissGroup::sWidth << " slots at a time\n";
+
     for (auto &quantity : args) {
         run_benchmark (quantity);
     }
@@ -31,6 +31,7 @@
 // AgHashTable
 #define AG_DBG_MODE
 #include "AgHashTable.h"
+#include "AgStringTable.h"
 
 constexpr uint64_t      maxStrLength   = 64ULL;        /** Maximum allowed length of a string */
 
@@ -296,6 +297,9 @@ run_benchmark (int pN)
     AgHashTable<const char *, fnv1a_string>  table2;
     decltype (table2)::iterator         it2;
 
+    AgStringTable<>                     table3;
+    decltype (table3)::iterator         it3;
+
     Timer                               timer;
     int64_t                             measured;
 
@@ -357,6 +361,15 @@ run_benchmark (int pN)
     measured    = timer.elapsed_ms ();
     results.add_row ({"Insertion", "AgHashTable", format_integer (cntr), format_integer (measured)});
 
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table3.insert (buff[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Insertion", "AgStringTable", format_integer (cntr), format_integer (measured)});
+
 
     cntr = 0;
     timer.reset ();
@@ -392,6 +405,15 @@ run_benchmark (int pN)
     measured    = timer.elapsed_ms ();
     results.add_row ({"Find", "AgHashTable", format_integer (cntr), format_integer (measured)});
 
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        it3                         = table3.find (buff[i]);
+        cntr                        += (int32_t)(it3 != table3.end ());
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Find", "AgStringTable", format_integer (cntr), format_integer (measured)});
+
 #if defined (AG_DBG_MODE)
     memUsed     = table2.get_alloc_amount ();
 #endif
@@ -438,6 +460,15 @@ run_benchmark (int pN)
     measured    = timer.elapsed_ms ();
     results.add_row ({"Erase", "AgHashTable", format_integer (cntr), format_integer (measured)});;
 
+    cntr = 0;
+    timer.reset ();
+    for (auto i = 0; i < pN; ++i) {
+        flag                        = table3.erase (buff[i]);
+        cntr                        += flag;
+    }
+    measured    = timer.elapsed_ms ();
+    results.add_row ({"Erase", "AgStringTable", format_integer (cntr), format_integer (measured)});
+
 
     std::cout << results << '\n' << bucketInfo << '\n';
 
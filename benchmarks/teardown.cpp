@@ -0,0 +1,131 @@
+/**
+ * @file                teardown.cpp
+ * @author              Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ * @brief               Program to benchmark clearing and destroying tables holding many keys
+ *
+ * Usage: teardown <keys1 [keys2...]>
+ *
+ * keys:           Number of keys to insert into the tables before clearing and destroying them
+ *
+ * Example: teardown 1000000 10000000
+ */
+
+#include <iostream>
+#include <memory>
+
+#include <unordered_set>
+
+#include "AgHashTable.h"
+#include "benchmark_utils.h"
+
+
+/**
+ * @brief               Inserts pN pseudo random keys into a table
+ *
+ * @tparam table_t      Type of the table
+ *
+ * @param pContainer    Table to insert the keys into
+ * @param pN            Number of keys
+ */
+template <typename table_t>
+void
+fill (table_t &pContainer, int64_t pN)
+{
+    uint64_t                            state   {0x9E3779B97F4A7C15ULL};
+
+    for (int64_t i = 0; i < pN; ++i) {
+        pContainer.insert ((int64_t)next_random (state));
+    }
+}
+
+/**
+ * @brief               Inserts pN pseudo random keys into a table and clears it, then inserts them again and destroys the table, and
+ *                      adds a row with the time taken by clearing and destroying it
+ *
+ * @tparam table_t      Type of the table
+ *
+ * @param pName         Name of the table to print
+ * @param pN            Number of keys
+ * @param pResults      Table of results to add the row to
+ */
+template <typename table_t>
+void
+run_one (const char *pName, int64_t pN, table &pResults)
+{
+    std::unique_ptr<table_t>            container   {new table_t};
+
+    Timer                               timer;
+    int64_t                             clearMs;
+    int64_t                             destroyMs;
+    uint64_t                            keyCount;
+
+    fill (*container, pN);
+    keyCount    = container->size ();
+
+    timer.reset ();
+    container->clear ();
+    clearMs     = timer.elapsed_ms ();
+
+    if (container->size () != 0) {
+        std::cout << "Keys left after clearing " << pName << '\n';
+    }
+
+    fill (*container, pN);
+
+    timer.reset ();
+    container.reset ();
+    destroyMs   = timer.elapsed_ms ();
+
+    pResults.add_row ({pName, format_integer (keyCount), format_integer (clearMs), format_integer (destroyMs)});
+}
+
+void
+run_benchmark (int64_t pN)
+{
+    table                               results;
+
+    std::cout << '\n';
+    std::cout << format_integer (pN) << " Keys\n";
+    std::cout << '\n';
+
+    results.add_headers ({"Class", "Keys", "Clear (ms)", "Destruction (ms)"});
+
+    run_one<std::unordered_set<int64_t>> ("std::unordered_set", pN, results);
+    run_one<AgHashTable<int64_t>> ("AgHashTable", pN, results);
+    run_one<AgHashTable<int64_t, ag_default_hash<int64_t, size_t> (), ag_hashtable_default_equals<int64_t>, AgChainedLayout, AgSlabAllocator<>>> ("AgHashTable (Slab)", pN, results);
+
+    std::cout << results << '\n';
+}
+
+int
+main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cout << "Usage: ";
+        std::cout << argv[0] << " <keys1 [keys2...]>\n";
+
+        std::cout << '\n';
+        std::cout << "keys:\t\tNumber of keys to insert into the tables before clearing and destroying them\n";
+
+        std::cout << '\n';
+        std::cout << "Example: ";
+        std::cout << argv[0] << " 1000000 10000000\n";
+
+        return 1;
+    }
+
+    std::vector<int64_t>    args    = parse_quantities (argc, argv, 1);
+
+    if (args.size () <= 0) {
+        std::cout << "No valid quantities provided\n";
+        std::cout << "Exiting\n";
+        return 1;
+    }
+
+    for (auto &quantity : args) {
+        run_benchmark (quantity);
+    }
+
+    std::cout << "Exiting\n";
+    return 0;
+}
@@ -24,12 +24,10 @@ main (void)
     AgHashTable<int>            table;
     AgHashTable<int>::iterator  it;
 
-    // insert elements into table
+    // insert elements into table (all at once, which hashes several elements at a time for large arrays)
     // each element will only be successfuly inserted once, thus removing repeats
     // the original array remains unmodified
-    for (auto &e : ar) {
-        table.insert (e);
-    }
+    table.insert_range (ar, ar + sz);
 
     // print the array to the console
     std::cout << '\n';
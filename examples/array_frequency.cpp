@@ -1,21 +1,21 @@
 /**
- * @file                    array_distinct.cpp
+ * @file                    array_frequency.cpp
  * @author                  Aditya Agarwal (aditya,agarwal@dumblebots.com)
  *
- * In this example, given an array, we need to find the number of distinct elements inside it without
- * modifying it
- * All the elements from the array be iterated over and inserted into a hash table one by one
- * Since only one copy of each element will be succesfully inserted into the table, the number of elements
- * in the tree after iterating over the array, is the answer
+ * In this example, given an array, we need to find the number of times each distinct element occurs inside it
+ * without modifying it
+ * All the elements from the array are iterated over, and the count mapped to each element is incremented in place
+ * using update (), which inserts a zero count the first time an element is seen
+ * This hashes each element and searches its bucket only once, instead of a find followed by an insert
 */
 
 #include <iostream>
 #include <chrono>
 
-#include <unordered_set>
+#include <unordered_map>
 
 #define AG_DBG_MODE
-#include "AgHashTable.h"
+#include "AgHashMap.h"
 
 namespace chrono = std::chrono;
 
@@ -28,21 +28,22 @@ id (const uint64_t *pPtr)
 int
 main (void)
 {
-    AgHashTable<uint64_t, id>   table;
-    // std::unordered_set<uint64_t>    table;
-    // uint64_t                    cntr    {0ULL};
+    AgHashMap<uint64_t, uint64_t, id>   table;
+    // std::unordered_map<uint64_t, uint64_t>   table;
 
     auto start              = chrono::high_resolution_clock::now();
 
     for (uint64_t i = 0; i < 10'000'000; ++i) {
-        table.insert (i);
-        // cntr += (uint64_t) table.insert (i);
-        // cntr += (uint64_t) (table.insert (i).second);
+        table.update ((i * i) % 1'000'003, [] (uint64_t &pCount) { ++pCount; });
+        // ++table[(i * i) % 1'000'003];
     }
 
     auto end              = chrono::high_resolution_clock::now();
 
-    std::cout << "Time elapsed: " << (chrono::duration_cast<chrono::milliseconds>(end - start).count ()) << "us \n";
+    std::cout << "Time elapsed: " << (chrono::duration_cast<chrono::milliseconds>(end - start).count ()) << "ms \n";
+    std::cout << "Distinct elements: " << table.get_key_count () << '\n';
+    std::cout << "Frequency of 0: " << table[0] << '\n';
+    std::cout << "Frequency of 1: " << table[1] << '\n';
 #if defined (AG_DBG_MODE)
     std::cout << "Allocations: " << table.get_alloc_count () << '\n';
     std::cout << "Deletions: " << table.get_delete_count () << '\n';
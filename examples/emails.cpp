@@ -2,19 +2,25 @@
  * @file            emails.cpp
  * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
  * @brief           Insert and emails (C-style strings) from a randomly generated array.
+ *
+ * The emails are then searched for again as slices of a single buffer (as if they had been parsed out of a network
+ * buffer), which are looked up as std::string_view without copying them into NUL-terminated strings
  */
 
 #include <cstdio>
 #include <iostream>
 
 #include <cstring>
+#include <string>
+#include <string_view>
 
 #include "AgHashTable.h"
 
 int
 main (void)
 {
-    AgHashTable<const char *>  table;
+    // hash the characters of the emails (not the pointers), so that the same email can be found from any string type
+    AgHashTable<const char *, ag_fnv1a_str<const char *, size_t>>  table;
 
     if (!table.initialized ()) {
         std::cout << "Failed to init table\n";
@@ -295,6 +301,28 @@ main (void)
         }
     }
 
+    // join every email into a single buffer separated by spaces, and search for each of them as a slice of the buffer
+    std::string                 buffer;
+
+    for (auto &e : ar) {
+        buffer  += e;
+        buffer  += ' ';
+    }
+
+    std::string_view            remaining   {buffer};
+
+    while (!remaining.empty ()) {
+
+        std::string_view        email       = remaining.substr (0, remaining.find (' '));
+
+        if (table.exists (email) == false) {
+            std::cout << "Could not find slice " << email << std::endl;
+            return 1;
+        }
+
+        remaining.remove_prefix (email.size () + 1);
+    }
+
     std::cout << "Number of keys in the table: " << table.size () << std::endl;
 
     // for (auto &email : table) {
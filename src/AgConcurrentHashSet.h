@@ -0,0 +1,708 @@
+/**
+ * @file            AgConcurrentHashSet.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           AgConcurrentHashSet class
+ *
+ */
+
+#ifndef AG_CONCURRENT_HASH_SET_GUARD_H
+
+#define     AG_CONCURRENT_HASH_SET_GUARD_H
+
+#include <new>
+#include <atomic>
+
+#include <type_traits>
+#include <cstdint>
+
+#include "AgHashTable.h"
+#include "AgEpochDomain.h"
+
+/**
+ * @brief                   AgConcurrentHashSet is a lock-free hash set, which can be used by any number of threads at the same time
+ *
+ *                          Keys are stored in a single lock-free linked list sorted by the bit-reversed hash of each key (a split-ordered
+ *                          list), so that the keys of a bucket stay contiguous no matter how many buckets there are
+ *                          Each bucket points to a dummy node in the list, and growing the table only doubles the number of buckets, the
+ *                          new ones being spliced into the list the first time they are used (keys are never moved)
+ *                          Nodes are unlinked from the list with compare-and-swap, and are only freed once no thread can be reading them
+ *                          (see AgEpochDomain)
+ *
+ * @tparam key_t            Type of key to store
+ * @tparam tHashFunc        Function to hash a key (defaults to Fibonacci hashing for integers and FNV-1a otherwise, see ag_default_hash ())
+ * @tparam tEquals          Function to compare two keys for equality
+ */
+template <typename key_t, auto tHashFunc = ag_default_hash<key_t, size_t> (), auto tEquals = ag_hashtable_default_equals<key_t>>
+class AgConcurrentHashSet {
+
+
+
+    protected:
+
+
+
+    using       hash_t          = typename std::invoke_result<decltype (tHashFunc), const key_t *>::type;     /** Data type returned by the hash function (must be unsigned integral type */
+
+    static_assert (std::is_unsigned<hash_t>::value, "Return type of hash functions must be unsigned integer");
+
+    struct      link_t;
+    struct      node_t;
+
+    using       link_ptr_t      = link_t *;                                             /** Helper alias for pointers to links */
+    using       node_ptr_t      = node_t *;                                             /** Helper alias for pointers to nodes */
+    using       slot_t          = std::atomic<link_ptr_t>;                              /** Helper alias for bucket slots (each holds a pointer to the bucket's dummy node) */
+    using       segment_ptr_t   = slot_t *;                                             /** Helper alias for pointers to segments of bucket slots */
+
+    static constexpr uint64_t   sHashBitness            = std::numeric_limits<hash_t>::digits;  /** Number of bits in the hash */
+
+    static constexpr uint64_t   sMaxBucketBits          = (sHashBitness > 32) ? (32) : (sHashBitness);
+    static constexpr uint64_t   sMaxBucketsAllowed      = 1ULL << sMaxBucketBits;       /** Maximum number of buckets allowed in the set */
+    static constexpr uint64_t   sSegmentCount           = sMaxBucketBits + 1ULL;        /** Number of segments (segment 0 holds bucket 0, while segment i holds buckets [2^(i-1), 2^i)) */
+
+    static constexpr uint64_t   sMaxLoadFactor          = 2ULL;                         /** Average number of keys per bucket after which the number of buckets is doubled */
+    static constexpr uintptr_t  sMarkBit                = 1ULL;                         /** Bit set in a link's next pointer once the link has been logically erased */
+
+    /**
+     * @brief                   Element of the split-ordered list (dummy nodes, which mark the start of buckets, are bare links)
+     *
+     *                          Dummy nodes have even order keys, while nodes holding keys have odd order keys
+     */
+    struct link_t {
+
+        std::atomic<uintptr_t>  nextPtr     {0};                        /** Pointer to the next link, with sMarkBit set if this link has been erased */
+        uint64_t                orderKey;                               /** Bit-reversed hash which determines the position of the link in the list */
+
+        link_t                                  (const uint64_t &pOrderKey);
+    };
+
+    /**
+     * @brief                   Link holding a key
+     *
+     */
+    struct node_t : link_t {
+
+        key_t                   key;                                    /** Key stored in the node */
+
+        node_t                                  (const uint64_t &pOrderKey, const key_t &pKey);
+    };
+
+
+
+    public:
+
+
+
+    AgConcurrentHashSet                         ();
+    AgConcurrentHashSet                         (const uint64_t &pBucketCount);
+
+    ~AgConcurrentHashSet                        ();
+
+    AgConcurrentHashSet                         (const AgConcurrentHashSet &pOther) = delete;
+    AgConcurrentHashSet &operator=              (const AgConcurrentHashSet &pOther) = delete;
+
+    // Getters
+
+    uint64_t            get_key_count           () const;
+    uint64_t            get_bucket_count        () const;
+
+    // Lookup
+
+    bool                exists                  (const key_t &pKey) const;
+
+    // Modifiers
+
+    bool                insert                  (const key_t &pKey);
+    bool                erase                   (const key_t &pKey);
+
+
+
+    protected:
+
+
+
+    // Helpers
+
+    static uint64_t     reverse_bits            (uint64_t pVal);
+    static uint64_t     get_regular_key         (const hash_t &pKeyHash);
+    static uint64_t     get_dummy_key           (const uint64_t &pBucketId);
+    static uint64_t     get_parent              (const uint64_t &pBucketId);
+
+    static link_ptr_t   get_ptr                 (const uintptr_t &pRaw);
+
+    static void         delete_node             (void *pPtr);
+
+    slot_t              *get_slot               (const uint64_t &pBucketId) const;
+    link_ptr_t          get_bucket              (const uint64_t &pBucketId) const;
+    link_ptr_t          init_bucket             (const uint64_t &pBucketId) const;
+
+    bool                find_util               (link_ptr_t pHead, const uint64_t &pOrderKey, const key_t *pKey, link_ptr_t &pPrev, link_ptr_t &pCurr) const;
+
+    // Modifiers
+
+    void                init                    (const uint64_t &pBucketCount);
+
+
+    mutable std::atomic<segment_ptr_t>  mSegments[sSegmentCount];           /** Segments of bucket slots (allocated the first time one of their buckets is used) */
+
+    std::atomic<uint64_t>   mKeyCount       {0ULL};                         /** Number of keys in the set */
+    std::atomic<uint64_t>   mBucketCount    {0ULL};                         /** Number of buckets in the set */
+};
+
+/**
+ * @brief                   Construct a new link_t object
+ *
+ * @param pOrderKey         Bit-reversed hash which determines the position of the link in the list
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::link_t::link_t (const uint64_t &pOrderKey) : orderKey {pOrderKey}
+{
+}
+
+/**
+ * @brief                   Construct a new node_t object
+ *
+ * @param pOrderKey         Bit-reversed hash which determines the position of the node in the list
+ * @param pKey              Key to store
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::node_t::node_t (const uint64_t &pOrderKey, const key_t &pKey) : link_t {pOrderKey}, key {pKey}
+{
+}
+
+/**
+ * @brief                   Construct a new AgConcurrentHashSet object
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::AgConcurrentHashSet ()
+{
+    init (64ULL);
+}
+
+/**
+ * @brief                   Construct a new AgConcurrentHashSet object
+ *
+ * @param pBucketCount      Number of buckets to initialize the set with (must be a power of 2)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::AgConcurrentHashSet (const uint64_t &pBucketCount)
+{
+    init (pBucketCount);
+}
+
+/**
+ * @brief                   Initializes the segments and creates the dummy node of the first bucket (the head of the list)
+ *
+ * @param pBucketCount      Number of buckets to initialize the set with (must be a power of 2)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+void
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::init (const uint64_t &pBucketCount)
+{
+    for (auto &segment : mSegments) {
+        segment.store (nullptr, std::memory_order_relaxed);
+    }
+
+    mBucketCount.store ((pBucketCount == 0) ? (1ULL) : ((pBucketCount > sMaxBucketsAllowed) ? (sMaxBucketsAllowed) : (pBucketCount)), std::memory_order_relaxed);
+
+    // the dummy node of the first bucket is never removed, so every other link can be reached from it
+    get_slot (0)->store (new link_t {get_dummy_key (0)}, std::memory_order_release);
+}
+
+/**
+ * @brief                   Destroy the AgConcurrentHashSet object
+ *
+ *                          Must not be called while any other thread is using the set (erased nodes which are still waiting
+ *                          to be reclaimed are freed by AgEpochDomain and are not reachable from the list any more)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::~AgConcurrentHashSet ()
+{
+    link_ptr_t          link;                                       /** Link being deleted */
+    link_ptr_t          nextLink;                                   /** Link after the one being deleted */
+
+    link            = mSegments[0].load (std::memory_order_acquire)[0].load (std::memory_order_acquire);
+
+    while (link != nullptr) {
+
+        nextLink    = get_ptr (link->nextPtr.load (std::memory_order_relaxed));
+
+        if (link->orderKey & 1ULL) {
+            delete static_cast<node_ptr_t> (link);
+        }
+        else {
+            delete link;
+        }
+
+        link        = nextLink;
+    }
+
+    for (auto &segment : mSegments) {
+        delete[] segment.load (std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief                   Returns the number of keys in the set (may be outdated as soon as it returns if other threads are modifying the set)
+ *
+ * @return uint64_t         Number of keys in the set
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::get_key_count () const
+{
+    return mKeyCount.load (std::memory_order_relaxed);
+}
+
+/**
+ * @brief                   Returns the number of buckets in the set (including those which have not been used yet)
+ *
+ * @return uint64_t         Number of buckets in the set
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::get_bucket_count () const
+{
+    return mBucketCount.load (std::memory_order_relaxed);
+}
+
+/**
+ * @brief                   Checks if a given key exists in the set
+ *
+ * @param pKey              Key to check for
+ *
+ * @return true             If the supplied key exists in the set
+ * @return false            If the supplied key does not exist in the set
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::exists (const key_t &pKey) const
+{
+    AgEpochDomain::guard    guard;                                  /** Keeps the links which are read from being freed */
+
+    hash_t              keyHash;                                    /** Hash value of the key */
+    link_ptr_t          prev;                                       /** Link before the key's position */
+    link_ptr_t          curr;                                       /** Link at the key's position */
+
+    keyHash         = ag_bucket_hash<key_t, tHashFunc> (&pKey);
+
+    return find_util (get_bucket (keyHash & (mBucketCount.load (std::memory_order_acquire) - 1)), get_regular_key (keyHash), &pKey, prev, curr);
+}
+
+/**
+ * @brief                   Attempts to insert a new key into the set
+ *
+ * @param pKey              Key to insert
+ *
+ * @return true             If the key could successfully be inserted
+ * @return false            If the key could not be inserted (duplicate key found or allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::insert (const key_t &pKey)
+{
+    AgEpochDomain::guard    guard;                                  /** Keeps the links which are read from being freed */
+
+    hash_t              keyHash;                                    /** Hash value of the key */
+    uint64_t            orderKey;                                   /** Position of the key in the list */
+    uint64_t            bucketCount;                                /** Number of buckets when the key was inserted */
+    uint64_t            keyCount;                                   /** Number of keys after the key was inserted */
+    link_ptr_t          head;                                       /** Dummy node of the key's bucket */
+    link_ptr_t          prev;                                       /** Link after which the key is to be inserted */
+    link_ptr_t          curr;                                       /** Link before which the key is to be inserted */
+    node_ptr_t          newNode;                                    /** Node holding the key */
+    uintptr_t           expected;                                   /** Expected value of the next pointer of prev */
+
+    keyHash         = ag_bucket_hash<key_t, tHashFunc> (&pKey);
+    orderKey        = get_regular_key (keyHash);
+    bucketCount     = mBucketCount.load (std::memory_order_acquire);
+    head            = get_bucket (keyHash & (bucketCount - 1));
+
+    newNode         = nullptr;
+
+    while (true) {
+
+        // if a duplicate key already exists, return failed insertion
+        if (find_util (head, orderKey, &pKey, prev, curr)) {
+            delete newNode;
+            return false;
+        }
+
+        // the node is only created once it is known to be needed, and reused if the insertion has to be retried
+        if (newNode == nullptr) {
+            newNode     = new (std::nothrow) node_t {orderKey, pKey};
+
+            if (newNode == nullptr) {
+                return false;
+            }
+        }
+
+        newNode->nextPtr.store (reinterpret_cast<uintptr_t> (curr), std::memory_order_relaxed);
+
+        // this fails if prev was erased, or if another link was inserted after prev in the meantime
+        expected    = reinterpret_cast<uintptr_t> (curr);
+        if (prev->nextPtr.compare_exchange_strong (expected, reinterpret_cast<uintptr_t> (newNode), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    keyCount        = mKeyCount.fetch_add (1ULL, std::memory_order_relaxed) + 1ULL;
+
+    // if the set has become too crowded, double the number of buckets (the new buckets are initialized when they are first used)
+    if ((keyCount > bucketCount * sMaxLoadFactor) && ((bucketCount * 2ULL) <= sMaxBucketsAllowed)) {
+        mBucketCount.compare_exchange_strong (bucketCount, bucketCount * 2ULL, std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+
+    return true;
+}
+
+/**
+ * @brief                   Attempts to erase a given key from the set
+ *
+ * @param pKey              Key to erase
+ *
+ * @return true             If the key was successfully found and removed
+ * @return false            If the key could not be removed (no matching key was found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::erase (const key_t &pKey)
+{
+    AgEpochDomain::guard    guard;                                  /** Keeps the links which are read from being freed */
+
+    hash_t              keyHash;                                    /** Hash value of the key */
+    uint64_t            orderKey;                                   /** Position of the key in the list */
+    link_ptr_t          head;                                       /** Dummy node of the key's bucket */
+    link_ptr_t          prev;                                       /** Link before the node holding the key */
+    link_ptr_t          curr;                                       /** Node holding the key */
+    uintptr_t           nextRaw;                                    /** Next pointer of the node holding the key */
+    uintptr_t           expected;                                   /** Expected value of the next pointer of prev */
+
+    keyHash         = ag_bucket_hash<key_t, tHashFunc> (&pKey);
+    orderKey        = get_regular_key (keyHash);
+    head            = get_bucket (keyHash & (mBucketCount.load (std::memory_order_acquire) - 1));
+
+    while (true) {
+
+        if (!find_util (head, orderKey, &pKey, prev, curr)) {
+            return false;
+        }
+
+        nextRaw     = curr->nextPtr.load (std::memory_order_acquire);
+
+        // the node is already being erased by another thread, so search again (which will help unlink it)
+        if (nextRaw & sMarkBit) {
+            continue;
+        }
+
+        // logically erase the node by marking its next pointer (this is the point at which the key stops existing), which
+        // also makes sure that no link can be inserted after it
+        if (curr->nextPtr.compare_exchange_strong (nextRaw, nextRaw | sMarkBit, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    mKeyCount.fetch_sub (1ULL, std::memory_order_relaxed);
+
+    // physically unlink the node, if this fails, search again so that the node is unlinked by find_util instead
+    expected        = reinterpret_cast<uintptr_t> (curr);
+    if (prev->nextPtr.compare_exchange_strong (expected, nextRaw, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        AgEpochDomain::instance ().retire (curr, delete_node);
+    }
+    else {
+        find_util (head, orderKey, &pKey, prev, curr);
+    }
+
+    return true;
+}
+
+/**
+ * @brief                   Searches the list (starting from the given bucket) for the position of a key, unlinking any erased link on the way
+ *
+ *                          Stops at the node holding a matching key, or at the first link which would come after the key
+ *
+ * @param pHead             Dummy node of the bucket the key belongs to
+ * @param pOrderKey         Position of the key in the list
+ * @param pKey              Pointer to the key (nullptr if searching for the dummy node with the given order key)
+ * @param pPrev             Set to the last link before the key's position
+ * @param pCurr             Set to the link at the key's position (nullptr if the end of the list was reached)
+ *
+ * @return true             If a link matching the key was found (pCurr points to it)
+ * @return false            If no link matching the key was found (the key should be inserted between pPrev and pCurr)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::find_util (link_ptr_t pHead, const uint64_t &pOrderKey, const key_t *pKey, link_ptr_t &pPrev, link_ptr_t &pCurr) const
+{
+    uintptr_t           nextRaw;                                    /** Next pointer of the current link */
+    uintptr_t           expected;                                   /** Expected value of the next pointer of the previous link */
+
+    retry:
+
+    pPrev           = pHead;
+    pCurr           = get_ptr (pPrev->nextPtr.load (std::memory_order_acquire));
+
+    while (pCurr != nullptr) {
+
+        nextRaw     = pCurr->nextPtr.load (std::memory_order_acquire);
+
+        // the current link has been erased, so unlink it before moving on (start over if the previous link changed in the meantime)
+        if (nextRaw & sMarkBit) {
+
+            expected    = reinterpret_cast<uintptr_t> (pCurr);
+            if (!pPrev->nextPtr.compare_exchange_strong (expected, nextRaw & ~sMarkBit, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                goto retry;
+            }
+
+            AgEpochDomain::instance ().retire (pCurr, delete_node);
+
+            pCurr       = get_ptr (nextRaw);
+            continue;
+        }
+
+        if (pCurr->orderKey > pOrderKey) {
+            return false;
+        }
+
+        // only dummy nodes have even order keys, and there can only be one dummy node with a given order key, while keys with
+        // the same hash share the same order key, so the keys have to be compared as well
+        if (pCurr->orderKey == pOrderKey) {
+            if (pKey == nullptr || tEquals (static_cast<node_ptr_t> (pCurr)->key, *pKey)) {
+                return true;
+            }
+        }
+
+        pPrev       = pCurr;
+        pCurr       = get_ptr (nextRaw);
+    }
+
+    return false;
+}
+
+/**
+ * @brief                   Returns the dummy node of the given bucket, initializing the bucket if it has not been used yet
+ *
+ *                          If the bucket can not be initialized (allocation failure), the dummy node of its parent is returned
+ *                          instead, which still comes before every key of the bucket in the list
+ *
+ * @param pBucketId         Position of the bucket
+ *
+ * @return link_ptr_t       Pointer to the dummy node
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgConcurrentHashSet<key_t, tHashFunc, tEquals>::link_ptr_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::get_bucket (const uint64_t &pBucketId) const
+{
+    slot_t              *slot;                                      /** Slot of the bucket */
+    link_ptr_t          head;                                       /** Dummy node of the bucket */
+
+    slot            = get_slot (pBucketId);
+
+    if (slot == nullptr) {
+        return get_bucket (get_parent (pBucketId));
+    }
+
+    head            = slot->load (std::memory_order_acquire);
+
+    if (head != nullptr) {
+        return head;
+    }
+
+    return init_bucket (pBucketId);
+}
+
+/**
+ * @brief                   Splices the dummy node of the given bucket into the list (after the dummy node of its parent bucket)
+ *
+ *                          The parent of a bucket is the bucket it was split from (the same position with the highest set bit cleared)
+ *
+ * @param pBucketId         Position of the bucket (must not be 0)
+ *
+ * @return link_ptr_t       Pointer to the dummy node of the bucket (or of its parent if allocation failed)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgConcurrentHashSet<key_t, tHashFunc, tEquals>::link_ptr_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::init_bucket (const uint64_t &pBucketId) const
+{
+    link_ptr_t          parentHead;                                 /** Dummy node of the parent bucket */
+    link_ptr_t          dummy;                                      /** Dummy node of the bucket */
+    link_ptr_t          prev;                                       /** Link after which the dummy node is to be inserted */
+    link_ptr_t          curr;                                       /** Link before which the dummy node is to be inserted */
+    uint64_t            orderKey;                                   /** Position of the dummy node in the list */
+    uintptr_t           expected;                                   /** Expected value of the next pointer of prev */
+
+    parentHead      = get_bucket (get_parent (pBucketId));
+    orderKey        = get_dummy_key (pBucketId);
+
+    dummy           = new (std::nothrow) link_t {orderKey};
+
+    if (dummy == nullptr) {
+        return parentHead;
+    }
+
+    while (true) {
+
+        // another thread initialized the bucket first, so use its dummy node instead
+        if (find_util (parentHead, orderKey, nullptr, prev, curr)) {
+            delete dummy;
+            dummy       = curr;
+            break;
+        }
+
+        dummy->nextPtr.store (reinterpret_cast<uintptr_t> (curr), std::memory_order_relaxed);
+
+        expected    = reinterpret_cast<uintptr_t> (curr);
+        if (prev->nextPtr.compare_exchange_strong (expected, reinterpret_cast<uintptr_t> (dummy), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    // every thread stores the same dummy node, since only one can be in the list
+    get_slot (pBucketId)->store (dummy, std::memory_order_release);
+
+    return dummy;
+}
+
+/**
+ * @brief                   Returns the slot of the given bucket, allocating its segment if required
+ *
+ * @param pBucketId         Position of the bucket
+ *
+ * @return slot_t*          Pointer to the slot (nullptr if the segment could not be allocated)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgConcurrentHashSet<key_t, tHashFunc, tEquals>::slot_t *
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::get_slot (const uint64_t &pBucketId) const
+{
+    uint64_t            segmentId;                                  /** Position of the segment holding the bucket */
+    uint64_t            segmentBase;                                /** Position of the first bucket of the segment */
+    segment_ptr_t       segment;                                    /** Segment holding the bucket */
+    segment_ptr_t       expected;                                   /** Expected value of the segment pointer */
+
+    segmentId       = 0;
+    while ((pBucketId >> segmentId) != 0) {
+        ++segmentId;
+    }
+
+    segmentBase     = (segmentId == 0) ? (0ULL) : (1ULL << (segmentId - 1));
+    segment         = mSegments[segmentId].load (std::memory_order_acquire);
+
+    if (segment == nullptr) {
+
+        // the slots are value-initialized to nullptr (uninitialized buckets)
+        segment     = new (std::nothrow) slot_t[(segmentId == 0) ? (1ULL) : (segmentBase)] ();
+
+        if (segment == nullptr) {
+            return nullptr;
+        }
+
+        // if another thread allocated the segment first, use that one instead
+        expected    = nullptr;
+        if (!mSegments[segmentId].compare_exchange_strong (expected, segment, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            delete[] segment;
+            segment     = expected;
+        }
+    }
+
+    return segment + (pBucketId - segmentBase);
+}
+
+/**
+ * @brief                   Reverses the order of the bits of a 64 bit integer
+ *
+ * @param pVal              Integer to reverse
+ *
+ * @return uint64_t         Integer with the bits in reverse order
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::reverse_bits (uint64_t pVal)
+{
+    pVal    = ((pVal >> 1)  & 0x5555555555555555ULL) | ((pVal & 0x5555555555555555ULL) << 1);
+    pVal    = ((pVal >> 2)  & 0x3333333333333333ULL) | ((pVal & 0x3333333333333333ULL) << 2);
+    pVal    = ((pVal >> 4)  & 0x0F0F0F0F0F0F0F0FULL) | ((pVal & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    pVal    = ((pVal >> 8)  & 0x00FF00FF00FF00FFULL) | ((pVal & 0x00FF00FF00FF00FFULL) << 8);
+    pVal    = ((pVal >> 16) & 0x0000FFFF0000FFFFULL) | ((pVal & 0x0000FFFF0000FFFFULL) << 16);
+    pVal    = (pVal >> 32) | (pVal << 32);
+
+    return pVal;
+}
+
+/**
+ * @brief                   Returns the position in the list of a key with the given hash (always odd)
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint64_t         Order key of the key
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::get_regular_key (const hash_t &pKeyHash)
+{
+    return reverse_bits ((uint64_t)pKeyHash | (1ULL << 63));
+}
+
+/**
+ * @brief                   Returns the position in the list of the dummy node of the given bucket (always even)
+ *
+ * @param pBucketId         Position of the bucket
+ *
+ * @return uint64_t         Order key of the dummy node
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::get_dummy_key (const uint64_t &pBucketId)
+{
+    return reverse_bits (pBucketId);
+}
+
+/**
+ * @brief                   Returns the position of the bucket the given bucket was split from
+ *
+ * @param pBucketId         Position of the bucket (must not be 0)
+ *
+ * @return uint64_t         Position of the parent bucket
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::get_parent (const uint64_t &pBucketId)
+{
+    uint64_t            highestBit;                                 /** Highest set bit of the bucket's position */
+
+    highestBit      = pBucketId;
+    for (uint64_t shift = 1; shift < 64; shift *= 2) {
+        highestBit  |= highestBit >> shift;
+    }
+    highestBit      = highestBit ^ (highestBit >> 1);
+
+    return pBucketId ^ highestBit;
+}
+
+/**
+ * @brief                   Removes the mark bit from a raw next pointer
+ *
+ * @param pRaw              Raw next pointer
+ *
+ * @return link_ptr_t       Pointer to the link
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgConcurrentHashSet<key_t, tHashFunc, tEquals>::link_ptr_t
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::get_ptr (const uintptr_t &pRaw)
+{
+    return reinterpret_cast<link_ptr_t> (pRaw & ~sMarkBit);
+}
+
+/**
+ * @brief                   Frees a node which has been retired (only nodes holding keys are ever erased, dummy nodes are not)
+ *
+ * @param pPtr              Pointer to the node
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+void
+AgConcurrentHashSet<key_t, tHashFunc, tEquals>::delete_node (void *pPtr)
+{
+    delete static_cast<node_ptr_t> (static_cast<link_ptr_t> (pPtr));
+}
+
+#endif          // Header Guard
@@ -0,0 +1,391 @@
+/**
+ * @file            AgEpochDomain.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           Epoch based memory reclamation used by the lock-free containers
+ *
+ */
+
+#ifndef AG_EPOCH_DOMAIN_GUARD_H
+
+#define     AG_EPOCH_DOMAIN_GUARD_H
+
+#include <atomic>
+#include <vector>
+
+#include <cstdint>
+
+/**
+ * @brief                   AgEpochDomain decides when memory which has been unlinked from a lock-free structure can be freed
+ *
+ *                          Threads pin the domain (announcing the global epoch they observed) for the duration of every operation
+ *                          which reads shared nodes, and retire nodes after unlinking them instead of freeing them immediately
+ *                          The global epoch can only advance once every pinned thread has observed the current one, so a node
+ *                          retired during epoch e can not be referenced by any thread once the global epoch reaches e + 2
+ *
+ *                          Every thread gets its own record the first time it pins the domain, which it releases (keeping the nodes
+ *                          it retired, to be freed by the next thread using the record) when it exits
+ *                          There is a single domain per process, obtained with AgEpochDomain::instance ()
+ */
+class AgEpochDomain {
+
+
+
+    public:
+
+
+
+    using       deleter_t       = void (*) (void *);                               /** Function used to free a retired node */
+
+    /**
+     * @brief               Scope guard which pins the domain for the calling thread while it is alive (guards can be nested)
+     *
+     */
+    class guard {
+
+        public:
+
+        guard                                   ();
+        ~guard                                  ();
+
+        guard                                   (const guard &pOther) = delete;
+        guard           &operator=              (const guard &pOther) = delete;
+    };
+
+    ~AgEpochDomain                              ();
+
+    static AgEpochDomain    &instance           ();
+
+    void                    retire              (void *pPtr, deleter_t pDeleter);
+
+    bool                    try_advance         ();
+
+    uint64_t                get_epoch           () const;
+
+
+
+    private:
+
+
+
+    static constexpr uint64_t   sBagCount           = 3ULL;                     /** Number of bags of retired nodes kept by each record (one per epoch which might not be safe to free yet) */
+    static constexpr uint64_t   sCollectInterval    = 128ULL;                   /** Number of retirements after which a thread attempts to advance the epoch */
+
+    /**
+     * @brief               Node retired by a thread, along with the function needed to free it
+     *
+     */
+    struct retired_t {
+
+        void            *ptr;                                               /** Pointer to the retired node */
+        deleter_t       deleter;                                            /** Function which frees the node */
+    };
+
+    /**
+     * @brief               Per thread state (owned by a single thread at a time)
+     *
+     */
+    struct record_t {
+
+        std::atomic<uint64_t>       epoch       {0ULL};                     /** Epoch observed when pinned, shifted left by 1 with the lowest bit set (0 if not pinned) */
+        std::atomic<bool>           inUse       {true};                     /** If the record is owned by a thread */
+        record_t                    *nextPtr    {nullptr};                  /** Pointer to the next record (never changes once the record is published) */
+
+        uint64_t                    nesting     {0ULL};                     /** Number of guards currently alive on the owning thread */
+        uint64_t                    retireCnt   {0ULL};                     /** Number of nodes retired by the owning threads */
+
+        std::vector<retired_t>      bags[sBagCount];                        /** Nodes retired during each epoch (modulo sBagCount) */
+        uint64_t                    bagEpoch[sBagCount] {};                 /** Epoch during which the nodes in each bag were retired */
+    };
+
+    /**
+     * @brief               Holds the record of the calling thread and releases it when the thread exits
+     *
+     */
+    struct holder_t {
+
+        record_t        *mRecord;
+
+        holder_t                                ();
+        ~holder_t                               ();
+    };
+
+    AgEpochDomain                               () = default;
+
+    static record_t         *local_record       ();
+
+    record_t                *acquire_record     ();
+
+    void                    pin                 (record_t *pRecord);
+    void                    unpin               (record_t *pRecord);
+
+    void                    collect             (record_t *pRecord);
+    static void             free_bag            (std::vector<retired_t> &pBag);
+
+
+    std::atomic<uint64_t>   mEpoch      {0ULL};                             /** Global epoch */
+    std::atomic<record_t *> mRecords    {nullptr};                          /** Head of the list of records (records are only ever added) */
+};
+
+/**
+ * @brief                   Pins the domain for the calling thread
+ *
+ */
+inline
+AgEpochDomain::guard::guard ()
+{
+    AgEpochDomain::instance ().pin (local_record ());
+}
+
+/**
+ * @brief                   Unpins the domain for the calling thread (if this was the outermost guard)
+ *
+ */
+inline
+AgEpochDomain::guard::~guard ()
+{
+    AgEpochDomain::instance ().unpin (local_record ());
+}
+
+/**
+ * @brief                   Destroy the AgEpochDomain object, freeing every node which is still waiting to be freed
+ *
+ *                          Only runs when the process exits, after which no thread can be using any lock-free structure
+ */
+inline
+AgEpochDomain::~AgEpochDomain ()
+{
+    record_t            *record;                                    /** Record being freed */
+    record_t            *nextRecord;                                /** Record after the one being freed */
+
+    record              = mRecords.load (std::memory_order_acquire);
+
+    while (record != nullptr) {
+
+        nextRecord  = record->nextPtr;
+
+        for (auto &bag : record->bags) {
+            free_bag (bag);
+        }
+        delete record;
+
+        record      = nextRecord;
+    }
+}
+
+/**
+ * @brief                   Returns the domain shared by every lock-free structure in the process
+ *
+ * @return AgEpochDomain&   Reference to the domain
+ */
+inline AgEpochDomain &
+AgEpochDomain::instance ()
+{
+    static AgEpochDomain    domain;
+
+    return domain;
+}
+
+/**
+ * @brief                   Hands over a node which has been unlinked from a structure, to be freed once no thread can reference it
+ *
+ *                          Must be called by a thread which has pinned the domain
+ *
+ * @param pPtr              Pointer to the node
+ * @param pDeleter          Function which frees the node
+ */
+inline void
+AgEpochDomain::retire (void *pPtr, deleter_t pDeleter)
+{
+    record_t            *record;                                    /** Record of the calling thread */
+    uint64_t            epoch;                                      /** Current global epoch */
+    uint64_t            bagId;                                      /** Position of the bag for the current epoch */
+
+    record          = local_record ();
+
+    // the node was unlinked before the epoch is read, so it can not have been unlinked during a later epoch
+    epoch           = mEpoch.load (std::memory_order_acquire);
+    bagId           = epoch % sBagCount;
+
+    // if the bag belongs to an older epoch, it must be at least sBagCount epochs old, so its nodes are safe to free
+    if (record->bagEpoch[bagId] != epoch) {
+        free_bag (record->bags[bagId]);
+        record->bagEpoch[bagId]    = epoch;
+    }
+
+    record->bags[bagId].push_back ({pPtr, pDeleter});
+
+    if ((++record->retireCnt % sCollectInterval) == 0) {
+        try_advance ();
+        collect (record);
+    }
+}
+
+/**
+ * @brief                   Attempts to advance the global epoch (only possible if every pinned thread has observed the current one)
+ *
+ * @return true             If the global epoch was advanced (by this or another thread)
+ * @return false            If some thread is still pinned to an older epoch
+ */
+inline bool
+AgEpochDomain::try_advance ()
+{
+    uint64_t            epoch;                                      /** Current global epoch */
+    uint64_t            observed;                                   /** Epoch announced by a record */
+
+    epoch           = mEpoch.load (std::memory_order_seq_cst);
+
+    for (record_t *record = mRecords.load (std::memory_order_acquire); record != nullptr; record = record->nextPtr) {
+
+        observed    = record->epoch.load (std::memory_order_seq_cst);
+
+        if ((observed & 1ULL) && ((observed >> 1) != epoch)) {
+            return false;
+        }
+    }
+
+    mEpoch.compare_exchange_strong (epoch, epoch + 1ULL, std::memory_order_seq_cst);
+    return true;
+}
+
+/**
+ * @brief                   Returns the current global epoch
+ *
+ * @return uint64_t         Current global epoch
+ */
+inline uint64_t
+AgEpochDomain::get_epoch () const
+{
+    return mEpoch.load (std::memory_order_acquire);
+}
+
+/**
+ * @brief                   Acquires a record for the calling thread (reusing one released by an exited thread if possible)
+ *
+ */
+inline
+AgEpochDomain::holder_t::holder_t ()
+{
+    mRecord     = AgEpochDomain::instance ().acquire_record ();
+}
+
+/**
+ * @brief                   Releases the record of the calling thread, which keeps any nodes which are not yet safe to free
+ *
+ */
+inline
+AgEpochDomain::holder_t::~holder_t ()
+{
+    mRecord->epoch.store (0ULL, std::memory_order_release);
+    mRecord->inUse.store (false, std::memory_order_release);
+}
+
+/**
+ * @brief                   Returns the record of the calling thread (acquiring one the first time it is called on a thread)
+ *
+ * @return record_t*        Pointer to the record
+ */
+inline AgEpochDomain::record_t *
+AgEpochDomain::local_record ()
+{
+    thread_local holder_t   holder;
+
+    return holder.mRecord;
+}
+
+/**
+ * @brief                   Claims a record which is not owned by any thread, or publishes a new one if every record is in use
+ *
+ * @return record_t*        Pointer to the claimed record
+ */
+inline AgEpochDomain::record_t *
+AgEpochDomain::acquire_record ()
+{
+    record_t            *record;                                    /** Record being checked/created */
+    bool                expected;                                   /** Expected value of the record's in use flag */
+
+    for (record = mRecords.load (std::memory_order_acquire); record != nullptr; record = record->nextPtr) {
+
+        expected    = false;
+        if (record->inUse.compare_exchange_strong (expected, true, std::memory_order_acq_rel)) {
+            return record;
+        }
+    }
+
+    record              = new record_t;
+    record->nextPtr     = mRecords.load (std::memory_order_relaxed);
+
+    while (!mRecords.compare_exchange_weak (record->nextPtr, record, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+
+    return record;
+}
+
+/**
+ * @brief                   Announces the current global epoch on the given record (unless it is already pinned)
+ *
+ * @param pRecord           Record of the calling thread
+ */
+inline void
+AgEpochDomain::pin (record_t *pRecord)
+{
+    if (pRecord->nesting++ != 0) {
+        return;
+    }
+
+    pRecord->epoch.store ((mEpoch.load (std::memory_order_relaxed) << 1) | 1ULL, std::memory_order_relaxed);
+
+    // the announcement must be visible to other threads before any shared node is read
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+}
+
+/**
+ * @brief                   Removes the announcement from the given record (if this was the outermost guard)
+ *
+ * @param pRecord           Record of the calling thread
+ */
+inline void
+AgEpochDomain::unpin (record_t *pRecord)
+{
+    if (--pRecord->nesting != 0) {
+        return;
+    }
+
+    pRecord->epoch.store (0ULL, std::memory_order_release);
+}
+
+/**
+ * @brief                   Frees every bag of the given record whose nodes were retired at least 2 epochs ago
+ *
+ * @param pRecord           Record of the calling thread
+ */
+inline void
+AgEpochDomain::collect (record_t *pRecord)
+{
+    uint64_t            epoch;                                      /** Current global epoch */
+
+    epoch           = mEpoch.load (std::memory_order_acquire);
+
+    for (uint64_t bagId = 0; bagId < sBagCount; ++bagId) {
+        if (pRecord->bagEpoch[bagId] + 2ULL <= epoch) {
+            free_bag (pRecord->bags[bagId]);
+        }
+    }
+}
+
+/**
+ * @brief                   Frees every node in the given bag and empties it
+ *
+ * @param pBag              Bag to free
+ */
+inline void
+AgEpochDomain::free_bag (std::vector<retired_t> &pBag)
+{
+    for (auto &retired : pBag) {
+        retired.deleter (retired.ptr);
+    }
+
+    pBag.clear ();
+}
+
+#endif          // Header Guard
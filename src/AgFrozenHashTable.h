@@ -0,0 +1,927 @@
+/**
+ * @file            AgFrozenHashTable.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           AgFrozenHashTable class, an immutable set of keys indexed by a minimal perfect hash function
+ *
+ */
+
+#ifndef AG_FROZEN_HASH_TABLE_GUARD_H
+
+#define     AG_FROZEN_HASH_TABLE_GUARD_H
+
+#include <new>
+#include <atomic>
+#include <thread>
+#include <system_error>
+
+#include <type_traits>
+#include <cstdint>
+#include <limits>
+
+#include "AgHashTable.h"
+
+/**
+ * @brief                   AgFrozenHashTable is an immutable set of keys, built once from an existing table (see ag_freeze ()) or a range
+ *                          of keys, which stores the keys in a dense array and finds them with a minimal perfect hash function
+ *
+ *                          The perfect hash function is built like BBHash, in levels of bit arrays: every key still unplaced is hashed
+ *                          to a bit of the next level, and the keys which do not share their bit with any other key are placed there,
+ *                          while the rest move on to the next level
+ *                          The position of a key in the dense array is the number of set bits before its bit (across every level), so
+ *                          a lookup only compares against the single key at that position
+ *                          The levels take about sGamma / (1 - 1 / e ^ (1 / sGamma)) bits per key (plus a seventh of that for rank
+ *                          samples, which are kept in the same cache line as the bits they count), and keys whose 64 bit hashes are
+ *                          equal (which never get a bit of their own) are kept at the end of the dense array, and searched linearly
+ *                          Building each level is split across threads, which mark bits with atomic operations; once built, the
+ *                          table is never modified, so it can be read from any number of threads without locks
+ *
+ * @tparam key_t            Type of key to store
+ * @tparam tHashFunc        Function to hash a key (defaults to Fibonacci hashing for integers and FNV-1a otherwise, see ag_default_hash ())
+ * @tparam tEquals          Function to compare two keys for equality
+ */
+template <typename key_t, auto tHashFunc = ag_default_hash<key_t, size_t> (), auto tEquals = ag_hashtable_default_equals<key_t>>
+class AgFrozenHashTable {
+
+
+
+    protected:
+
+
+
+    using       hash_t          = typename std::invoke_result<decltype (tHashFunc), const key_t *>::type;     /** Data type returned by the hash function (must be unsigned integral type */
+
+    static_assert (std::is_unsigned<hash_t>::value, "Return type of hash functions must be unsigned integer");
+
+    using       word_t          = uint64_t;                                             /** Type of the words holding the bits of the levels */
+    using       atomic_word_t   = std::atomic<word_t>;                                  /** Type of the words marked while building a level */
+
+    static constexpr uint64_t   sGamma                  = 2ULL;                         /** Number of bits in a level per key hashed into it */
+    static constexpr uint64_t   sMaxLevels              = 32ULL;                        /** Maximum number of levels (keys still unplaced after them are kept at the end) */
+    static constexpr uint64_t   sWordBits               = 64ULL;                        /** Number of bits per word */
+    static constexpr uint64_t   sWordsPerBlock          = 7ULL;                         /** Number of words of bits in each block (along with a rank sample) */
+
+    static constexpr uint64_t   sMaxBuildThreads        = 256ULL;                       /** Maximum number of threads the build can be split across */
+    static constexpr uint64_t   sMinKeysPerThread       = 1ULL << 14;                   /** Minimum number of keys handled by each thread of a parallel build */
+
+    static constexpr uint64_t   sNotFound               = std::numeric_limits<uint64_t>::max ();   /** Position returned when a key could not be found */
+
+    /**
+     * @brief               Block of bits of the levels, along with the number of set bits before it (so that finding the rank of a bit
+     *                      only reads the cache line holding the bit)
+     *
+     */
+    struct alignas (64) block_t {
+
+        uint64_t            rank;                                   /** Number of set bits in every block before this one */
+        word_t              bits[sWordsPerBlock];                   /** Bits of the levels (words are numbered across blocks, see word ()) */
+    };
+
+
+
+    public:
+
+
+
+    struct iterator {
+
+        protected:
+
+        using ptr_t             = const key_t *;
+        using ref_t             = const key_t &;
+
+        ptr_t       mPtr        {nullptr};                                  /** Pointer to the key in the dense array */
+
+        public:
+
+        iterator                (ptr_t pPtr);
+        iterator                () = default;
+
+        iterator operator++     ();
+        iterator operator++     (int);
+
+        ref_t    operator*      () const;
+
+        bool     operator==     (const iterator & pOther) const;
+        bool     operator!=     (const iterator & pOther) const;
+
+    };
+
+    //  Constructors
+
+    AgFrozenHashTable   () = default;
+
+    template <typename iter_t>
+    AgFrozenHashTable   (iter_t pBegin, iter_t pEnd, const uint64_t &pThreadCount = 1ULL);
+
+    template <auto tOtherEquals, typename tLayout, typename tAlloc>
+    AgFrozenHashTable   (const AgHashTable<key_t, tHashFunc, tOtherEquals, tLayout, tAlloc> &pTable, const uint64_t &pThreadCount = 1ULL);
+
+    AgFrozenHashTable   (const AgFrozenHashTable &pOther) = delete;
+
+    //  Destructors
+
+    ~AgFrozenHashTable  ();
+
+    //  Getters
+
+    bool                initialized             () const;
+
+    uint64_t            size                    () const;
+    uint64_t            get_key_count           () const;
+
+    uint64_t            get_level_count         () const;
+    uint64_t            get_fallback_count      () const;
+    uint64_t            get_overhead_bytes      () const;
+
+    uint64_t            get_index               (const key_t &pKey) const;
+
+    iterator            find                    (const key_t &pKey) const;
+    bool                exists                  (const key_t &pKey) const;
+
+    // Iterators and Iteration
+
+    iterator            begin                   () const;
+    iterator            end                     () const;
+
+
+
+    private:
+
+
+
+    // Getters
+
+    static uint64_t     level_bit               (const uint64_t &pHash, const uint64_t &pLevel, const uint64_t &pLevelBits);
+    static uint64_t     popcount                (const word_t &pWord);
+
+    const word_t        &word                   (const uint64_t &pWordId) const;
+
+    uint64_t            rank                    (const uint64_t &pBit) const;
+    uint64_t            lookup                  (const uint64_t &pHash) const;
+
+    // Modifiers
+
+    bool                build                   (const key_t **pKeys, const uint64_t &pCount, const uint64_t &pThreadCount);
+    bool                build_levels            (uint64_t *pHashes, uint64_t pCount, const uint64_t &pThreadCount);
+
+    template <typename func_t>
+    static uint64_t     split                   (const uint64_t &pCount, const uint64_t &pThreadCount, const func_t &pFunc);
+
+    void                release                 ();
+
+
+    block_t             *mBlocks        {nullptr};                          /** Bits of every level (one level after the other) with rank samples */
+    uint64_t            mBlockCount     {0ULL};                             /** Number of blocks */
+    key_t               *mKeys          {nullptr};                          /** Dense array of keys, in the order of their bits (followed by the fallback keys) */
+
+    uint64_t            mLevelWords[sMaxLevels + 1]     {};                 /** Position (in words) of the first word of every level */
+    uint64_t            mLevelCount     {0ULL};                             /** Number of levels */
+
+    uint64_t            mKeyCount       {0ULL};                             /** Number of keys in the table */
+    uint64_t            mFallbackCount  {0ULL};                             /** Number of keys without a bit of their own (at the end of mKeys) */
+    bool                mInitialized    {true};                             /** If the table could be built (false on allocation failure) */
+
+};
+
+/**
+ * @brief                   Builds a frozen copy of a table, which holds the same keys and can only be searched
+ *
+ * @param pTable            Table to freeze (must not be modified while this runs)
+ * @param pThreadCount      Number of threads to split the build across (fewer are used for small tables)
+ *
+ * @return AgFrozenHashTable    Frozen copy of the table (check initialized () for allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgFrozenHashTable<key_t, tHashFunc, tEquals>
+ag_freeze (const AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc> &pTable, const uint64_t &pThreadCount = 1ULL)
+{
+    return AgFrozenHashTable<key_t, tHashFunc, tEquals> {pTable, pThreadCount};
+}
+
+/**
+ * @brief                   Construct a new AgFrozenHashTable object from a range of keys (duplicate keys are only held once)
+ *
+ * @tparam iter_t           Type of iterators over the range (must dereference to keys which stay in place, such as those of containers)
+ *
+ * @param pBegin            Iterator to the first key
+ * @param pEnd              Iterator after the last key
+ * @param pThreadCount      Number of threads to split the build across (fewer are used for small ranges)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename iter_t>
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::AgFrozenHashTable (iter_t pBegin, iter_t pEnd, const uint64_t &pThreadCount)
+{
+    const key_t         **keys;                                     /** Pointers to every key of the range */
+    uint64_t            count       {0ULL};                         /** Number of keys in the range */
+
+    for (iter_t it = pBegin; it != pEnd; ++it) {
+        ++count;
+    }
+
+    keys            = new (std::nothrow) const key_t *[count + 1];
+    if (keys == nullptr) {
+        mInitialized    = false;
+        return;
+    }
+
+    count           = 0ULL;
+    for (iter_t it = pBegin; it != pEnd; ++it) {
+        keys[count++]   = &(*it);
+    }
+
+    mInitialized    = build (keys, count, pThreadCount);
+
+    delete[] keys;
+}
+
+/**
+ * @brief                   Construct a new AgFrozenHashTable object holding the keys of a table (of any layout)
+ *
+ * @param pTable            Table whose keys are to be held (must not be modified while this runs)
+ * @param pThreadCount      Number of threads to split the build across (fewer are used for small tables)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+template <auto tOtherEquals, typename tLayout, typename tAlloc>
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::AgFrozenHashTable (const AgHashTable<key_t, tHashFunc, tOtherEquals, tLayout, tAlloc> &pTable, const uint64_t &pThreadCount) :
+    AgFrozenHashTable {pTable.begin (), pTable.end (), pThreadCount}
+{
+}
+
+/**
+ * @brief                   Destroy the AgFrozenHashTable object
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::~AgFrozenHashTable ()
+{
+    release ();
+}
+
+/**
+ * @brief                   Destroys every key and frees the levels, rank samples and dense array
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+void
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::release ()
+{
+    for (uint64_t keyId = 0; keyId < mKeyCount; ++keyId) {
+        mKeys[keyId].~key_t ();
+    }
+
+    ::operator delete (mKeys);
+    delete[] mBlocks;
+
+    mKeys           = nullptr;
+    mBlocks         = nullptr;
+    mBlockCount     = 0ULL;
+
+    mLevelCount     = 0ULL;
+    mKeyCount       = 0ULL;
+    mFallbackCount  = 0ULL;
+}
+
+/**
+ * @brief                   Returns if the table could be successfully built
+ *
+ * @return true             If the table could be successfully built
+ * @return false            If the table could not be successfully built (allocation failure), in which case it is empty
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::initialized () const
+{
+    return mInitialized;
+}
+
+/**
+ * @brief                   Returns the number of keys in the table (identical to get_key_count())
+ *
+ * @return uint64_t         Number of keys in the table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::size () const
+{
+    return mKeyCount;
+}
+
+/**
+ * @brief                   Returns the number of keys in the table (identical to size())
+ *
+ * @return uint64_t         Number of keys in the table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::get_key_count () const
+{
+    return mKeyCount;
+}
+
+/**
+ * @brief                   Returns the number of levels of the perfect hash function (a lookup reads atmost this many bits)
+ *
+ * @return uint64_t         Number of levels
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::get_level_count () const
+{
+    return mLevelCount;
+}
+
+/**
+ * @brief                   Returns the number of keys without a bit of their own, which are searched linearly (keys whose hashes
+ *                          are equal to another key's hash)
+ *
+ * @return uint64_t         Number of keys at the end of the dense array
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::get_fallback_count () const
+{
+    return mFallbackCount;
+}
+
+/**
+ * @brief                   Returns the number of bytes used by the perfect hash function (the levels and rank samples), which is
+ *                          everything other than the keys themselves
+ *
+ * @return uint64_t         Number of bytes used in addition to the dense array
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::get_overhead_bytes () const
+{
+    return sizeof (block_t) * mBlockCount;
+}
+
+/**
+ * @brief                   Returns the position of a key in the dense array (which is less than size ()), so that values can be
+ *                          kept in an array of their own
+ *
+ * @param pKey              Key to search for
+ *
+ * @return uint64_t         Position of the key (std::numeric_limits<uint64_t>::max () if the key is not in the table)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::get_index (const key_t &pKey) const
+{
+    uint64_t            keyId;                                      /** Position given by the perfect hash function */
+
+    keyId           = lookup ((uint64_t)tHashFunc (&pKey));
+
+    if (keyId != sNotFound) {
+        return tEquals (pKey, mKeys[keyId]) ? (keyId) : (sNotFound);
+    }
+
+    // keys without a bit of their own are only searched if the key has no bit either
+    for (keyId = mKeyCount - mFallbackCount; keyId < mKeyCount; ++keyId) {
+        if (tEquals (pKey, mKeys[keyId])) {
+            return keyId;
+        }
+    }
+
+    return sNotFound;
+}
+
+/**
+ * @brief                   Searches for a given key in the table and returns an iterator to it (returns end() if no matching key is found)
+ *
+ * @param pKey              Key to search for
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::find (const key_t &pKey) const
+{
+    const uint64_t      keyId       = get_index (pKey);             /** Position of the key */
+
+    return (keyId == sNotFound) ? (end ()) : (iterator {mKeys + keyId});
+}
+
+/**
+ * @brief                   Returns if a given key exists in the table
+ *
+ * @param pKey              Key to search for
+ *
+ * @return true             If the supplied key exists in the table
+ * @return false            If the supplied key does not exist in the table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::exists (const key_t &pKey) const
+{
+    return get_index (pKey) != sNotFound;
+}
+
+/**
+ * @brief                   Returns the bit of a level which a key with the given hash is hashed to
+ *
+ *                          The hash is mixed with the level, so that keys sharing a bit in one level are spread out in the next,
+ *                          and the mixed hash is mapped to the level with a multiplication instead of a division
+ *
+ * @param pHash             Hash of the key
+ * @param pLevel            Level to hash the key into
+ * @param pLevelBits        Number of bits in the level
+ *
+ * @return uint64_t         Position of the bit within the level
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::level_bit (const uint64_t &pHash, const uint64_t &pLevel, const uint64_t &pLevelBits)
+{
+    uint64_t            mixed       = ag_wymix (pHash ^ ag_wyhash_secret[0], ag_wyhash_secret[1] + pLevel * ag_wyhash_secret[2]);
+    uint64_t            bit         = pLevelBits;
+
+    ag_wymum (mixed, bit);
+
+    return bit;
+}
+
+/**
+ * @brief                   Returns the number of set bits in a word
+ *
+ * @param pWord             Word whose bits are to be counted
+ *
+ * @return uint64_t         Number of set bits
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::popcount (const word_t &pWord)
+{
+#if !defined (AG_HASH_TABLE_NO_SIMD) && defined (__POPCNT__)
+    return (uint64_t)__builtin_popcountll (pWord);
+#elif !defined (AG_HASH_TABLE_NO_SIMD) && defined (_MSC_VER) && defined (_M_X64) && defined (__AVX__)
+    return (uint64_t)__popcnt64 (pWord);
+#else
+    // without the popcnt instruction, the bits are summed in parallel within the word (which is faster than the library call the
+    // builtin becomes)
+    word_t              bits        = pWord;
+
+    bits    = bits - ((bits >> 1) & 0x5555555555555555ULL);
+    bits    = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits    = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    return (uint64_t)((bits * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief                   Returns a word of bits of the levels
+ *
+ * @param pWordId           Position of the word (across every level)
+ *
+ * @return const word_t&    Word of bits
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+const typename AgFrozenHashTable<key_t, tHashFunc, tEquals>::word_t &
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::word (const uint64_t &pWordId) const
+{
+    return mBlocks[pWordId / sWordsPerBlock].bits[pWordId % sWordsPerBlock];
+}
+
+/**
+ * @brief                   Returns the number of set bits before a given bit (across every level)
+ *
+ * @param pBit              Position of the bit
+ *
+ * @return uint64_t         Number of set bits before it
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::rank (const uint64_t &pBit) const
+{
+    const uint64_t      wordId      = pBit / sWordBits;             /** Position of the word holding the bit */
+    const block_t       &block      = mBlocks[wordId / sWordsPerBlock];     /** Block holding the bit */
+    uint64_t            res;                                        /** Number of set bits before the bit */
+
+    res             = block.rank;
+
+    for (uint64_t otherId = 0; otherId < wordId % sWordsPerBlock; ++otherId) {
+        res         += popcount (block.bits[otherId]);
+    }
+
+    return res + popcount (block.bits[wordId % sWordsPerBlock] & ((1ULL << (pBit % sWordBits)) - 1ULL));
+}
+
+/**
+ * @brief                   Returns the position in the dense array which a key with the given hash maps to (the key there may
+ *                          still be a different one, if the key is not in the table)
+ *
+ * @param pHash             Hash of the key
+ *
+ * @return uint64_t         Position in the dense array (sNotFound if the key has no bit in any level)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::lookup (const uint64_t &pHash) const
+{
+    uint64_t            bit;                                        /** Position of the key's bit (across every level) */
+
+    for (uint64_t level = 0; level < mLevelCount; ++level) {
+
+        bit         = mLevelWords[level] * sWordBits + level_bit (pHash, level, (mLevelWords[level + 1] - mLevelWords[level]) * sWordBits);
+
+        if ((word (bit / sWordBits) >> (bit % sWordBits)) & 1ULL) {
+            return rank (bit);
+        }
+    }
+
+    return sNotFound;
+}
+
+/**
+ * @brief                   Splits a number of items into contiguous ranges and calls a function on every range, each on its own
+ *                          thread (the calling thread handles the first range, and any range whose thread could not be started)
+ *
+ *                          The ranges only depend on the number of items and threads, so calling this twice with the same numbers
+ *                          gives every thread the same range both times
+ *
+ * @tparam func_t           Type of the function (called with the position of the range, and its first and last item)
+ *
+ * @param pCount            Number of items
+ * @param pThreadCount      Number of threads to split the items across (fewer are used if each would get less than sMinKeysPerThread)
+ * @param pFunc             Function to call on every range
+ *
+ * @return uint64_t         Number of ranges
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename func_t>
+uint64_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::split (const uint64_t &pCount, const uint64_t &pThreadCount, const func_t &pFunc)
+{
+    uint64_t            threadCount;                                /** Number of ranges */
+
+    threadCount     = (pThreadCount < sMaxBuildThreads) ? (pThreadCount) : (sMaxBuildThreads);
+    threadCount     = (threadCount < pCount / sMinKeysPerThread) ? (threadCount) : (pCount / sMinKeysPerThread);
+    threadCount     = (threadCount > 1ULL) ? (threadCount) : (1ULL);
+
+    if (threadCount == 1ULL) {
+        pFunc (0ULL, 0ULL, pCount);
+        return 1ULL;
+    }
+
+    std::thread         workers[sMaxBuildThreads];                  /** Threads handling every range but the first */
+
+    for (uint64_t threadId = 1; threadId < threadCount; ++threadId) {
+        try {
+            workers[threadId]   = std::thread {pFunc, threadId, pCount * threadId / threadCount, pCount * (threadId + 1) / threadCount};
+        }
+        catch (const std::system_error &) {
+            pFunc (threadId, pCount * threadId / threadCount, pCount * (threadId + 1) / threadCount);
+        }
+    }
+
+    pFunc (0ULL, 0ULL, pCount / threadCount);
+
+    for (uint64_t threadId = 1; threadId < threadCount; ++threadId) {
+        if (workers[threadId].joinable ()) {
+            workers[threadId].join ();
+        }
+    }
+
+    return threadCount;
+}
+
+/**
+ * @brief                   Builds the perfect hash function for a set of keys, and places the keys in the dense array
+ *
+ * @param pKeys             Pointers to the keys
+ * @param pCount            Number of keys
+ * @param pThreadCount      Number of threads to split the build across
+ *
+ * @return true             If the table could be built
+ * @return false            If the table could not be built (allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::build (const key_t **pKeys, const uint64_t &pCount, const uint64_t &pThreadCount)
+{
+    uint64_t            *hashes;                                    /** Hash of every key (reordered while building the levels) */
+    uint64_t            levelKeyCount;                              /** Number of keys with a bit of their own */
+    uint64_t            fallbackId;                                 /** Position of the next key without a bit of its own */
+
+    hashes          = new (std::nothrow) uint64_t[pCount + 1];
+    if (hashes == nullptr) {
+        return false;
+    }
+
+    split (pCount, pThreadCount, [pKeys, hashes] (uint64_t, uint64_t pBegin, uint64_t pEnd) {
+        for (uint64_t keyId = pBegin; keyId < pEnd; ++keyId) {
+            hashes[keyId]   = (uint64_t)tHashFunc (pKeys[keyId]);
+        }
+    });
+
+    if (!build_levels (hashes, pCount, pThreadCount)) {
+        delete[] hashes;
+        release ();
+        return false;
+    }
+
+    delete[] hashes;
+
+    // keys with a bit of their own are placed at the rank of their bit, which no other key shares
+    levelKeyCount   = rank (mLevelWords[mLevelCount] * sWordBits);
+
+    mKeys           = static_cast<key_t *> (::operator new (sizeof (key_t) * (pCount + 1), std::nothrow));
+    if (mKeys == nullptr) {
+        release ();
+        return false;
+    }
+
+    split (pCount, pThreadCount, [this, pKeys] (uint64_t, uint64_t pBegin, uint64_t pEnd) {
+        for (uint64_t keyId = pBegin; keyId < pEnd; ++keyId) {
+
+            uint64_t    position    = lookup ((uint64_t)tHashFunc (pKeys[keyId]));
+
+            if (position != sNotFound) {
+                new (mKeys + position) key_t (*pKeys[keyId]);
+            }
+        }
+    });
+
+    mKeyCount       = levelKeyCount;
+
+    // keys without a bit of their own (which is rare unless there are duplicate keys) are appended, skipping duplicates
+    if (levelKeyCount == pCount) {
+        return true;
+    }
+
+    for (uint64_t keyId = 0; keyId < pCount; ++keyId) {
+
+        if (lookup ((uint64_t)tHashFunc (pKeys[keyId])) != sNotFound) {
+            continue;
+        }
+
+        for (fallbackId = levelKeyCount; fallbackId < mKeyCount && !tEquals (*pKeys[keyId], mKeys[fallbackId]); ++fallbackId);
+
+        if (fallbackId == mKeyCount) {
+            new (mKeys + mKeyCount) key_t (*pKeys[keyId]);
+            ++mKeyCount;
+            ++mFallbackCount;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief                   Builds the levels of the perfect hash function and their rank samples
+ *
+ *                          Every level is built in three passes split across threads: keys mark their bits (and the bits marked
+ *                          twice), the level keeps the bits marked once, and the keys which lost their bit are moved to the front
+ *                          of the array of hashes (each thread moving its range to an offset found from the counts of the others)
+ *
+ * @param pHashes           Hash of every key (reordered, so that the keys of each level are at the front)
+ * @param pCount            Number of keys
+ * @param pThreadCount      Number of threads to split the build across
+ *
+ * @return true             If the levels could be built
+ * @return false            If the levels could not be built (allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::build_levels (uint64_t *pHashes, uint64_t pCount, const uint64_t &pThreadCount)
+{
+    word_t              *levels[sMaxLevels] {};                     /** Bits of every level, built separately and joined at the end */
+    uint64_t            *remaining;                                 /** Hashes of the keys which lost their bit in the present level */
+    uint64_t            *allocated;                                 /** Array of hashes allocated here (pHashes and remaining are swapped every level) */
+    uint64_t            rangeCounts[sMaxBuildThreads + 1];          /** Number of keys which lost their bit in every range (then the offset of the range) */
+    uint64_t            rangeCount;                                 /** Number of ranges the keys are split into */
+    uint64_t            wordCount;                                  /** Number of words in the present level */
+    uint64_t            setCount;                                   /** Number of set bits before the present word */
+
+    atomic_word_t       *marked;                                    /** Bits marked by atleast one key */
+    atomic_word_t       *shared;                                    /** Bits marked by more than one key */
+
+    bool                success     {true};
+
+    remaining       = new (std::nothrow) uint64_t[pCount + 1];
+    allocated       = remaining;
+    if (remaining == nullptr) {
+        return false;
+    }
+
+    for (mLevelCount = 0; pCount > 0 && mLevelCount < sMaxLevels; ++mLevelCount) {
+
+        wordCount   = (pCount * sGamma + sWordBits - 1ULL) / sWordBits;
+
+        levels[mLevelCount] = new (std::nothrow) word_t[wordCount];
+        marked      = new (std::nothrow) atomic_word_t[wordCount] ();
+        shared      = new (std::nothrow) atomic_word_t[wordCount] ();
+
+        if (levels[mLevelCount] == nullptr || marked == nullptr || shared == nullptr) {
+            ++mLevelCount;
+            delete[] marked;
+            delete[] shared;
+            success     = false;
+            break;
+        }
+
+        const uint64_t  level       = mLevelCount;
+        const uint64_t  levelBits   = wordCount * sWordBits;
+        word_t          *bits       = levels[mLevelCount];
+
+        // mark the bit of every key, and the bits which have already been marked by another key
+        split (pCount, pThreadCount, [pHashes, marked, shared, level, levelBits] (uint64_t, uint64_t pBegin, uint64_t pEnd) {
+            for (uint64_t keyId = pBegin; keyId < pEnd; ++keyId) {
+
+                uint64_t    bit         = level_bit (pHashes[keyId], level, levelBits);
+                word_t      mask        = 1ULL << (bit % sWordBits);
+
+                if (marked[bit / sWordBits].fetch_or (mask, std::memory_order_relaxed) & mask) {
+                    shared[bit / sWordBits].fetch_or (mask, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        // the level keeps the bits of the keys which have their bit to themselves
+        split (wordCount, pThreadCount, [bits, marked, shared] (uint64_t, uint64_t pBegin, uint64_t pEnd) {
+            for (uint64_t wordId = pBegin; wordId < pEnd; ++wordId) {
+                bits[wordId]    = marked[wordId].load (std::memory_order_relaxed) & ~shared[wordId].load (std::memory_order_relaxed);
+            }
+        });
+
+        delete[] marked;
+        delete[] shared;
+
+        // count the keys of every range which lost their bit, so each range knows where to move its keys to
+        auto            lost        = [pHashes, bits, level, levelBits] (const uint64_t &pKeyId) {
+            uint64_t    bit         = level_bit (pHashes[pKeyId], level, levelBits);
+            return ((bits[bit / sWordBits] >> (bit % sWordBits)) & 1ULL) == 0ULL;
+        };
+
+        rangeCount  = split (pCount, pThreadCount, [&rangeCounts, &lost] (uint64_t pRangeId, uint64_t pBegin, uint64_t pEnd) {
+            rangeCounts[pRangeId]   = 0ULL;
+            for (uint64_t keyId = pBegin; keyId < pEnd; ++keyId) {
+                rangeCounts[pRangeId]   += lost (keyId);
+            }
+        });
+
+        for (uint64_t rangeId = 0, offset = 0; rangeId <= rangeCount; ++rangeId) {
+            uint64_t    rangeLost   = (rangeId < rangeCount) ? (rangeCounts[rangeId]) : (0ULL);
+
+            rangeCounts[rangeId]    = offset;
+            offset                  += rangeLost;
+        }
+
+        split (pCount, pThreadCount, [&rangeCounts, &lost, pHashes, remaining] (uint64_t pRangeId, uint64_t pBegin, uint64_t pEnd) {
+            uint64_t    offset      = rangeCounts[pRangeId];
+
+            for (uint64_t keyId = pBegin; keyId < pEnd; ++keyId) {
+                if (lost (keyId)) {
+                    remaining[offset++]     = pHashes[keyId];
+                }
+            }
+        });
+
+        pCount      = rangeCounts[rangeCount];
+
+        std::swap (pHashes, remaining);
+
+        mLevelWords[mLevelCount + 1]    = mLevelWords[mLevelCount] + wordCount;
+    }
+
+    // join the levels into a single array of blocks (the word after the last level is left empty, so that the rank of the bit after
+    // the last level is the number of set bits)
+    if (success) {
+        mBlockCount = mLevelWords[mLevelCount] / sWordsPerBlock + 1ULL;
+        mBlocks     = new (std::nothrow) block_t[mBlockCount] ();
+        success     = (mBlocks != nullptr);
+    }
+
+    if (success) {
+        for (uint64_t level = 0; level < mLevelCount; ++level) {
+            for (uint64_t wordId = mLevelWords[level]; wordId < mLevelWords[level + 1]; ++wordId) {
+                mBlocks[wordId / sWordsPerBlock].bits[wordId % sWordsPerBlock]  = levels[level][wordId - mLevelWords[level]];
+            }
+        }
+
+        setCount    = 0ULL;
+        for (uint64_t blockId = 0; blockId < mBlockCount; ++blockId) {
+            mBlocks[blockId].rank   = setCount;
+            for (uint64_t wordId = 0; wordId < sWordsPerBlock; ++wordId) {
+                setCount    += popcount (mBlocks[blockId].bits[wordId]);
+            }
+        }
+    }
+
+    for (uint64_t level = 0; level < mLevelCount; ++level) {
+        delete[] levels[level];
+    }
+
+    delete[] allocated;
+
+    return success;
+}
+
+/**
+ * @brief                   Returns an iterator to the first key of the dense array
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::begin () const
+{
+    return iterator {mKeys};
+}
+
+/**
+ * @brief                   Returns an iterator to the logical key after the last key
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::end () const
+{
+    return iterator {mKeys + mKeyCount};
+}
+
+/**
+ * @brief                   Construct a new iterator object
+ *
+ * @param pPtr              Pointer to the key in the dense array
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator::iterator (ptr_t pPtr) : mPtr {pPtr}
+{
+}
+
+/**
+ * @brief                   Prefix increment operator (moves the iterator to the next key and returns it)
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator::operator++ ()
+{
+    ++mPtr;
+    return *this;
+}
+
+/**
+ * @brief                   Suffix increment operator (moves the iterator to the next key and returns a copy of the old one)
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator::operator++ (int)
+{
+    iterator    res {mPtr};
+
+    ++mPtr;
+
+    return res;
+}
+
+/**
+ * @brief                   Dereferences and returns the key pointed to
+ *
+ * @return ref_t
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+typename AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator::ref_t
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator::operator* () const
+{
+    return *mPtr;
+}
+
+/**
+ * @brief                   Checks if two iterators point to the same key
+ *
+ * @param pOther            Iterator to compare to
+ *
+ * @return true             If both iterators point to the same key
+ * @return false            If both iterators point to different keys
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator::operator== (const iterator &pOther) const
+{
+    return mPtr == pOther.mPtr;
+}
+
+/**
+ * @brief                   Checks if two iterators point to different keys
+ *
+ * @param pOther            Iterator to compare to
+ *
+ * @return true             If both iterators point to different keys
+ * @return false            If both iterators point to the same key
+ */
+template <typename key_t, auto tHashFunc, auto tEquals>
+bool
+AgFrozenHashTable<key_t, tHashFunc, tEquals>::iterator::operator!= (const iterator &pOther) const
+{
+    return mPtr != pOther.mPtr;
+}
+
+#endif          // Header Guard
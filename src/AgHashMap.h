@@ -0,0 +1,401 @@
+/**
+ * @file            AgHashMap.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           AgHashMap class
+ *
+ */
+
+#ifndef AG_HASH_MAP_GUARD_H
+
+#define     AG_HASH_MAP_GUARD_H
+
+#include <new>
+#include <utility>
+
+#include <type_traits>
+
+#include "AgHashTable.h"
+
+/**
+ * @brief                   Entry stored by AgHashMap, holding a key and its value next to each other inside the table's node
+ *
+ * @tparam key_t            Type of key
+ * @tparam value_t          Type of value
+ */
+template <typename key_t, typename value_t>
+struct AgHashMapEntry {
+
+    key_t               key;                                        /** Key of the entry */
+    value_t             value;                                      /** Value mapped to the key */
+};
+
+/**
+ * @brief                   Hashes an entry of AgHashMap by hashing only its key
+ *
+ * @tparam key_t            Type of key
+ * @tparam value_t          Type of value
+ * @tparam tHashFunc        Hash function to use on the key
+ *
+ * @param pEntry            Pointer to the entry
+ *
+ * @return hash_t           Hash of the entry's key (with the bucket mapping of tHashFunc applied, see ag_map_hash ())
+ */
+template <typename key_t, typename value_t, auto tHashFunc>
+static typename std::invoke_result<decltype (tHashFunc), const key_t *>::type
+ag_hashmap_entry_hash (const AgHashMapEntry<key_t, value_t> *pEntry)
+{
+    return ag_bucket_hash<key_t, tHashFunc> (&(pEntry->key));
+}
+
+/**
+ * @brief                   Compares two entries of AgHashMap by comparing only their keys
+ *
+ * @tparam key_t            Type of key
+ * @tparam value_t          Type of value
+ * @tparam tEquals          Comparator to use on the keys
+ *
+ * @param pA                First operand
+ * @param pB                Second operand
+ *
+ * @return true             If the keys of both entries are equal
+ * @return false            If the keys of both entries are not equal
+ */
+template <typename key_t, typename value_t, auto tEquals>
+static bool
+ag_hashmap_entry_equals (const AgHashMapEntry<key_t, value_t> &pA, const AgHashMapEntry<key_t, value_t> &pB)
+{
+    return tEquals (pA.key, pB.key);
+}
+
+/**
+ * @brief                   AgHashMap is a hash table which maps keys to values, built on the chained layout of AgHashTable
+ *
+ *                          Each value is stored inline next to its key in the table's node, and nodes are never moved by resizing,
+ *                          so references to values stay valid until their key is erased
+ *                          Every lookup or modification hashes the key and walks its bucket exactly once, so read-modify-write
+ *                          workloads (such as counting) do not need a find followed by an insert
+ *
+ * @tparam key_t            Type of keys held by the map
+ * @tparam value_t          Type of values mapped to the keys
+ * @tparam tHashFunc        Hash function to use on keys (defaults to Fibonacci hashing for integers and FNV-1a otherwise, see ag_default_hash ())
+ * @tparam tEquals          Comparator to use while making equals comparisons between keys (defaults to operator==)
+ * @tparam tAlloc           Allocator policy used for nodes and aggregate nodes (defaults to AgHeapAllocator, see AgHashTableAllocators.h)
+ *
+ * @note                    If AG_HASH_TABLE_MULTITHREADED_MODE is defined, the values passed to try_emplace, insert_or_assign and
+ *                          update are written while the key's bucket is locked, so concurrent updates to the same key are never lost
+ *                          References returned by operator[] are not synchronized
+ */
+template <typename key_t, typename value_t, auto tHashFunc = ag_default_hash<key_t, size_t> (), auto tEquals = ag_hashtable_default_equals<key_t>, typename tAlloc = AgHeapAllocator>
+class AgHashMap : public AgHashTable<AgHashMapEntry<key_t, value_t>,
+                                     ag_hashmap_entry_hash<key_t, value_t, tHashFunc>,
+                                     ag_hashmap_entry_equals<key_t, value_t, tEquals>,
+                                     AgChainedLayout,
+                                     tAlloc> {
+
+
+
+    protected:
+
+
+
+    using       entry_t         = AgHashMapEntry<key_t, value_t>;                       /** Type of entries stored in the table */
+    using       base_t          = AgHashTable<entry_t,
+                                              ag_hashmap_entry_hash<key_t, value_t, tHashFunc>,
+                                              ag_hashmap_entry_equals<key_t, value_t, tEquals>,
+                                              AgChainedLayout,
+                                              tAlloc>;                                  /** Table which stores the entries */
+
+    explicit AgHashMap (typename base_t::unallocated_t);
+
+
+
+    public:
+
+
+
+    using       iterator        = typename base_t::iterator;                            /** Iterator over the entries of the map (dereferences to a const entry_t) */
+
+    //  Constructors
+
+    AgHashMap       ();
+    AgHashMap       (const uint64_t &pBucketCount);
+    AgHashMap       (const AgHashMap &pOther) = delete;
+    AgHashMap       (AgHashMap &&pOther) noexcept;
+
+    //  Assignment
+
+    AgHashMap           &operator=              (const AgHashMap &pOther) = delete;
+    AgHashMap           &operator=              (AgHashMap &&pOther) noexcept;
+
+    //  Lookup
+
+    iterator            find                    (const key_t &pKey) const;
+    bool                exists                  (const key_t &pKey) const;
+
+    value_t             &operator[]             (const key_t &pKey);
+
+    //  Modifiers
+
+    bool                insert                  (const key_t &pKey, const value_t &pValue);
+
+    template <typename... args_t>
+    bool                try_emplace             (const key_t &pKey, args_t &&...pArgs);
+    template <typename arg_t>
+    bool                insert_or_assign        (const key_t &pKey, arg_t &&pValue);
+    template <typename func_t>
+    bool                update                  (const key_t &pKey, func_t pFunc);
+
+    bool                erase                   (const key_t &pKey);
+
+    AgHashMap           clone                   () const;
+};
+
+/**
+ * @brief                   Construct a new AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::AgHashMap object
+ *
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::AgHashMap () :
+    base_t {}
+{
+}
+
+/**
+ * @brief                   Construct a new AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::AgHashMap object
+ *
+ * @param pBucketCount      Number of buckets to initialize the map with
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::AgHashMap (const uint64_t &pBucketCount) :
+    base_t {pBucketCount}
+{
+}
+
+/**
+ * @brief                   Construct a new AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::AgHashMap object without any buckets,
+ *                          to be filled in by copy_from ()
+ *
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::AgHashMap (typename base_t::unallocated_t) :
+    base_t {typename base_t::unallocated_t {}}
+{
+}
+
+/**
+ * @brief                   Construct a new AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::AgHashMap object by taking over
+ *                          the entries of another map (see the move constructor of AgHashTable)
+ *
+ * @param pOther            Map to move from
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::AgHashMap (AgHashMap &&pOther) noexcept :
+    base_t {std::move (pOther)}
+{
+}
+
+/**
+ * @brief                   Takes over the entries of another map, handing the present ones to it
+ *
+ * @param pOther            Map to move from
+ *
+ * @return AgHashMap&       Reference to this map
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc> &
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::operator= (AgHashMap &&pOther) noexcept
+{
+    base_t::swap (pOther);
+    return *this;
+}
+
+/**
+ * @brief                   Searches for a given key in the map and returns an iterator to its entry (returns end() if the key is not found)
+ *
+ * @param pKey              Key to search for
+ *
+ * @return iterator         Iterator to the entry of the key (end() if the key is not found)
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+typename AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::iterator
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::find (const key_t &pKey) const
+{
+    return this->find_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey), [&pKey] (const entry_t &pEntry) { return tEquals (pKey, pEntry.key); });
+}
+
+/**
+ * @brief                   Returns if a given key exists in the map
+ *
+ * @param pKey              Key to search for
+ *
+ * @return true             If the key exists in the map
+ * @return false            If the key does not exist in the map
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::exists (const key_t &pKey) const
+{
+    return find (pKey) != this->end ();
+}
+
+/**
+ * @brief                   Returns a reference to the value mapped to a given key, inserting a value initialized value if the key does not exist
+ *
+ *                          Throws std::bad_alloc if the key does not exist and could not be inserted, since there is no value to refer to
+ *
+ * @param pKey              Key whose value is to be returned
+ *
+ * @return value_t&         Reference to the value mapped to the key
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+value_t &
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::operator[] (const key_t &pKey)
+{
+    value_t             *res    {nullptr};                          /** Pointer to the value mapped to the key */
+
+    this->emplace_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey),
+                            [&pKey] (const entry_t &pEntry) { return tEquals (pKey, pEntry.key); },
+                            [&pKey] () { return entry_t {pKey, value_t ()}; },
+                            [&res] (entry_t &pEntry, const bool &pInserted) { (void)pInserted; res = &(pEntry.value); });
+
+    if (res == nullptr) {
+        throw std::bad_alloc ();
+    }
+
+    return *res;
+}
+
+/**
+ * @brief                   Attempts to insert a new key with the given value into the map (the value of an existing key is not modified)
+ *
+ * @param pKey              Key to insert
+ * @param pValue            Value to map to the key
+ *
+ * @return true             If the key could successfully be inserted
+ * @return false            If the key could not be inserted (key already exists or allocation failure)
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::insert (const key_t &pKey, const value_t &pValue)
+{
+    return try_emplace (pKey, pValue);
+}
+
+/**
+ * @brief                   Attempts to insert a new key into the map, constructing its value in place from the given arguments
+ *
+ *                          If the key already exists, nothing is constructed and the arguments are left untouched
+ *
+ * @tparam args_t           Types of arguments to construct the value from
+ *
+ * @param pKey              Key to insert
+ * @param pArgs             Arguments to construct the value from
+ *
+ * @return true             If the key could successfully be inserted
+ * @return false            If the key could not be inserted (key already exists or allocation failure)
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+template <typename... args_t>
+bool
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::try_emplace (const key_t &pKey, args_t &&...pArgs)
+{
+    return this->emplace_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey),
+                                   [&pKey] (const entry_t &pEntry) { return tEquals (pKey, pEntry.key); },
+                                   [&] () { return entry_t {pKey, value_t (std::forward<args_t> (pArgs)...)}; },
+                                   [] (entry_t &pEntry, const bool &pInserted) { (void)pEntry; (void)pInserted; });
+}
+
+/**
+ * @brief                   Inserts a new key with the given value into the map, or assigns the value to the key if it already exists
+ *
+ * @tparam arg_t            Type of value to insert or assign
+ *
+ * @param pKey              Key to insert or assign to
+ * @param pValue            Value to map to the key
+ *
+ * @return true             If the key was inserted
+ * @return false            If the key already existed and was assigned the value (or the key could not be inserted due to allocation failure)
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+template <typename arg_t>
+bool
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::insert_or_assign (const key_t &pKey, arg_t &&pValue)
+{
+    // only one of the two functions is called, so the value is forwarded at most once
+    return this->emplace_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey),
+                                   [&pKey] (const entry_t &pEntry) { return tEquals (pKey, pEntry.key); },
+                                   [&pKey, &pValue] () { return entry_t {pKey, value_t (std::forward<arg_t> (pValue))}; },
+                                   [&pValue] (entry_t &pEntry, const bool &pInserted) {
+                                       if (!pInserted) {
+                                           pEntry.value = std::forward<arg_t> (pValue);
+                                       }
+                                   });
+}
+
+/**
+ * @brief                   Calls the given function on the value mapped to a given key, inserting a value initialized value first if the key does not exist
+ *
+ *                          The key is hashed and its bucket is searched only once, and in multithreaded mode the function is called
+ *                          while the key's bucket is locked
+ *
+ * @tparam func_t           Type of function (must accept a value_t & as its only parameter)
+ *
+ * @param pKey              Key whose value is to be updated
+ * @param pFunc             Function which modifies the value in place
+ *
+ * @return true             If the value was updated
+ * @return false            If the key did not exist and could not be inserted (allocation failure)
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+template <typename func_t>
+bool
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::update (const key_t &pKey, func_t pFunc)
+{
+    bool                updated     {false};                        /** Stores if the function was called */
+
+    this->emplace_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey),
+                            [&pKey] (const entry_t &pEntry) { return tEquals (pKey, pEntry.key); },
+                            [&pKey] () { return entry_t {pKey, value_t ()}; },
+                            [&pFunc, &updated] (entry_t &pEntry, const bool &pInserted) {
+                                (void)pInserted;
+                                pFunc (pEntry.value);
+                                updated = true;
+                            });
+
+    return updated;
+}
+
+/**
+ * @brief                   Attempts to erase a given key (and its value) from the map
+ *
+ * @param pKey              Key to erase
+ *
+ * @return true             If the key was successfully found and removed
+ * @return false            If the key could not be removed (no matching key was found)
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::erase (const key_t &pKey)
+{
+    return this->erase_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey), [&pKey] (const entry_t &pEntry) { return tEquals (pKey, pEntry.key); });
+}
+
+/**
+ * @brief                   Returns a copy of the map, made in the same way as AgHashTable::copy_from () (every entry is copied
+ *                          without hashing or comparing its key)
+ *
+ * @return AgHashMap        Copy of the map (initialized () returns false for it if the copy could not be made)
+ */
+template <typename key_t, typename value_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>
+AgHashMap<key_t, value_t, tHashFunc, tEquals, tAlloc>::clone () const
+{
+    AgHashMap           copy        {typename base_t::unallocated_t {}};    /** Map holding the copy (its buckets are allocated by copy_from ()) */
+
+    copy.copy_from (*this);
+
+    return copy;
+}
+
+#endif          // Header Guard
@@ -23,18 +23,29 @@
 
 #ifdef AG_HASH_TABLE_MULTITHREADED_MODE
 #define     MULTITHREADED_MODE(...)                 __VA_ARGS__
+#define     NO_MULTITHREADED_MODE(...)
 #else
 #define     MULTITHREADED_MODE(...)
+#define     NO_MULTITHREADED_MODE(...)              __VA_ARGS__
 #endif
 
 #include <mutex>
 #include <shared_mutex>
 #include <atomic>
+#include <thread>
+#include <system_error>
 
 #include <type_traits>
 #include <limits>
+#include <utility>
+
+#if defined (_MSC_VER)
+#include <intrin.h>
+#endif
 
 #include "AgHashFunctions.hpp"
+#include "AgHashTablePolicies.hpp"
+#include "AgHashTableAllocators.h"
 
 /**
  * @brief                   Default equals comparator to be used by AgHashTable for checking equivalance of keys
@@ -64,13 +75,241 @@ ag_hashtable_default_equals (const val_t &pA, const val_t &pB)
 }
 
 /**
- * @brief                   AgAVLTree is an implementation of the AVL tree data structure (a type of self balanced binary search tree)
+ * @brief                   Equals comparator between strings of different types, which compares their characters
+ *
+ *                          Used by AgHashTable for lookups with a type other than key_t (see find ())
+ *
+ * @tparam probe_t          Type of string being searched for (C-style string, std::string or std::string_view)
+ * @tparam key_t            Type of string stored in the table (C-style string, std::string or std::string_view)
+ *
+ * @param pA                String being searched for
+ * @param pB                String stored in the table
+ *
+ * @return true             If both strings have the same characters
+ * @return false            If the strings have different characters
+ */
+template <typename probe_t, typename key_t>
+static bool
+ag_hashtable_str_equals (const probe_t &pA, const key_t &pB)
+{
+    return ag_string_view (pA) == ag_string_view (pB);
+}
+
+/**
+ * @brief                   Returns if two template arguments refer to the same function (false if they do not even have the same type)
+ *
+ * @tparam tA               First function
+ * @tparam tB               Second function
+ *
+ * @return true             If both arguments refer to the same function
+ * @return false            If the arguments refer to different functions
+ */
+template <auto tA, auto tB>
+struct ag_same_function_t : std::false_type {};
+
+template <auto tA>
+struct ag_same_function_t<tA, tA> : std::true_type {};
+
+template <auto tA, auto tB>
+static constexpr bool
+ag_same_function ()
+{
+    // template arguments are matched by identity, which (unlike comparing the pointers) is a constant expression even for
+    // different functions when building with sanitizers
+    return ag_same_function_t<tA, tB>::value;
+}
+
+/**
+ * @brief                   Describes the fingerprints stored in the nodes of a chained layout (none, unless the layout is AgChainedFingerprintLayout)
+ *
+ * @tparam tLayout          Storage layout
+ * @tparam key_t            Type of key
+ */
+template <typename tLayout, typename key_t>
+struct ag_chained_fingerprint {
+
+    static constexpr bool       sEnabled            = false;                /** If nodes store fingerprints */
+
+    using       fingerprint_t   = uint8_t;                                  /** Placeholder type (never stored) */
+};
+
+template <auto tFingerprintFunc, typename key_t>
+struct ag_chained_fingerprint<AgChainedFingerprintLayout<tFingerprintFunc>, key_t> {
+
+    static constexpr bool       sEnabled            = true;                 /** If nodes store fingerprints */
+
+    using       fingerprint_t   = typename std::invoke_result<decltype (tFingerprintFunc), const key_t *>::type;   /** Type of fingerprint */
+};
+
+/**
+ * @brief                   Applies the bucket mapping of a hash function to a hash it returned
+ *
+ *                          Buckets (and fingerprints, and the order of splitting buckets while resizing) are selected using the low
+ *                          bits of the hash, which only depend on the low bits of the key for multiplicative hashes such as
+ *                          ag_fibonacci_hash, so the bytes of their hash are reversed to select buckets using its high bits instead
+ *                          Every other hash is used as is
+ *
+ * @tparam key_t            Type of key
+ * @tparam tHashFunc        Hash function which returned the hash
+ * @tparam hash_t           Type of hash
+ *
+ * @param pKeyHash          Hash returned by tHashFunc
+ *
+ * @return hash_t           Hash used to select buckets
+ */
+template <typename key_t, auto tHashFunc, typename hash_t>
+static inline hash_t
+ag_map_hash (const hash_t &pKeyHash)
+{
+    if constexpr (std::is_integral<key_t>::value && (sizeof (key_t) <= sizeof (uint64_t))) {
+        if constexpr (ag_same_function<tHashFunc, ag_fibonacci_hash<key_t, hash_t>> ()) {
+            return ag_byteswap (pKeyHash);
+        }
+        else {
+            return pKeyHash;
+        }
+    }
+    else {
+        return pKeyHash;
+    }
+}
+
+/**
+ * @brief                   Hashes a key with tHashFunc and applies its bucket mapping (see ag_map_hash ())
+ *
+ * @tparam key_t            Type of key
+ * @tparam tHashFunc        Hash function
+ *
+ * @param pKey              Pointer to the key
+ *
+ * @return auto             Hash used to select buckets
+ */
+template <typename key_t, auto tHashFunc>
+static inline auto
+ag_bucket_hash (const key_t *pKey)
+{
+    return ag_map_hash<key_t, tHashFunc> (tHashFunc (pKey));
+}
+
+/**
+ * @brief                   Hashes every key of an array with tHashFunc and applies its bucket mapping (see ag_map_hash ())
+ *
+ *                          ag_fibonacci_hash and ag_murmur_hash hash several keys at a time when SIMD instructions are available (see
+ *                          ag_fibonacci_hash_keys ()), while every other hash function is called once per key
+ *
+ * @tparam key_t            Type of key
+ * @tparam tHashFunc        Hash function
+ * @tparam hash_t           Type of hash
+ *
+ * @param pKeys             Pointer to the array of keys
+ * @param pCount            Number of keys in the array
+ * @param pHashes           Pointer to the array (of atleast pCount hashes) to write the hashes used to select buckets into
+ */
+template <typename key_t, auto tHashFunc, typename hash_t>
+static inline void
+ag_bucket_hash_keys (const key_t *pKeys, const uint64_t &pCount, hash_t *pHashes)
+{
+    if constexpr (std::is_integral<key_t>::value && (sizeof (key_t) <= sizeof (uint64_t))) {
+        if constexpr (ag_same_function<tHashFunc, ag_fibonacci_hash<key_t, hash_t>> ()) {
+            ag_fibonacci_hash_keys<key_t, hash_t> (pKeys, pCount, pHashes);
+            for (uint64_t keyId = 0; keyId < pCount; ++keyId) {
+                pHashes[keyId]  = ag_byteswap (pHashes[keyId]);
+            }
+            return;
+        }
+        else if constexpr (ag_same_function<tHashFunc, ag_murmur_hash<key_t, hash_t>> ()) {
+            ag_murmur_hash_keys<key_t, hash_t> (pKeys, pCount, pHashes);
+            return;
+        }
+    }
+
+    for (uint64_t keyId = 0; keyId < pCount; ++keyId) {
+        pHashes[keyId]  = ag_bucket_hash<key_t, tHashFunc> (pKeys + keyId);
+    }
+}
+
+/**
+ * @brief                   Returns the hash function used by default for strings of type probe_t, which is the string counterpart of
+ *                          tHashFunc (ag_wyhash_str if the stored keys are hashed with ag_wyhash_str, and ag_fnv1a_str otherwise)
+ *
+ * @tparam probe_t          Type of the key being searched for
+ * @tparam key_t            Type of the keys stored in the table
+ * @tparam hash_t           Type of hash returned by tHashFunc
+ * @tparam tHashFunc        Hash function of the stored keys
+ *
+ * @return auto             Pointer to the hash function for probe_t
+ */
+template <typename probe_t, typename key_t, typename hash_t, auto tHashFunc>
+static constexpr auto
+ag_default_probe_hash ()
+{
+    if constexpr (std::is_convertible<const key_t &, std::string_view>::value) {
+        if constexpr (ag_same_function<tHashFunc, ag_wyhash_str<key_t, hash_t>> ()) {
+            return ag_wyhash_str<probe_t, hash_t>;
+        }
+        else {
+            return ag_fnv1a_str<probe_t, hash_t>;
+        }
+    }
+    else {
+        return ag_fnv1a_str<probe_t, hash_t>;
+    }
+}
+
+/**
+ * @brief                   Hints the processor to start loading the cache line which holds the given address (does nothing if not supported)
+ *
+ * @param pPtr              Address to load (may be invalid, since it is never dereferenced)
+ */
+static inline void
+ag_prefetch (const void *pPtr)
+{
+#if defined (__GNUC__) || defined (__clang__)
+    __builtin_prefetch (pPtr);
+#elif defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+    _mm_prefetch ((const char *)pPtr, _MM_HINT_T0);
+#else
+    (void)pPtr;
+#endif
+}
+
+/**
+ * @brief                   AgHashTable is an implementation of the hash table data structure
+ *
+ *                          The primary template implements the chained layout (AgChainedLayout), other layouts are implemented
+ *                          as partial specializations of this template
  *
  * @tparam key_t            Type of keys held by the hash table
- * @tparam tHashFunc        Hash function to use (defaults to 16 bit pearson hash)
+ * @tparam tHashFunc        Hash function to use (defaults to Fibonacci hashing for integers and FNV-1a otherwise, see ag_default_hash ())
  * @tparam tEquals          Comparator to use while making equals comparisons (defaults to operator==)
+ * @tparam tLayout          Storage layout to use (defaults to AgChainedLayout, see AgChainedFingerprintLayout to store fingerprints in nodes)
+ * @tparam tAlloc           Allocator policy used for nodes and aggregate nodes (defaults to AgHeapAllocator, see AgHashTableAllocators.h)
+ *
+ * @note                    By default, growing the table rehashes every bucket inside the insertion which triggered it, while in
+ *                          incremental mode (see set_incremental_resize ()) both bucket arrays are kept alive and every modification
+ *                          migrates a bounded number of buckets, so that no single operation has to rehash the whole table
+ *                          Growing large tables at once can instead be split across several threads (see set_rehash_threads ())
+ *
+ * @note                    find (), exists () and erase () also accept keys of a different type (probe_t) which can not be converted to
+ *                          key_t, such as a std::string_view slice of a buffer, given a hash function and comparator for probe_t which
+ *                          agree with tHashFunc and tEquals
+ *                          For string keys hashed with ag_fnv1a_str or ag_wyhash_str, the defaults (the same hash function for probe_t
+ *                          and ag_hashtable_str_equals) can be used to search with any other string type without copying the slice
+ *                          into a temporary key
+ *
+ * @note                    The batched operations (exists_batch, find_batch, insert_batch and insert_range) hash a group of keys first
+ *                          and prefetch their buckets and aggregate nodes before resolving any of them, so that the cache misses of
+ *                          different keys overlap instead of being paid one after another
+ *                          Integer keys hashed with ag_fibonacci_hash or ag_murmur_hash are hashed several at a time using SIMD
+ *                          instructions when available (see ag_bucket_hash_keys ())
+ *
+ * @note                    If AG_HASH_TABLE_MULTITHREADED_MODE is defined, insert, erase, exists and find may be called concurrently
+ *                          Buckets are guarded by a fixed number of reader/writer locks (lock striping), where lookups take a
+ *                          shared lock and modifications take an exclusive lock, while resizing takes every lock in order
+ *                          The batched operations handle one key at a time in this mode (a bucket can not be read without its lock)
+ *                          Iterators and the other getters are not synchronized
  */
-template <typename key_t, auto tHashFunc = ag_fnv1a<key_t, size_t>, auto tEquals = ag_hashtable_default_equals<key_t>>
+template <typename key_t, auto tHashFunc = ag_default_hash<key_t, size_t> (), auto tEquals = ag_hashtable_default_equals<key_t>, typename tLayout = AgChainedLayout, typename tAlloc = AgHeapAllocator>
 class AgHashTable {
 
 
@@ -81,20 +320,37 @@ class AgHashTable {
 
     using       hash_t          = typename std::invoke_result<decltype (tHashFunc), const key_t *>::type;     /** Data type returned by the hash function (must be unsigned integral type */
 
+    static constexpr bool       sFingerprinted          = ag_chained_fingerprint<tLayout, key_t>::sEnabled;     /** If nodes store fingerprints of their keys */
+
+    using       fingerprint_t   = typename ag_chained_fingerprint<tLayout, key_t>::fingerprint_t;             /** Type of fingerprint stored in nodes */
+
     static_assert (std::is_unsigned<hash_t>::value, "Return type of hash functions must be unsigned integer");
+    static_assert (std::is_unsigned<fingerprint_t>::value, "Return type of fingerprint functions must be unsigned integer");
+    static_assert (std::is_same<tLayout, AgChainedLayout>::value || sFingerprinted, "Unknown storage layout");
 
     /**
      * @brief               Generic node in linked list which stores a key
      *
      */
-    struct node_t {
+    struct plain_node_t {
 
-        node_t              *nextPtr;                               /** Pointer to the next node in the linked list */
+        plain_node_t        *nextPtr;                               /** Pointer to the next node in the linked list */
         key_t               key;                                    /** Key held by the node */
+    };
 
-        ~node_t () { delete nextPtr; }                              /** The destructor recursively destroys all nodes in the linked list */
+    /**
+     * @brief               Node in linked list which stores a key along with its fingerprint (used with AgChainedFingerprintLayout)
+     *
+     */
+    struct fingerprint_node_t {
+
+        fingerprint_node_t  *nextPtr;                               /** Pointer to the next node in the linked list */
+        fingerprint_t       fingerprint;                            /** Fingerprint of the key (compared before the keys themselves) */
+        key_t               key;                                    /** Key held by the node */
     };
 
+    using       node_t          = typename std::conditional<sFingerprinted, fingerprint_node_t, plain_node_t>::type;
+
     /**
      * @brief               Aggregate node representing a collection (linked list) of nodes containing keys which all have the same hash
      *
@@ -105,18 +361,24 @@ class AgHashTable {
         uint64_t            keyCount;                               /** Number of nodes (which contain keys) in the aggregate node's linked list (all have the same hash) */
         hash_t              keyHash;                                /** Common hash value of the keys which the aggregate node represents */
         node_t              *nodePtr;                               /** Pointer to the linked list of nodes which this aggregate node respresents */
-
-        ~aggregate_node_t () { delete nextPtr; delete nodePtr; }
     };
 
     /**
      * @brief               Bucket in the hash table, representing a collection of keys whose hash's have the same value modulo the number of buckets
      *
+     *                      The hash and the node list of the first aggregate node are kept inline (see sync_head ()), so a lookup whose
+     *                      hash is the first one in its bucket goes straight from the bucket to the keys, and a lookup in a bucket with
+     *                      a single hash can be rejected from the bucket alone
+     *                      The bucket is aligned to 32 bytes, so two fit in a cache line and none is split across two of them, which
+     *                      is why its counters are 32 bit (a bucket never holds more than sMaxBucketKeys keys)
+     *
      */
-    struct bucket_t {
+    struct alignas (32) bucket_t {
 
-        uint64_t            keyCount            {0ULL};             /** Number of keys in the bucket */
-        uint64_t            distinctHashCount   {0ULL};             /** Number of distinct hashs in this bucket (= number of aggregate nodes in the bucket) */
+        uint32_t            keyCount            {0U};               /** Number of keys in the bucket */
+        uint32_t            distinctHashCount   {0U};               /** Number of distinct hashs in this bucket (= number of aggregate nodes in the bucket) */
+        hash_t              headHash            {};                 /** Common hash value of the keys of the first aggregate node (only valid if hashListHead is not nullptr) */
+        node_t              *headNode           {nullptr};          /** Pointer to the linked list of nodes of the first aggregate node */
         aggregate_node_t    *hashListHead       {nullptr};          /** Pointer to the linked list of aggregate nodes */
     };
 
@@ -125,16 +387,34 @@ class AgHashTable {
     using       aggr_ptr_t      = aggregate_node_t *;                                   /** Helper alias for pointers to linked list of aggregate nodes */
     using       bucket_ptr_t    = bucket_t *;                                           /** Helper alias for pointers to buckets/arrays of buckets */
 
+    using       node_pool_t     = typename tAlloc::template pool_t<node_t>;             /** Pool from which nodes are allocated */
+    using       aggr_pool_t     = typename tAlloc::template pool_t<aggregate_node_t>;   /** Pool from which aggregate nodes are allocated */
 
-    static constexpr uint64_t   sHashBitness            = sizeof (hash_t) * 8ULL;       /** Bitness of the return type of the hash function */
-    static constexpr uint64_t   sNumDistinctAllowed     = 1ULL;                         /** Number of distinct hashs allowed per bucket before resizing is considered */
-    static constexpr uint64_t   sNumKeysAllowed         = 16ULL;                        /** Number of keys allowed in a bucket before resizing is considered */
-    static constexpr uint64_t   sResizeFactor           = 8ULL;                         /** Factor by which the size of the hash table grows */
+    MULTITHREADED_MODE (
+    using       counter_t       = std::atomic<uint64_t>;                                /** Counters shared by all buckets are updated while holding different locks */
+    )
+    NO_MULTITHREADED_MODE (
+    using       counter_t       = uint64_t;                                             /** Counters shared by all buckets */
+    )
 
-    static constexpr uint64_t   sMaxBucketsAllowed      = 1ULL << ((sHashBitness > 24)? /** Maxmimum number of buckets allowed in the hash table */
-                                                                    (24)
+
+    static constexpr uint64_t   sHashBitness            = sizeof (hash_t) * 8ULL;       /** Bitness of the return type of the hash function */
+    static constexpr uint64_t   sMaxBucketsAllowed      = 1ULL << ((sHashBitness > 48)? /** Maxmimum number of buckets allowed in the hash table by any growth policy */
+                                                                    (48)
                                                                     : (sHashBitness));
 
+    static constexpr uint64_t   sMaxBucketKeys          = std::numeric_limits<uint32_t>::max ();   /** Maximum number of keys in a bucket (its counters are 32 bit, see bucket_t) */
+    static constexpr uint64_t   sMigrateStep            = 8ULL;                         /** Number of old buckets migrated by every modification during an incremental resize */
+    static constexpr uint64_t   sResizePrefetchDistance = 8ULL;                         /** Number of buckets ahead whose first aggregate node is prefetched while resizing */
+    static constexpr uint64_t   sMaxRehashThreads       = 256ULL;                       /** Maximum number of threads a resize can be split across */
+    static constexpr uint64_t   sMinBucketsPerThread    = 1ULL << 14;                   /** Minimum number of old buckets moved by each thread of a parallel resize */
+    static constexpr uint64_t   sBatchWidth             = 32ULL;                        /** Number of keys in each group handled by the batched operations */
+    static constexpr uint64_t   sBatchStages            = 4ULL;                         /** Number of groups in flight in the batched lookups (one per stage of a lookup) */
+
+    MULTITHREADED_MODE (
+    static constexpr uint64_t   sMaxLockCount           = 1024ULL;                      /** Maximum number of locks the buckets are striped across */
+    )
+
 
 
     public:
@@ -145,16 +425,17 @@ class AgHashTable {
 
         protected:
 
-        using table_ptr_t       = const AgHashTable<key_t, tHashFunc, tEquals> *;
+        using table_ptr_t       = const AgHashTable *;
         using ref_t             = const key_t &;
 
         node_ptr_t  mPtr        {nullptr};                                  /** Pointer to table node (nullptr if points to end()) */
         aggr_ptr_t  mAggrPtr    {nullptr};                                  /** Pointer to the aggregate node (nullptri f points to end() */
+        uint64_t    mBucketId   {0ULL};                                     /** Position of the bucket which contains the aggregate node */
         table_ptr_t mTablePtr   {nullptr};                                  /** Pointer to table instance */
 
         public:
 
-        iterator                (node_ptr_t pPtr, aggr_ptr_t pAggrPtr, table_ptr_t pTablePtr);
+        iterator                (node_ptr_t pPtr, aggr_ptr_t pAggrPtr, uint64_t pBucketId, table_ptr_t pTablePtr);
         iterator                () = default;
 
         iterator operator++     ();
@@ -171,12 +452,18 @@ class AgHashTable {
 
     AgHashTable     ();
     AgHashTable     (const uint64_t &pBucketCount);
-    AgHashTable     (const AgHashTable<key_t, tHashFunc, tEquals> &pOther) = delete;
+    AgHashTable     (const AgHashTable &pOther) = delete;
+    AgHashTable     (AgHashTable &&pOther) noexcept;
 
     //  Destructors
 
     ~AgHashTable    ();
 
+    //  Assignment
+
+    AgHashTable         &operator=              (const AgHashTable &pOther) = delete;
+    AgHashTable         &operator=              (AgHashTable &&pOther) noexcept;
+
     //  Getters
 
     bool                initialized             () const;
@@ -191,6 +478,21 @@ class AgHashTable {
     uint64_t            get_bucket_hash_count   (const uint64_t &pBucketId) const;
 
     uint64_t            get_bucket_of_key       (const key_t &pKey) const;
+
+    bool                get_incremental_resize  () const;
+    uint64_t            get_pending_bucket_count() const;
+
+    AgGrowthPolicy      get_growth_policy       () const;
+
+    uint64_t            get_rehash_threads      () const;
+    bool                get_parallel_growth     () const;
+
+    // Setters
+
+    bool                set_incremental_resize  (const bool &pIncremental);
+    bool                set_growth_policy       (const AgGrowthPolicy &pGrowth);
+    bool                set_rehash_threads      (const uint64_t &pThreadCount, const bool &pParallelGrowth = false);
+
     // Testing and debugging
 
     DBG_MODE (
@@ -201,16 +503,49 @@ class AgHashTable {
     uint64_t            get_resize_count        () const;
 
     uint64_t            get_aggregate_count     () const;
+
+    uint64_t            get_pool_alloc_count    () const;
+    uint64_t            get_pool_reserved_amount() const;
+    uint64_t            get_pool_free_count     () const;
     )
 
     iterator            find                    (const key_t &pKey) const;
     bool                exists                  (const key_t &pkey) const;
 
+    template <typename probe_t, auto tProbeHash = ag_default_probe_hash<probe_t, key_t, hash_t, tHashFunc> (), auto tProbeEquals = ag_hashtable_str_equals<probe_t, key_t>,
+              typename = std::enable_if_t<!std::is_convertible<const probe_t &, key_t>::value>>
+    iterator            find                    (const probe_t &pProbe) const;
+    template <typename probe_t, auto tProbeHash = ag_default_probe_hash<probe_t, key_t, hash_t, tHashFunc> (), auto tProbeEquals = ag_hashtable_str_equals<probe_t, key_t>,
+              typename = std::enable_if_t<!std::is_convertible<const probe_t &, key_t>::value>>
+    bool                exists                  (const probe_t &pProbe) const;
+
+    uint64_t            find_batch              (const key_t *pKeys, const uint64_t &pCount, iterator *pResults) const;
+    uint64_t            exists_batch            (const key_t *pKeys, const uint64_t &pCount, bool *pResults) const;
+
     //  Modifiers
 
     bool                insert                  (const key_t &pKey);
     bool                erase                   (const key_t &pKey);
 
+    template <typename probe_t, auto tProbeHash = ag_default_probe_hash<probe_t, key_t, hash_t, tHashFunc> (), auto tProbeEquals = ag_hashtable_str_equals<probe_t, key_t>,
+              typename = std::enable_if_t<!std::is_convertible<const probe_t &, key_t>::value>>
+    bool                erase                   (const probe_t &pProbe);
+
+    uint64_t            insert_batch            (const key_t *pKeys, const uint64_t &pCount, bool *pResults = nullptr);
+
+    template <typename iter_t>
+    uint64_t            insert_range            (iter_t pFirst, iter_t pLast);
+
+    bool                reserve                 (const uint64_t &pKeyCount);
+    bool                rehash                  (const uint64_t &pBucketCount);
+    bool                shrink_to_fit           ();
+
+    void                clear                   ();
+
+    void                swap                    (AgHashTable &pOther) noexcept;
+    bool                copy_from               (const AgHashTable &pOther);
+    AgHashTable         clone                   () const;
+
     // Iterators and Iteration
 
     iterator            begin                   () const;
@@ -218,79 +553,214 @@ class AgHashTable {
 
 
 
+    protected:
+
+
+
+    // Construction of a table without any buckets, to be filled in by copy_from () (used by clone ())
+
+    struct unallocated_t {};                                                /** Selects the constructor which leaves a table without any buckets */
+
+    explicit AgHashTable (unallocated_t);
+
+    // Lookups and modifications in terms of a hash and a predicate on the stored keys (used by AgHashMap)
+
+    template <typename match_t>
+    iterator            find_matching           (const hash_t &pKeyHash, match_t pMatch, const key_t *pKey = nullptr) const;
+
+    template <typename match_t, typename make_t, typename visit_t>
+    bool                emplace_matching        (const hash_t &pKeyHash, match_t pMatch, make_t pMake, visit_t pVisit, const key_t *pKey = nullptr);
+    template <typename match_t>
+    bool                erase_matching          (const hash_t &pKeyHash, match_t pMatch, const key_t *pKey = nullptr);
+
+    void                release                 ();
+
+
+
     private:
 
 
 
     // Getters
 
-    iterator            find_util               (const key_t &pKey, aggr_ptr_t pAggrElem) const;
+    template <typename match_t>
+    iterator            find_util               (match_t &pMatch, node_ptr_t pListElem, aggr_ptr_t pAggrElem, const uint64_t &pBucketId, const key_t *pKey) const;
     bool                exists_util             (const key_t &pKey, node_ptr_t pListElem) const;
 
+    bool                fingerprint_list        (const key_t *pKey, node_ptr_t pListElem, fingerprint_t &pFingerprint) const;
+    static bool         fingerprint_differs     (node_ptr_t pNode, const bool &pFiltered, const fingerprint_t &pFingerprint);
+
     // Modifiers
 
     void                init                    ();
 
-    bool                insert_util             (const key_t &pKey, node_ptr_t *pListElem);
-    bool                erase_util              (const key_t &pKey, node_ptr_t *pListElem);
+    template <typename match_t, typename make_t>
+    node_ptr_t          insert_util             (match_t &pMatch, make_t &pMake, node_ptr_t *pListElem, bool &pInserted, const key_t *pKey);
+    template <typename match_t>
+    bool                erase_util              (match_t &pMatch, node_ptr_t *pListElem, const key_t *pKey);
+
+    bool                resize                  (const uint64_t &pNumBuckets, const uint64_t &pThreadCount = 1ULL);
+    void                move_buckets            (bucket_ptr_t pArray, const uint64_t &pCount, const uint64_t &pBegin, const uint64_t &pEnd);
+    static void         push_aggregate          (bucket_t &pBucket, aggr_ptr_t pAggrPtr);
+    static void         sync_head               (bucket_t &pBucket);
+    bool                should_grow             (const uint64_t &pBucketId) const;
+    void                grow                    (const uint64_t &pObservedCount);
+
+    static uint64_t     target_load             (const AgGrowthPolicy &pGrowth);
+    uint64_t            bucket_count_for        (const uint64_t &pKeyCount) const;
+    bool                should_shrink           () const;
+    void                shrink                  (const uint64_t &pObservedCount);
+    bool                rehash_util             (const uint64_t &pNumBuckets, const bool &pShrink);
+
+    bool                start_migration         (const uint64_t &pNumBuckets);
+    void                migrate                 (const uint64_t &pOldBucketId);
+    void                migrate_bucket          (const uint64_t &pOldBucketId);
+    void                finish_migration        ();
+
+    void                destroy_all             ();
+    void                destroy_buckets         (bucket_ptr_t pArray, const uint64_t &pCount);
+    void                destroy_keys            (bucket_ptr_t pArray, const uint64_t &pCount);
+    bool                copy_aggregates         (aggr_ptr_t pSource, bucket_ptr_t pArray, const uint64_t &pCount);
+
+    static void         swap_counter            (counter_t &pFirst, counter_t &pSecond) noexcept;
+
+    template <typename resolve_t>
+    void                lookup_batch            (const key_t *pKeys, const uint64_t &pCount, resolve_t pResolve) const;
+
+    void                prefetch_batch          (const key_t *pKeys, const uint64_t &pCount, hash_t *pHashes) const;
+    void                head_batch              (const hash_t *pHashes, const uint64_t &pCount, aggr_ptr_t *pAggrs, uint64_t *pBucketIds) const;
+    void                match_batch             (const hash_t *pHashes, const uint64_t &pCount, aggr_ptr_t *pAggrs) const;
 
-    bool                resize                  (const uint64_t &pNumBuckets);
+    uint64_t            locate                  (const hash_t &pKeyHash) const;
+    bucket_t            &bucket_at              (const uint64_t &pPos) const;
+
+    MULTITHREADED_MODE (
+    uint64_t            get_lock_id             (const hash_t &pKeyHash) const;
+
+    void                lock_all                ();
+    void                unlock_all              ();
+    )
 
     // Iterators
 
-    aggr_ptr_t  getHashAggr                     (const hash_t &pKeyHash) const;
+    iterator            first_from_bucket       (uint64_t pBucketId) const;
 
 
     bucket_ptr_t        mBucketArray;                                       /** Pointer to array of buckets, each containing a linked list of aggregate nodes */
 
+    node_pool_t         mNodePool;                                          /** Pool from which nodes are allocated */
+    aggr_pool_t         mAggrPool;                                          /** Pool from which aggregate nodes are allocated */
+
     MULTITHREADED_MODE (
-    std::shared_mutex   *mLocks;                                            /** Pointer to array of locks */
+    std::shared_mutex   *mLocks;                                            /** Pointer to array of locks (bucket i is guarded by lock i modulo the number of locks) */
+    uint64_t            mLockCount      {0ULL};                             /** Number of locks (never more than the number of buckets) */
     )
 
-    uint64_t            mKeyCount       {0ULL};                             /** Number of keys in the table */
+    counter_t           mKeyCount       {0ULL};                             /** Number of keys in the table */
     uint64_t            mBucketCount    {64ULL};                            /** Number of buckets in the table */
 
+    AgGrowthPolicy      mGrowth         {AgGrowthPolicy::balanced ()};      /** Decides when the table grows and by how much */
+
+    uint64_t            mRehashThreads  {1ULL};                             /** Number of threads rehash () and reserve () split growing the table across */
+    bool                mParallelGrowth {false};                            /** If growth triggered by insertions is split across the same number of threads */
+
+    bool                mIncremental    {false};                            /** If the table is grown incrementally */
+    bucket_ptr_t        mOldBucketArray {nullptr};                          /** Bucket array being migrated from during an incremental resize (nullptr if none is in progress) */
+    uint64_t            mOldBucketCount {0ULL};                             /** Number of buckets in the array being migrated from */
+    uint64_t            mMigratePos     {0ULL};                             /** Position of the next old bucket to be migrated by the sweep */
+
     DBG_MODE (
-    uint64_t            mAllocAmt       {0ULL};                             /** Number of bytes allocated by the hash table (does not count allocations done by keys internally) */
-    uint64_t            mAllocCnt       {0ULL};                             /** Number of times operator new/malloc has been used to perform a new allocation (does not count allocations done by keys internally) */
-    uint64_t            mDeleteCnt      {0ULL};                             /** Number of times operator delete/free has been used to free up memory (does not count frees done by keys internally) */
+    counter_t           mAllocAmt       {0ULL};                             /** Number of bytes allocated by the hash table (does not count allocations done by keys internally) */
+    counter_t           mAllocCnt       {0ULL};                             /** Number of times operator new/malloc has been used to perform a new allocation (does not count allocations done by keys internally) */
+    counter_t           mDeleteCnt      {0ULL};                             /** Number of times operator delete/free has been used to free up memory (does not count frees done by keys internally) */
 
-    uint64_t            mResizeCnt      {0ULL};                             /** Number of times the bucket array of the table has been resized (expanded, specifically) */
+    counter_t           mResizeCnt      {0ULL};                             /** Number of times the bucket array of the table has been resized (expanded, specifically) */
 
-    uint64_t            mAggregateCnt   {0ULL};                             /** Number of aggregate nodes in the table (=number of distinct hash values in the table) */
+    counter_t           mAggregateCnt   {0ULL};                             /** Number of aggregate nodes in the table (=number of distinct hash values in the table) */
     )
 
 };
 
 /**
- * @brief                   Construct a new AgHashTable<key_t, tHashFunc, tEquals>::AgHashTable object
+ * @brief                   Construct a new AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable object
  *
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-AgHashTable<key_t, tHashFunc, tEquals>::AgHashTable ()
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable ()
 {
     init ();
 }
 
 /**
- * @brief Construct a new AgHashTable<key_t, tHashFunc, tEquals>::AgHashTable object
+ * @brief Construct a new AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable object
  *
  * @param pBucketCount      Number of buckets to initialize the hash table with
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-AgHashTable<key_t, tHashFunc, tEquals>::AgHashTable (const uint64_t &pBucketCount)
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable (const uint64_t &pBucketCount)
 {
     mBucketCount        = pBucketCount;
     init ();
 }
 
+/**
+ * @brief                   Construct a new AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable object by taking
+ *                          over the buckets, nodes, locks and counters of another table (no key is copied)
+ *
+ *                          The other table is left as an empty table with the default number of buckets, which can be used like a
+ *                          newly constructed one (initialized () returns false for it if those buckets could not be allocated)
+ *                          Iterators into the other table are invalidated
+ *
+ * @param pOther            Table to move from
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable (AgHashTable &&pOther) noexcept
+    : AgHashTable ()
+{
+    swap (pOther);
+}
+
+/**
+ * @brief                   Construct a new AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable object without any
+ *                          buckets (initialized () returns false for it), to be filled in by copy_from ()
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable (unallocated_t)
+{
+    mBucketArray        = nullptr;
+    mBucketCount        = 0ULL;
+
+    MULTITHREADED_MODE (
+    mLocks              = nullptr;
+    )
+}
+
+/**
+ * @brief                   Takes over the buckets, nodes, locks and counters of another table, handing the present ones to it (they
+ *                          are released once the other table is destroyed)
+ *
+ *                          Iterators into either table are invalidated
+ *
+ * @param pOther            Table to move from
+ *
+ * @return AgHashTable&     Reference to this table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc> &
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::operator= (AgHashTable &&pOther) noexcept
+{
+    swap (pOther);
+    return *this;
+}
+
 /**
  * @brief                   Initialize the hash table with the specified number of buckets
  *
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 void
-AgHashTable<key_t, tHashFunc, tEquals>::init ()
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::init ()
 {
     // try to allocate the array of buckets
     mBucketArray        = new (std::nothrow) bucket_t[mBucketCount];
@@ -306,7 +776,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::init ()
 
     MULTITHREADED_MODE (
 
-    mLocks              = new (std::nothrow) std::shared_mutex[mBucketCount];
+    // since both counts are powers of 2, keys in the same bucket always map to the same lock as long as there are no more locks than buckets
+    mLockCount          = (mBucketCount < sMaxLockCount) ? (mBucketCount) : (sMaxLockCount);
+    mLocks              = new (std::nothrow) std::shared_mutex[mLockCount];
 
     DBG_MODE (
     if (mLocks == nullptr) {
@@ -314,7 +786,7 @@ AgHashTable<key_t, tHashFunc, tEquals>::init ()
     }
     else {
         ++mAllocCnt;
-        mAllocAmt       += sizeof (std::shared_mutex) * mBucketCount;
+        mAllocAmt       += sizeof (std::shared_mutex) * mLockCount;
     }
     )
     )
@@ -327,19 +799,13 @@ AgHashTable<key_t, tHashFunc, tEquals>::init ()
 }
 
 /**
- * @brief                   Destroy the AgHashTable<key_t, tHashFunc, tEquals>::AgHashTable object
+ * @brief                   Destroy the AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::AgHashTable object
  *
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-AgHashTable<key_t, tHashFunc, tEquals>::~AgHashTable ()
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::~AgHashTable ()
 {
-    // iterate through each bucket in the array and delete it
-    for (uint64_t bucketId = 0; bucketId < mBucketCount; ++bucketId) {
-        delete mBucketArray[bucketId].hashListHead;
-    }
-
-    // delete the array of buckets
-    delete mBucketArray;
+    release ();
 }
 
 /**
@@ -348,9 +814,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::~AgHashTable ()
  * @return true             If the table could be successfully initialized
  * @return false            If the table could not be successfully initialized
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 bool
-AgHashTable<key_t, tHashFunc, tEquals>::initialized () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::initialized () const
 {
     if (mBucketArray == nullptr) {
         return false;
@@ -370,9 +836,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::initialized () const
  *
  * @return uint64_t         Number of keys in the hash table
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::size () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::size () const
 {
     return mKeyCount;
 }
@@ -382,9 +848,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::size () const
  *
  * @return uint64_t         Number of keys in the hash table
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_key_count () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_key_count () const
 {
     return mKeyCount;
 }
@@ -394,23 +860,24 @@ AgHashTable<key_t, tHashFunc, tEquals>::get_key_count () const
  *
  * @return uint64_t         Number of buckets in the hash table
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_bucket_count () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_bucket_count () const
 {
     return mBucketCount;
 }
 
 /**
- * @brief                   Returns the maximum number of buckets which the hash table can have
+ * @brief                   Returns the maximum number of buckets which the hash table can grow to (set by the growth policy, and limited
+ *                          by the bitness of the hash)
  *
- * @return uint64_t         Maximum number of buckets which the hash table can have
+ * @return uint64_t         Maximum number of buckets which the hash table can grow to
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_max_bucket_count () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_max_bucket_count () const
 {
-    return sMaxBucketsAllowed;
+    return (mGrowth.maxBucketCount < sMaxBucketsAllowed) ? (mGrowth.maxBucketCount) : (sMaxBucketsAllowed);
 }
 
 DBG_MODE (
@@ -420,9 +887,9 @@ DBG_MODE (
  *
  * @return uint64_t         Amount of memory (in bytes) allocated by the hash table
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_alloc_amount () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_alloc_amount () const
 {
     return mAllocAmt;
 }
@@ -432,9 +899,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::get_alloc_amount () const
  *
  * @return uint64_t         Number of allocations performed by the hash table
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_alloc_count () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_alloc_count () const
 {
     return mAllocCnt;
 }
@@ -444,9 +911,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::get_alloc_count () const
  *
  * @return uint64_t         Number of times memory has been freed by the hash table
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_delete_count () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_delete_count () const
 {
     return mDeleteCnt;
 }
@@ -456,20 +923,58 @@ AgHashTable<key_t, tHashFunc, tEquals>::get_delete_count () const
  *
  * @return uint64_t         Number of times the hash table has been resized
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable <key_t, tHashFunc, tEquals>::get_resize_count () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_resize_count () const
 {
     return mResizeCnt;
 }
 
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable <key_t, tHashFunc, tEquals>::get_aggregate_count () const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_aggregate_count () const
 {
     return mAggregateCnt;
 }
 
+/**
+ * @brief                   Returns the number of allocations the node pools have made from the system
+ *
+ *                          With the default allocator, this is one per node, while pooling allocators make one per chunk
+ *
+ * @return uint64_t         Number of allocations made by the node pools
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_pool_alloc_count () const
+{
+    return mNodePool.get_system_alloc_count () + mAggrPool.get_system_alloc_count ();
+}
+
+/**
+ * @brief                   Returns the amount of memory the node pools currently hold from the system (including freed nodes kept for reuse)
+ *
+ * @return uint64_t         Amount of memory (in bytes) held by the node pools
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_pool_reserved_amount () const
+{
+    return mNodePool.get_reserved_amount () + mAggrPool.get_reserved_amount ();
+}
+
+/**
+ * @brief                   Returns the number of freed nodes and aggregate nodes the node pools are keeping for reuse
+ *
+ * @return uint64_t         Number of freed nodes waiting to be reused
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_pool_free_count () const
+{
+    return mNodePool.get_free_count () + mAggrPool.get_free_count ();
+}
+
 )
 
 /**
@@ -479,9 +984,9 @@ AgHashTable <key_t, tHashFunc, tEquals>::get_aggregate_count () const
  *
  * @return uint64_t         Number of keys in the bucket whose position is given
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_bucket_key_count (const uint64_t &pBucketId) const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_bucket_key_count (const uint64_t &pBucketId) const
 {
     return (pBucketId < mBucketCount) ? (mBucketArray[pBucketId].keyCount) : (0ULL);
 }
@@ -493,9 +998,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::get_bucket_key_count (const uint64_t &pB
  *
  * @return uint64_t         Number of unique hashs in the bucket whose position is given
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_bucket_hash_count (const uint64_t &pBucketId) const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_bucket_hash_count (const uint64_t &pBucketId) const
 {
     return (pBucketId < mBucketCount) ? (mBucketArray[pBucketId].distinctHashCount) : (0ULL);
 }
@@ -507,90 +1012,238 @@ AgHashTable<key_t, tHashFunc, tEquals>::get_bucket_hash_count (const uint64_t &p
  *
  * @return uint64_t         Bucket in which the supplied key will go into after insertion
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 uint64_t
-AgHashTable<key_t, tHashFunc, tEquals>::get_bucket_of_key (const key_t &pKey) const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_bucket_of_key (const key_t &pKey) const
 {
     hash_t              keyHash;                                    /** Hash value of the key */
     uint64_t            bucketId;                                   /** Position of the bucket in which to insert the key */
 
     // calculate the hash value of the key and find the bucket in which it should be insert into
-    keyHash         = tHashFunc (&pKey);
+    keyHash         = ag_bucket_hash<key_t, tHashFunc> (&pKey);
     bucketId        = keyHash & (mBucketCount - 1);
 
     return bucketId;
 }
 
 /**
- * @brief                   Returns if a given key exists in the hash table
- *
- * @param pKey              Key to search for
+ * @brief                   Returns if the table is grown incrementally
  *
- * @return true             If the supplied key exists in the hash table
- * @return false            If the supplied key does not exist in the hash table
+ * @return true             If the table is grown incrementally
+ * @return false            If the table rehashes every bucket at once while growing
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 bool
-AgHashTable<key_t, tHashFunc, tEquals>::exists (const key_t &pKey) const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_incremental_resize () const
 {
-    hash_t              keyHash;                                    /** Hash value of the key */
-    uint64_t            bucketId;                                   /** Position of the bucket in which to insert the key */
-
-    aggr_ptr_t          aggrElem;                                   /** Pointer to the new aggregate node's predecessor's next-pointer */
+    return mIncremental;
+}
 
-    // calculate the hash value of the key and find the bucket in which it should be insert into
-    keyHash         = tHashFunc (&pKey);
-    bucketId        = keyHash & (mBucketCount - 1);
+/**
+ * @brief                   Returns the number of buckets of the previous bucket array which have not been migrated yet
+ *
+ * @return uint64_t         Number of buckets left to migrate (0 if no incremental resize is in progress)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_pending_bucket_count () const
+{
+    return (mOldBucketArray != nullptr) ? (mOldBucketCount - mMigratePos) : (0ULL);
+}
 
-    // get a pointer to the pointer to the aggregate list's head
-    aggrElem        = mBucketArray[bucketId].hashListHead;
+/**
+ * @brief                   Sets if the table should be grown incrementally
+ *
+ *                          In incremental mode, growing only allocates the new bucket array, after which every insertion and
+ *                          erasure migrates the buckets it touches along with a few more (lookups consult both arrays until every
+ *                          bucket has been migrated), which bounds the worst-case latency of a single operation
+ *                          Turning incremental mode off finishes any migration which is in progress
+ *
+ * @note                    Incremental resizing is not available in multithreaded mode, where the migration state would have to
+ *                          be shared between the buckets' locks
+ *
+ * @param pIncremental      If the table should be grown incrementally
+ *
+ * @return true             If the mode was set
+ * @return false            If the mode could not be set (multithreaded mode)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::set_incremental_resize (const bool &pIncremental)
+{
+    MULTITHREADED_MODE (
+    return !pIncremental;
+    )
 
-    while (aggrElem != nullptr) {
+    NO_MULTITHREADED_MODE (
+    mIncremental    = pIncremental;
 
-        // if an aggregate node's representative hash value matches with the key's hash value.
-        // try to find the new key in it's linked list
-        if (aggrElem->keyHash == keyHash) {
-            return exists_util (pKey, aggrElem->nodePtr);
+    // the table only rehashes every bucket at once outside incremental mode, so there can not be a migration left in progress
+    if (!mIncremental && mOldBucketArray != nullptr) {
+        while (mMigratePos < mOldBucketCount) {
+            migrate_bucket (mMigratePos++);
         }
-
-        // go to the next aggregate node
-        aggrElem    = aggrElem->nextPtr;
+        finish_migration ();
     }
 
-    // if node aggregate node with matching representative hash value is found, return failed find
-    return false;
+    return true;
+    )
 }
 
 /**
- * @brief                   Searches for a given key in the hash table and returns an iterator to it (returns end() if no matching key is found)
- *
- * @param pKey              Key to search for
+ * @brief                   Returns the growth policy of the table
  *
- * @return true             If the supplied key exists in the hash table
- * @return false            If the supplied key does not exist in the hash table
+ * @return AgGrowthPolicy   Growth policy which decides when the table grows and by how much
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-typename AgHashTable<key_t, tHashFunc, tEquals>::iterator
-AgHashTable<key_t, tHashFunc, tEquals>::find (const key_t &pKey) const
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgGrowthPolicy
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_growth_policy () const
 {
-    hash_t              keyHash;                                    /** Hash value of the key */
+    return mGrowth;
+}
+
+/**
+ * @brief                   Returns the number of threads rehash () and reserve () split growing the table across
+ *
+ * @return uint64_t         Number of threads (1 if the table is grown on the calling thread alone)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_rehash_threads () const
+{
+    return mRehashThreads;
+}
+
+/**
+ * @brief                   Returns if growth triggered by insertions is also split across the rehash threads
+ *
+ * @return true             If insertions which grow the table use the rehash threads
+ * @return false            If insertions grow the table on the inserting thread alone
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_parallel_growth () const
+{
+    return mParallelGrowth;
+}
+
+/**
+ * @brief                   Sets the growth policy of the table (see AgGrowthPolicy for presets), which applies from the next insertion
+ *                          (or erasure)
+ *
+ *                          A smaller maximum number of buckets than the table already has only stops it from growing further (call
+ *                          rehash () to bring the table within the limit)
+ *
+ * @note                    The growth policy should not be changed while other threads are using the table
+ *
+ * @param pGrowth           Growth policy to use
+ *
+ * @return true             If the policy was set
+ * @return false            If the policy is invalid (the resize factor or maximum number of buckets is not a power of 2, the
+ *                          resize factor is smaller than 2, or the shrink load is more than half of the load a shrunk table is
+ *                          left with), in which case the previous policy is kept
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::set_growth_policy (const AgGrowthPolicy &pGrowth)
+{
+    // both are used to grow a bucket array whose size is a power of 2, which must remain a power of 2
+    if ((pGrowth.resizeFactor < 2ULL) || ((pGrowth.resizeFactor & (pGrowth.resizeFactor - 1ULL)) != 0ULL)) {
+        return false;
+    }
+    if ((pGrowth.maxBucketCount == 0ULL) || ((pGrowth.maxBucketCount & (pGrowth.maxBucketCount - 1ULL)) != 0ULL)) {
+        return false;
+    }
+
+    // a shrunk table holds more than half of the target load, which must keep it clear of the shrink load (or it would shrink repeatedly)
+    if (pGrowth.shrinkLoadPercent * 2ULL > target_load (pGrowth) * 100ULL) {
+        return false;
+    }
+
+    mGrowth         = pGrowth;
+    return true;
+}
+
+/**
+ * @brief                   Sets the number of threads that growing the bucket array at once is split across
+ *
+ *                          When growing, the keys of an old bucket can only move to the new buckets which share the old bucket's
+ *                          position in their low bits, so the old buckets are split into contiguous ranges, one per thread, and no
+ *                          two threads ever write to the same new bucket (no locks are needed)
+ *                          Threads are started for every resize, and only if each of them gets at least sMinBucketsPerThread old
+ *                          buckets (smaller tables are grown on the calling thread alone, as are shrinks and incremental resizes)
+ *
+ * @note                    The threads are only used to move buckets while the resizing thread holds every lock, so the table is
+ *                          never accessed by them concurrently with any other operation
+ *
+ * @param pThreadCount      Number of threads, including the calling thread (1 grows the table on the calling thread alone)
+ * @param pParallelGrowth   If growth triggered by insertions should use the threads as well (otherwise only rehash () and
+ *                          reserve () use them)
+ *
+ * @return true             If the number of threads was set
+ * @return false            If the number of threads is 0 or more than sMaxRehashThreads, in which case the previous setting is kept
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::set_rehash_threads (const uint64_t &pThreadCount, const bool &pParallelGrowth)
+{
+    if ((pThreadCount == 0ULL) || (pThreadCount > sMaxRehashThreads)) {
+        return false;
+    }
+
+    mRehashThreads  = pThreadCount;
+    mParallelGrowth = pParallelGrowth;
+
+    return true;
+}
+
+/**
+ * @brief                   Returns if a given key exists in the hash table
+ *
+ * @param pKey              Key to search for
+ *
+ * @return true             If the supplied key exists in the hash table
+ * @return false            If the supplied key does not exist in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::exists (const key_t &pKey) const
+{
+    hash_t              keyHash;                                    /** Hash value of the key */
     uint64_t            bucketId;                                   /** Position of the bucket in which to insert the key */
 
     aggr_ptr_t          aggrElem;                                   /** Pointer to the new aggregate node's predecessor's next-pointer */
 
-    // calculate the hash value of the key and find the bucket in which it should be insert into
-    keyHash         = tHashFunc (&pKey);
-    bucketId        = keyHash & (mBucketCount - 1);
+    // calculate the hash value of the key
+    keyHash         = ag_bucket_hash<key_t, tHashFunc> (&pKey);
 
-    // get a pointer to the pointer to the aggregate list's head
-    aggrElem        = mBucketArray[bucketId].hashListHead;
+    // lookups only need shared access to the bucket (the bucket array can not be resized while the lock is held)
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex>     stripeLock  {mLocks[get_lock_id (keyHash)]};
+    )
+
+    // find the bucket in which it should be present (which might be in the old array during an incremental resize)
+    bucketId        = locate (keyHash);
+
+    const bucket_t      &bucket     = bucket_at (bucketId);         /** Bucket in which the key should be present */
+
+    // the first aggregate node's hash and list are stored in the bucket itself, so it does not have to be read
+    if (bucket.hashListHead == nullptr) {
+        return false;
+    }
+    if (bucket.headHash == keyHash) {
+        return exists_util (pKey, bucket.headNode);
+    }
+
+    // otherwise search the rest of the aggregate nodes (if there are any)
+    aggrElem        = (bucket.distinctHashCount > 1) ? (bucket.hashListHead->nextPtr) : (nullptr);
 
     while (aggrElem != nullptr) {
 
         // if an aggregate node's representative hash value matches with the key's hash value.
         // try to find the new key in it's linked list
         if (aggrElem->keyHash == keyHash) {
-            return find_util (pKey, aggrElem);
+            return exists_util (pKey, aggrElem->nodePtr);
         }
 
         // go to the next aggregate node
@@ -598,7 +1251,21 @@ AgHashTable<key_t, tHashFunc, tEquals>::find (const key_t &pKey) const
     }
 
     // if node aggregate node with matching representative hash value is found, return failed find
-    return end ();
+    return false;
+}
+
+/**
+ * @brief                   Searches for a given key in the hash table and returns an iterator to it (returns end() if no matching key is found)
+ *
+ * @param pKey              Key to search for
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::find (const key_t &pKey) const
+{
+    return find_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey), [&pKey] (const key_t &pStored) { return tEquals (pKey, pStored); }, &pKey);
 }
 
 /**
@@ -609,504 +1276,2260 @@ AgHashTable<key_t, tHashFunc, tEquals>::find (const key_t &pKey) const
  * @return true             If the key could successfully be inserted
  * @return false            If the key could not be inserted (duplicate key found or allocation failure)
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 bool
-AgHashTable<key_t, tHashFunc, tEquals>::insert (const key_t &pKey)
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::insert (const key_t &pKey)
 {
-    hash_t              keyHash;                                    /** Hash value of the key */
-    uint64_t            bucketId;                                   /** Position of the bucket in which to insert the key */
+    // the key is only copied into a node if no equal key exists
+    return emplace_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey),
+                             [&pKey] (const key_t &pStored) { return tEquals (pKey, pStored); },
+                             [&pKey] () -> const key_t & { return pKey; },
+                             [] (key_t &pStored, const bool &pInserted) { (void)pStored; (void)pInserted; },
+                             &pKey);
+}
 
-    aggr_ptr_t          *aggrElem;                                  /** Pointer to the new aggregate node's predecessor's next-pointer */
-    aggr_ptr_t          newAggr;                                    /** Pointer to new aggregate node */
+/**
+ * @brief                   Attempts to erase a given key from the hash table
+ *
+ * @param pKey              Key to erase
+ *
+ * @return true             If the key was successfully found and removed
+ * @return false            If the key could not be removed (no matching key was found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::erase (const key_t &pKey)
+{
+    return erase_matching (ag_bucket_hash<key_t, tHashFunc> (&pKey), [&pKey] (const key_t &pStored) { return tEquals (pKey, pStored); }, &pKey);
+}
 
-    bool                insertionState;                             /** Stores if insert_util could successfully insert the key into the aggregate node's linked list */
+/**
+ * @brief                   Searches for a key equal to a key of another type and returns an iterator to it (returns end() if no matching key is found)
+ *
+ *                          The key being searched for is never converted to key_t (so a slice of a buffer can be searched for
+ *                          without copying it into a temporary key)
+ *
+ * @tparam probe_t          Type of the key being searched for (must not be convertible to key_t)
+ * @tparam tProbeHash       Hash function for probe_t, which must return the same hash as tHashFunc for equal keys (defaults to ag_default_probe_hash ())
+ * @tparam tProbeEquals     Comparator between probe_t and key_t, consistent with tEquals (defaults to ag_hashtable_str_equals)
+ *
+ * @param pProbe            Key to search for
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename probe_t, auto tProbeHash, auto tProbeEquals, typename>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::find (const probe_t &pProbe) const
+{
+    static_assert (std::is_same<typename std::invoke_result<decltype (tProbeHash), const probe_t *>::type, hash_t>::value,
+                   "Hash function for probe_t must return the same type as tHashFunc");
+
+    // ag_fnv1a_str and ag_wyhash_str only agree with tHashFunc if the stored keys are also hashed with them
+    if constexpr (std::is_convertible<const probe_t &, std::string_view>::value) {
+        static_assert (!ag_same_function<tProbeHash, ag_fnv1a_str<probe_t, hash_t>> () || ag_same_function<tHashFunc, ag_fnv1a_str<key_t, hash_t>> (),
+                       "Keys must be hashed with ag_fnv1a_str to be searched for using ag_fnv1a_str");
+        static_assert (!ag_same_function<tProbeHash, ag_wyhash_str<probe_t, hash_t>> () || ag_same_function<tHashFunc, ag_wyhash_str<key_t, hash_t>> (),
+                       "Keys must be hashed with ag_wyhash_str to be searched for using ag_wyhash_str");
+    }
 
-    // calculate the hash value of the key and find the bucket in which it should be insert into
-    keyHash         = tHashFunc (&pKey);
-    bucketId        = keyHash & (mBucketCount - 1);
+    return find_matching (ag_map_hash<key_t, tHashFunc> (tProbeHash (&pProbe)), [&pProbe] (const key_t &pStored) { return tProbeEquals (pProbe, pStored); });
+}
 
-    // get a pointer to the pointer to the aggregate list's head
-    aggrElem        = &(mBucketArray[bucketId].hashListHead);
+/**
+ * @brief                   Returns if a key equal to a key of another type exists in the hash table (see find ())
+ *
+ * @tparam probe_t          Type of the key being searched for (must not be convertible to key_t)
+ * @tparam tProbeHash       Hash function for probe_t, which must return the same hash as tHashFunc for equal keys (defaults to ag_default_probe_hash ())
+ * @tparam tProbeEquals     Comparator between probe_t and key_t, consistent with tEquals (defaults to ag_hashtable_str_equals)
+ *
+ * @param pProbe            Key to search for
+ *
+ * @return true             If a matching key exists in the hash table
+ * @return false            If no matching key exists in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename probe_t, auto tProbeHash, auto tProbeEquals, typename>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::exists (const probe_t &pProbe) const
+{
+    return find<probe_t, tProbeHash, tProbeEquals> (pProbe) != end ();
+}
 
-    while ((*aggrElem) != nullptr) {
+/**
+ * @brief                   Attempts to erase the key equal to a key of another type from the hash table (see find ())
+ *
+ * @tparam probe_t          Type of the key to erase (must not be convertible to key_t)
+ * @tparam tProbeHash       Hash function for probe_t, which must return the same hash as tHashFunc for equal keys (defaults to ag_default_probe_hash ())
+ * @tparam tProbeEquals     Comparator between probe_t and key_t, consistent with tEquals (defaults to ag_hashtable_str_equals)
+ *
+ * @param pProbe            Key to erase
+ *
+ * @return true             If the key was successfully found and removed
+ * @return false            If the key could not be removed (no matching key was found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename probe_t, auto tProbeHash, auto tProbeEquals, typename>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::erase (const probe_t &pProbe)
+{
+    static_assert (std::is_same<typename std::invoke_result<decltype (tProbeHash), const probe_t *>::type, hash_t>::value,
+                   "Hash function for probe_t must return the same type as tHashFunc");
+
+    // ag_fnv1a_str and ag_wyhash_str only agree with tHashFunc if the stored keys are also hashed with them
+    if constexpr (std::is_convertible<const probe_t &, std::string_view>::value) {
+        static_assert (!ag_same_function<tProbeHash, ag_fnv1a_str<probe_t, hash_t>> () || ag_same_function<tHashFunc, ag_fnv1a_str<key_t, hash_t>> (),
+                       "Keys must be hashed with ag_fnv1a_str to be searched for using ag_fnv1a_str");
+        static_assert (!ag_same_function<tProbeHash, ag_wyhash_str<probe_t, hash_t>> () || ag_same_function<tHashFunc, ag_wyhash_str<key_t, hash_t>> (),
+                       "Keys must be hashed with ag_wyhash_str to be searched for using ag_wyhash_str");
+    }
 
-        // if the current aggregate node's representative hash value matches with the key's hash value,
-        // try to insert the new key into it's linked list
-        if ((*aggrElem)->keyHash == keyHash) {
-            insertionState  = insert_util (pKey, &((*aggrElem)->nodePtr));
+    return erase_matching (ag_map_hash<key_t, tHashFunc> (tProbeHash (&pProbe)), [&pProbe] (const key_t &pStored) { return tProbeEquals (pProbe, pStored); });
+}
 
-            // if the insertion was succesful, increment the key counters
-            if (insertionState) {
-                ++mKeyCount;
-                ++(*aggrElem)->keyCount;
-                ++mBucketArray[bucketId].keyCount;
+/**
+ * @brief                   Searches for every key of an array, writing an iterator to each key (or end()) into the results
+ *
+ *                          Keys are handled in groups whose memory accesses are overlapped with each other (see lookup_batch ())
+ *
+ * @param pKeys             Pointer to the array of keys to search for
+ * @param pCount            Number of keys in the array
+ * @param pResults          Pointer to an array of (atleast pCount) iterators to write the results into
+ *
+ * @return uint64_t         Number of keys which were found
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::find_batch (const key_t *pKeys, const uint64_t &pCount, iterator *pResults) const
+{
+    uint64_t            foundCnt    {0ULL};                         /** Number of keys found */
 
-                // resize the table if the bucket has too many keys with different hashs
-                // dont resize in case the number of keys are > maximum allowed but all have the same hash, since
-                // this would still cause all the keys to fall in the same bucket, causing repeated resizing at every subsequent insert
-                if ((mBucketArray[bucketId].distinctHashCount > sNumDistinctAllowed)
-                    && (mBucketArray[bucketId].keyCount > sNumKeysAllowed)
-                    && ((mBucketCount * sResizeFactor) < sMaxBucketsAllowed)) {
-                    resize (mBucketCount * sResizeFactor);
-                }
-            }
+    // buckets can not be read without holding their locks, so keys are searched for one at a time
+    MULTITHREADED_MODE (
+    for (uint64_t keyId = 0; keyId < pCount; ++keyId) {
+        pResults[keyId] = find (pKeys[keyId]);
+        foundCnt        += (pResults[keyId] != end ());
+    }
+    return foundCnt;
+    )
 
-            return insertionState;
+    NO_MULTITHREADED_MODE (
+    lookup_batch (pKeys, pCount, [this, pKeys, pResults, &foundCnt] (const uint64_t &pKeyId, aggr_ptr_t pAggrPtr, const uint64_t &pBucketId) {
+
+        auto        match   = [&key = pKeys[pKeyId]] (const key_t &pStored) { return tEquals (key, pStored); };
+
+        pResults[pKeyId]    = (pAggrPtr != nullptr) ? (find_util (match, pAggrPtr->nodePtr, pAggrPtr, pBucketId, &pKeys[pKeyId])) : (end ());
+        foundCnt            += (pResults[pKeyId] != end ());
+    });
+
+    return foundCnt;
+    )
+}
+
+/**
+ * @brief                   Checks if every key of an array exists in the hash table, writing the result for each key into the results
+ *
+ *                          Keys are handled in groups whose memory accesses are overlapped with each other (see lookup_batch ())
+ *
+ * @param pKeys             Pointer to the array of keys to search for
+ * @param pCount            Number of keys in the array
+ * @param pResults          Pointer to an array of (atleast pCount) bools to write the results into (may be nullptr if only the count is needed)
+ *
+ * @return uint64_t         Number of keys which exist in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::exists_batch (const key_t *pKeys, const uint64_t &pCount, bool *pResults) const
+{
+    uint64_t            foundCnt    {0ULL};                         /** Number of keys found */
+
+    // buckets can not be read without holding their locks, so keys are searched for one at a time
+    MULTITHREADED_MODE (
+    bool                found;                                      /** Stores if the current key was found */
+
+    for (uint64_t keyId = 0; keyId < pCount; ++keyId) {
+        found           = exists (pKeys[keyId]);
+        foundCnt        += found;
+        if (pResults != nullptr) {
+            pResults[keyId] = found;
         }
+    }
+    return foundCnt;
+    )
 
-        // go to the next aggregate node
-        aggrElem    = &((*aggrElem)->nextPtr);
+    NO_MULTITHREADED_MODE (
+    lookup_batch (pKeys, pCount, [this, pKeys, pResults, &foundCnt] (const uint64_t &pKeyId, aggr_ptr_t pAggrPtr, const uint64_t &pBucketId) {
+
+        bool        found   = (pAggrPtr != nullptr) && exists_util (pKeys[pKeyId], pAggrPtr->nodePtr);
+
+        (void)pBucketId;
+        foundCnt            += found;
+
+        if (pResults != nullptr) {
+            pResults[pKeyId]    = found;
+        }
+    });
+
+    return foundCnt;
+    )
+}
+
+/**
+ * @brief                   Attempts to insert every key of an array into the hash table, writing the result for each key into the results
+ *
+ *                          The hashes of a group of sBatchWidth keys are calculated and their buckets and first aggregate nodes are
+ *                          prefetched before any of them is inserted, after which the keys are inserted in order (so duplicates within
+ *                          the array are handled exactly like consecutive calls to insert ())
+ *                          The aggregate lists are not matched ahead of time (see match_batch ()), since an insertion may change the
+ *                          bucket of a later key of the same group, which is searched again by emplace_matching () anyway
+ *
+ * @param pKeys             Pointer to the array of keys to insert
+ * @param pCount            Number of keys in the array
+ * @param pResults          Pointer to an array of (atleast pCount) bools to write the results into (may be nullptr if only the count is needed)
+ *
+ * @return uint64_t         Number of keys which were inserted
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::insert_batch (const key_t *pKeys, const uint64_t &pCount, bool *pResults)
+{
+    bool                inserted;                                   /** Stores if the current key was inserted */
+    uint64_t            insertedCnt {0ULL};                         /** Number of keys inserted */
+
+    // buckets can not be read without holding their locks, so keys are inserted one at a time
+    MULTITHREADED_MODE (
+    for (uint64_t keyId = 0; keyId < pCount; ++keyId) {
+        inserted        = insert (pKeys[keyId]);
+        insertedCnt     += inserted;
+        if (pResults != nullptr) {
+            pResults[keyId] = inserted;
+        }
     }
+    return insertedCnt;
+    )
 
-    // if the loop was completed but no position was found, an entirely new aggregate node needs to be created for
-    // this hash value
+    NO_MULTITHREADED_MODE (
+    hash_t              hashes[sBatchWidth];                        /** Hash values of the keys of the current group */
+    aggr_ptr_t          aggrs[sBatchWidth];                         /** First aggregate node of the bucket of each key (only needed by head_batch ()) */
+    uint64_t            bucketIds[sBatchWidth];                     /** Position of the bucket of each key (only needed by head_batch ()) */
+    uint64_t            groupSize;                                  /** Number of keys in the current group */
 
-    // create a new aggregate node (return failed insertion on failure)
-    newAggr         = new (std::nothrow) aggregate_node_t {nullptr, 0ULL, keyHash, nullptr};
-    if (newAggr == nullptr) {
-        return false;
+    for (uint64_t base = 0; base < pCount; base += sBatchWidth) {
+
+        groupSize   = ((pCount - base) < sBatchWidth) ? (pCount - base) : (sBatchWidth);
+
+        // the memory touched by an insertion may be moved by an earlier insertion of the same group (which only makes some
+        // of the prefetches useless, since the keys are still inserted normally)
+        prefetch_batch (pKeys + base, groupSize, hashes);
+        head_batch (hashes, groupSize, aggrs, bucketIds);
+
+        for (uint64_t keyId = 0; keyId < groupSize; ++keyId) {
+
+            const key_t &key    = pKeys[base + keyId];
+
+            inserted    = emplace_matching (hashes[keyId],
+                                            [&key] (const key_t &pStored) { return tEquals (key, pStored); },
+                                            [&key] () -> const key_t & { return key; },
+                                            [] (key_t &pStored, const bool &pInserted) { (void)pStored; (void)pInserted; },
+                                            &key);
+            insertedCnt += inserted;
+
+            if (pResults != nullptr) {
+                pResults[base + keyId]  = inserted;
+            }
+        }
     }
-    else {
-        DBG_MODE (
-        ++mAllocCnt;
-        mAllocAmt   += sizeof (aggregate_node_t);
-        )
+
+    return insertedCnt;
+    )
+}
+
+/**
+ * @brief                   Attempts to insert every key of a range into the hash table (in order, so the first of several equal keys is
+ *                          the one inserted)
+ *
+ *                          Ranges given as pointers to keys are inserted in place using insert_batch (), while keys from any other
+ *                          iterator are copied into a buffer of sBatchWidth keys, which is inserted using insert_batch () whenever it is full
+ *
+ * @tparam iter_t           Type of iterator (keys from iterators other than pointers should be default constructible)
+ *
+ * @param pFirst            Iterator to the first key of the range
+ * @param pLast             Iterator past the last key of the range
+ *
+ * @return uint64_t         Number of keys which were inserted
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename iter_t>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::insert_range (iter_t pFirst, iter_t pLast)
+{
+    if constexpr (std::is_convertible<iter_t, const key_t *>::value) {
+        const key_t         *first  = pFirst;
+        const key_t         *last   = pLast;
+
+        return insert_batch (first, (uint64_t)(last - first));
     }
+    else {
+        key_t               keys[sBatchWidth];                          /** Keys of the current group */
 
-    // place the new node at the last position and try to insert the new key into it's linked list
-    (*aggrElem)     = newAggr;
+        uint64_t            groupSize   {0ULL};                         /** Number of keys in the current group */
+        uint64_t            insertedCnt {0ULL};                         /** Number of keys inserted */
 
-    insertionState  = insert_util (pKey, &((*aggrElem)->nodePtr));
+        for (; pFirst != pLast; ++pFirst) {
 
-    // if the insertion was successfull, increment the corresponding key counters
-    if (insertionState) {
-        ++mKeyCount;
-        ++(*aggrElem)->keyCount;
-        ++mBucketArray[bucketId].keyCount;
-        ++mBucketArray[bucketId].distinctHashCount;
-        DBG_MODE (
-        ++mAggregateCnt;
-        )
+            keys[groupSize++]   = *pFirst;
 
-        // resize the table if the bucket has too many keys with different hashs
-        // dont resize in case the number of keys are > maximum allowed but all have the same hash, since
-        // this would still cause all the keys to fall in the same bucket, causing repeated resizing at every subsequent insert
-        if ((mBucketArray[bucketId].distinctHashCount > sNumDistinctAllowed)
-            && (mBucketArray[bucketId].keyCount > sNumKeysAllowed)
-            && ((mBucketCount * sResizeFactor) < sMaxBucketsAllowed)) {
-            resize (mBucketCount * sResizeFactor);
+            if (groupSize == sBatchWidth) {
+                insertedCnt     += insert_batch (keys, groupSize);
+                groupSize       = 0;
+            }
         }
+
+        return insertedCnt + insert_batch (keys, groupSize);
     }
-    // if the insertion failed, then remove the newly created aggregate node as well
-    else {
-        // get it and set its predecessor's successor to it's successor
-        newAggr             = *aggrElem;
-        *aggrElem           = newAggr->nextPtr;
+}
+
+/**
+ * @brief                   Makes room for the given number of keys, so that inserting upto that many keys does not grow the table
+ *                          (unless the keys crowd into a few buckets)
+ *
+ *                          Never shrinks the table, and never grows it past the maximum number of buckets of its growth policy
+ *
+ * @param pKeyCount         Number of keys the table should have room for
+ *
+ * @return true             If the table already had room for the keys, or could be grown to have room for them
+ * @return false            If the table could not be grown (allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::reserve (const uint64_t &pKeyCount)
+{
+    uint64_t            newCount;                                   /** Number of buckets needed for the keys */
+
+    newCount        = bucket_count_for (pKeyCount);
+
+    return rehash_util (newCount, false);
+}
+
+/**
+ * @brief                   Resizes the table to the given number of buckets (rounded up to a power of 2), which can be smaller than
+ *                          the present number of buckets
+ *
+ *                          The table is never left with fewer buckets than shrink_to_fit () would leave it with, nor with more
+ *                          buckets than the maximum of its growth policy
+ *
+ * @param pBucketCount      Number of buckets to resize the table to
+ *
+ * @return true             If the table was resized (or already had the resulting number of buckets)
+ * @return false            If the table could not be resized (allocation failure, or shrinking a table with more keys than a bucket can count)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::rehash (const uint64_t &pBucketCount)
+{
+    uint64_t            newCount;                                   /** Number of buckets to resize to */
+
+    newCount        = bucket_count_for (mKeyCount);
+
+    while ((newCount < pBucketCount) && (newCount < get_max_bucket_count ())) {
+        newCount    <<= 1;
+    }
+
+    return rehash_util (newCount, true);
+}
+
+/**
+ * @brief                   Shrinks the table to the fewest buckets which hold the present keys at the target load of its growth policy
+ *                          (numKeysAllowed / 8 keys per bucket), returning the memory of the remaining buckets
+ *
+ *                          The nodes of erased keys stay in the table's pools, so only the bucket array is shrunk
+ *
+ * @return true             If the table was shrunk (or could not be shrunk any further)
+ * @return false            If the table could not be shrunk (allocation failure, or more keys than a bucket can count)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::shrink_to_fit ()
+{
+    return rehash (0ULL);
+}
+
+/**
+ * @brief                   Erases every key of the table, keeping its bucket array (so it does not have to grow again as keys are
+ *                          inserted back), along with its growth policy and resize mode
+ *
+ *                          Nodes are destroyed iteratively, and with pools which can release all of their storage at once (such as
+ *                          AgSlabAllocator), their storage is released a chunk at a time instead of a node at a time
+ *                          An incremental resize in progress is abandoned, by deleting the old bucket array
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::clear ()
+{
+    MULTITHREADED_MODE (
+    lock_all ();
+    )
+
+    destroy_all ();
+
+    if (mOldBucketArray != nullptr) {
+        delete[] mOldBucketArray;
+        DBG_MODE (
+        ++mDeleteCnt;
+        mAllocAmt       -= sizeof (bucket_t) * mOldBucketCount;
+        )
+
+        mOldBucketArray = nullptr;
+        mOldBucketCount = 0ULL;
+        mMigratePos     = 0ULL;
+    }
+
+    for (uint64_t bucketId = 0; bucketId < mBucketCount; ++bucketId) {
+        mBucketArray[bucketId]  = bucket_t {};
+    }
+
+    DBG_MODE (
+    mDeleteCnt      += (uint64_t)mKeyCount + mAggregateCnt;
+    mAllocAmt       -= sizeof (node_t) * mKeyCount + sizeof (aggregate_node_t) * mAggregateCnt;
+    mAggregateCnt   = 0ULL;
+    )
+
+    mKeyCount       = 0ULL;
+
+    MULTITHREADED_MODE (
+    unlock_all ();
+    )
+}
+
+/**
+ * @brief                   Exchanges the contents of two tables (buckets, nodes, locks, counters and growth policies), without
+ *                          allocating, copying or touching a single key
+ *
+ *                          Iterators into either table are invalidated
+ *
+ * @note                    Neither table may be in use by other threads while they are swapped
+ *
+ * @param pOther            Table to exchange contents with
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::swap (AgHashTable &pOther) noexcept
+{
+    std::swap (mBucketArray, pOther.mBucketArray);
+
+    // nodes are returned to the pool they were allocated from, so the pools go along with the buckets
+    mNodePool.swap (pOther.mNodePool);
+    mAggrPool.swap (pOther.mAggrPool);
+
+    MULTITHREADED_MODE (
+    std::swap (mLocks, pOther.mLocks);
+    std::swap (mLockCount, pOther.mLockCount);
+    )
+
+    swap_counter (mKeyCount, pOther.mKeyCount);
+    std::swap (mBucketCount, pOther.mBucketCount);
+
+    std::swap (mGrowth, pOther.mGrowth);
+    std::swap (mRehashThreads, pOther.mRehashThreads);
+    std::swap (mParallelGrowth, pOther.mParallelGrowth);
+
+    std::swap (mIncremental, pOther.mIncremental);
+    std::swap (mOldBucketArray, pOther.mOldBucketArray);
+    std::swap (mOldBucketCount, pOther.mOldBucketCount);
+    std::swap (mMigratePos, pOther.mMigratePos);
+
+    DBG_MODE (
+    swap_counter (mAllocAmt, pOther.mAllocAmt);
+    swap_counter (mAllocCnt, pOther.mAllocCnt);
+    swap_counter (mDeleteCnt, pOther.mDeleteCnt);
+    swap_counter (mResizeCnt, pOther.mResizeCnt);
+    swap_counter (mAggregateCnt, pOther.mAggregateCnt);
+    )
+}
+
+/**
+ * @brief                   Replaces the contents of the table with a copy of another table (along with its growth policy and resize
+ *                          mode)
+ *
+ *                          The copy is structural, every aggregate node and node is copied in a single pass over the other table's
+ *                          buckets (using the hashes stored in the aggregate nodes), so no key is hashed or compared
+ *                          If the other table is in the middle of an incremental resize, the copy is made with the resize finished
+ *
+ * @note                    The other table may be used by other threads (for lookups) while it is copied, but this one may not
+ *
+ * @param pOther            Table to copy
+ *
+ * @return true             If the table was copied
+ * @return false            If the table could not be copied (allocation failure), in which case the present contents are kept
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::copy_from (const AgHashTable &pOther)
+{
+    bucket_ptr_t        newArray;                                   /** Bucket array holding the copy */
+    uint64_t            newCount;                                   /** Number of buckets of the copy */
+    bool                copied      {true};                         /** Stores if every aggregate node and node could be copied */
+    uint64_t            keyCount;                                   /** Number of keys copied */
+
+    DBG_MODE (
+    uint64_t            aggregateCnt;                               /** Number of aggregate nodes copied */
+    uint64_t            allocCnt    {mAllocCnt};                    /** Number of allocations before the copy (restored if the copy fails) */
+    uint64_t            allocAmt    {mAllocAmt};                    /** Number of bytes allocated before the copy (restored if the copy fails) */
+    )
+
+    MULTITHREADED_MODE (
+    std::shared_mutex   *newLocks;                                  /** Locks of the copy (as many as the other table has) */
+    uint64_t            newLockCount;                               /** Number of locks of the copy */
+    )
+
+    if (&pOther == this) {
+        return true;
+    }
+
+    // writers to the other table are kept out for the whole copy
+    MULTITHREADED_MODE (
+    for (uint64_t lockId = 0; lockId < pOther.mLockCount; ++lockId) {
+        pOther.mLocks[lockId].lock_shared ();
+    }
+    )
+
+    // the counters have to be read while the other table's locks are held, since they include keys inserted after the copy otherwise
+    newCount        = pOther.mBucketCount;
+    keyCount        = (uint64_t)pOther.mKeyCount;
+    DBG_MODE (
+    aggregateCnt    = (uint64_t)pOther.mAggregateCnt;
+    )
+
+    newArray        = new (std::nothrow) bucket_t[newCount];
+
+    if (newArray != nullptr) {
+        DBG_MODE (
+        ++mAllocCnt;
+        mAllocAmt   += sizeof (bucket_t) * newCount;
+        )
+
+        for (uint64_t bucketId = 0; copied && (bucketId < newCount); ++bucketId) {
+            copied  = copy_aggregates (pOther.mBucketArray[bucketId].hashListHead, newArray, newCount);
+        }
+        for (uint64_t bucketId = 0; copied && (bucketId < pOther.mOldBucketCount); ++bucketId) {
+            copied  = copy_aggregates (pOther.mOldBucketArray[bucketId].hashListHead, newArray, newCount);
+        }
+    }
+
+    MULTITHREADED_MODE (
+    newLockCount    = pOther.mLockCount;
+    newLocks        = new (std::nothrow) std::shared_mutex[newLockCount];
+
+    for (uint64_t lockId = pOther.mLockCount; lockId > 0; --lockId) {
+        pOther.mLocks[lockId - 1].unlock_shared ();
+    }
+
+    if (newLocks == nullptr) {
+        copied      = false;
+    }
+    )
+
+    // on failure, the partial copy is torn down and the present contents are kept (along with the counters, since nothing allocated
+    // for the copy outlives it)
+    if ((newArray == nullptr) || !copied) {
+        destroy_buckets (newArray, newCount);
+        delete[] newArray;
+
+        MULTITHREADED_MODE (
+        delete[] newLocks;
+        )
+
+        DBG_MODE (
+        mAllocCnt   = allocCnt;
+        mAllocAmt   = allocAmt;
+        )
+
+        return false;
+    }
+
+    // destroy the present contents (if there are any, since clone () copies into a table without buckets) and replace them with the copy
+    DBG_MODE (
+    mDeleteCnt      += (uint64_t)(mBucketArray != nullptr) + (uint64_t)(mOldBucketArray != nullptr);
+    mDeleteCnt      += (uint64_t)mKeyCount + mAggregateCnt;
+    mAllocAmt       -= sizeof (bucket_t) * (mBucketCount + mOldBucketCount);
+    mAllocAmt       -= sizeof (node_t) * mKeyCount + sizeof (aggregate_node_t) * mAggregateCnt;
+    )
+    destroy_buckets (mBucketArray, mBucketCount);
+    delete[] mBucketArray;
+    destroy_buckets (mOldBucketArray, mOldBucketCount);
+    delete[] mOldBucketArray;
+
+    MULTITHREADED_MODE (
+    DBG_MODE (
+    ++mAllocCnt;
+    mDeleteCnt      += (uint64_t)(mLocks != nullptr);
+    mAllocAmt       -= sizeof (std::shared_mutex) * mLockCount;
+    mAllocAmt       += sizeof (std::shared_mutex) * newLockCount;
+    )
+    delete[] mLocks;
+    mLocks          = newLocks;
+    mLockCount      = newLockCount;
+    )
+
+    mBucketArray    = newArray;
+    mBucketCount    = newCount;
+    mKeyCount       = keyCount;
+
+    mGrowth         = pOther.mGrowth;
+    mRehashThreads  = pOther.mRehashThreads;
+    mParallelGrowth = pOther.mParallelGrowth;
+    mIncremental    = pOther.mIncremental;
+    mOldBucketArray = nullptr;
+    mOldBucketCount = 0ULL;
+    mMigratePos     = 0ULL;
+
+    DBG_MODE (
+    mAggregateCnt   = aggregateCnt;
+    )
+
+    return true;
+}
+
+/**
+ * @brief                   Returns a copy of the table, made in the same way as copy_from ()
+ *
+ * @return AgHashTable      Copy of the table (initialized () returns false for it if the copy could not be made)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::clone () const
+{
+    AgHashTable         copy        {unallocated_t {}};             /** Table holding the copy (its buckets are allocated by copy_from ()) */
+
+    copy.copy_from (*this);
+
+    return copy;
+}
+
+/**
+ * @brief                   Searches for the key with the given hash which satisfies the given predicate and returns an iterator to it
+ *
+ * @tparam match_t          Type of the predicate
+ *
+ * @param pKeyHash          Hash of the key to search for
+ * @param pMatch            Predicate which returns true for the stored key being searched for (only called on keys with the same hash)
+ * @param pKey              Key being searched for, used to skip nodes whose fingerprint differs (nullptr if the key is not at hand)
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename match_t>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::find_matching (const hash_t &pKeyHash, match_t pMatch, const key_t *pKey) const
+{
+    uint64_t            bucketId;                                   /** Position of the bucket in which to insert the key */
+
+    aggr_ptr_t          aggrElem;                                   /** Pointer to the new aggregate node's predecessor's next-pointer */
+
+    // lookups only need shared access to the bucket (the bucket array can not be resized while the lock is held)
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex>     stripeLock  {mLocks[get_lock_id (pKeyHash)]};
+    )
+
+    // find the bucket in which it should be present (which might be in the old array during an incremental resize)
+    bucketId        = locate (pKeyHash);
+
+    const bucket_t      &bucket     = bucket_at (bucketId);         /** Bucket in which the key should be present */
+
+    // the first aggregate node's hash and list are stored in the bucket itself, so it does not have to be read
+    if (bucket.hashListHead == nullptr) {
+        return end ();
+    }
+    if (bucket.headHash == pKeyHash) {
+        return find_util (pMatch, bucket.headNode, bucket.hashListHead, bucketId, pKey);
+    }
+
+    // otherwise search the rest of the aggregate nodes (if there are any)
+    aggrElem        = (bucket.distinctHashCount > 1) ? (bucket.hashListHead->nextPtr) : (nullptr);
+
+    while (aggrElem != nullptr) {
+
+        // if an aggregate node's representative hash value matches with the key's hash value.
+        // try to find the new key in it's linked list
+        if (aggrElem->keyHash == pKeyHash) {
+            return find_util (pMatch, aggrElem->nodePtr, aggrElem, bucketId, pKey);
+        }
+
+        // go to the next aggregate node
+        aggrElem    = aggrElem->nextPtr;
+    }
+
+    // if node aggregate node with matching representative hash value is found, return failed find
+    return end ();
+}
+
+/**
+ * @brief                   Inserts a new key with the given hash, unless a stored key with the same hash satisfies the given predicate
+ *
+ *                          The key is hashed and its bucket is searched only once, whether or not it already exists
+ *                          pVisit is called with the matching or newly inserted key while the key's bucket is still locked, so the key
+ *                          can be modified in place (without changing its hash or equality) even in multithreaded mode
+ *
+ * @tparam match_t          Type of the predicate
+ * @tparam make_t           Type of the function which creates the key to insert
+ * @tparam visit_t          Type of the function which is called with the matching or newly inserted key
+ *
+ * @param pKeyHash          Hash of the key
+ * @param pMatch            Predicate which returns true for a stored key equal to the one being inserted (only called on keys with the same hash)
+ * @param pMake             Function which returns the key to insert (only called if no matching key exists)
+ * @param pVisit            Function called with a reference to the stored key and whether it was just inserted (not called on allocation failure)
+ * @param pKey              Key being inserted, used to skip nodes whose fingerprint differs (nullptr if the key is not at hand)
+ *
+ * @return true             If the key was inserted
+ * @return false            If the key was not inserted (matching key found, allocation failure or the bucket already holds sMaxBucketKeys keys)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename match_t, typename make_t, typename visit_t>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::emplace_matching (const hash_t &pKeyHash, match_t pMatch, make_t pMake, visit_t pVisit, const key_t *pKey)
+{
+    uint64_t            bucketId;                                   /** Position of the bucket in which to insert the key */
+
+    aggr_ptr_t          *aggrElem;                                  /** Pointer to the new aggregate node's predecessor's next-pointer */
+    aggr_ptr_t          newAggr;                                    /** Pointer to new aggregate node */
+
+    node_ptr_t          nodePtr;                                    /** Pointer to the matching or newly inserted node (nullptr on allocation failure) */
+    bool                insertionState;                             /** Stores if insert_util inserted a new node into the aggregate node's linked list */
+    uint64_t            observedCount;                              /** Number of buckets when the insertion was made (used to detect if the table was resized by another thread in the meantime) */
+
+    // modifications need exclusive access to the bucket (the bucket array can not be resized while the lock is held)
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex>     stripeLock  {mLocks[get_lock_id (pKeyHash)]};
+    )
+
+    // during an incremental resize, the keys of the old bucket are moved over first, so that they only ever live in the new array
+    if (mOldBucketArray != nullptr) {
+        migrate (pKeyHash & (mOldBucketCount - 1));
+    }
+
+    // find the bucket in which it should be insert into
+    bucketId        = pKeyHash & (mBucketCount - 1);
+
+    // the bucket counts its keys in 32 bits, so once it can not count another key, only a matching key is looked for (and visited)
+    if (mBucketArray[bucketId].keyCount >= sMaxBucketKeys) {
+        for (aggr_ptr_t aggrPtr = mBucketArray[bucketId].hashListHead; aggrPtr != nullptr; aggrPtr = aggrPtr->nextPtr) {
+            if (aggrPtr->keyHash != pKeyHash) {
+                continue;
+            }
+            for (nodePtr = aggrPtr->nodePtr; nodePtr != nullptr; nodePtr = nodePtr->nextPtr) {
+                if (pMatch (nodePtr->key)) {
+                    pVisit (nodePtr->key, false);
+                    break;
+                }
+            }
+            break;
+        }
+
+        return false;
+    }
+
+    // get a pointer to the pointer to the aggregate list's head
+    aggrElem        = &(mBucketArray[bucketId].hashListHead);
+
+    while ((*aggrElem) != nullptr) {
+
+        // if the current aggregate node's representative hash value matches with the key's hash value,
+        // try to insert the new key into it's linked list
+        if ((*aggrElem)->keyHash == pKeyHash) {
+            nodePtr         = insert_util (pMatch, pMake, &((*aggrElem)->nodePtr), insertionState, pKey);
+
+            if (nodePtr == nullptr) {
+                return false;
+            }
+
+            // the new node may have become the first one of the bucket's first aggregate node
+            sync_head (mBucketArray[bucketId]);
+
+            pVisit (nodePtr->key, insertionState);
+
+            // if the insertion was succesful, increment the key counters
+            if (insertionState) {
+                ++mKeyCount;
+                ++(*aggrElem)->keyCount;
+                ++mBucketArray[bucketId].keyCount;
+
+                // resize the table if the bucket has too many keys with different hashs
+                // dont resize in case the number of keys are > maximum allowed but all have the same hash, since
+                // this would still cause all the keys to fall in the same bucket, causing repeated resizing at every subsequent insert
+                if (should_grow (bucketId)) {
+
+                    // the bucket's lock must be released before resizing, since resizing takes every lock
+                    observedCount   = mBucketCount;
+                    MULTITHREADED_MODE (
+                    stripeLock.unlock ();
+                    )
+                    grow (observedCount);
+                }
+            }
+
+            return insertionState;
+        }
+
+        // go to the next aggregate node
+        aggrElem    = &((*aggrElem)->nextPtr);
+    }
+
+    // if the loop was completed but no position was found, an entirely new aggregate node needs to be created for
+    // this hash value
+
+    // create a new aggregate node (return failed insertion on failure)
+    newAggr         = mAggrPool.allocate ();
+    if (newAggr == nullptr) {
+        return false;
+    }
+    else {
+        DBG_MODE (
+        ++mAllocCnt;
+        mAllocAmt   += sizeof (aggregate_node_t);
+        )
+    }
+
+    // place the new node at the last position and try to insert the new key into it's linked list
+    new (newAggr) aggregate_node_t {nullptr, 0ULL, pKeyHash, nullptr};
+    (*aggrElem)     = newAggr;
+
+    // the aggregate node's list is empty, so the key can only fail to be inserted on allocation failure
+    nodePtr         = insert_util (pMatch, pMake, &((*aggrElem)->nodePtr), insertionState, pKey);
+
+    // if the insertion was successfull, increment the corresponding key counters
+    if (nodePtr != nullptr) {
+
+        // the new aggregate node is the bucket's first one if the bucket was empty
+        sync_head (mBucketArray[bucketId]);
+
+        pVisit (nodePtr->key, insertionState);
+
+        ++mKeyCount;
+        ++(*aggrElem)->keyCount;
+        ++mBucketArray[bucketId].keyCount;
+        ++mBucketArray[bucketId].distinctHashCount;
+        DBG_MODE (
+        ++mAggregateCnt;
+        )
+
+        // resize the table if the bucket has too many keys with different hashs
+        // dont resize in case the number of keys are > maximum allowed but all have the same hash, since
+        // this would still cause all the keys to fall in the same bucket, causing repeated resizing at every subsequent insert
+        if (should_grow (bucketId)) {
+
+            // the bucket's lock must be released before resizing, since resizing takes every lock
+            observedCount   = mBucketCount;
+            MULTITHREADED_MODE (
+            stripeLock.unlock ();
+            )
+            grow (observedCount);
+        }
+
+        return true;
+    }
+
+    // if the insertion failed, then remove the newly created aggregate node as well
+    // get it and set its predecessor's successor to it's successor
+    newAggr             = *aggrElem;
+    *aggrElem           = newAggr->nextPtr;
+
+    // destroy it and return it to its pool
+    newAggr->~aggregate_node_t ();
+    mAggrPool.deallocate (newAggr);
+
+    return false;
+}
+
+/**
+ * @brief                   Erases the key with the given hash which satisfies the given predicate
+ *
+ * @tparam match_t          Type of the predicate
+ *
+ * @param pKeyHash          Hash of the key to erase
+ * @param pMatch            Predicate which returns true for the stored key to erase (only called on keys with the same hash)
+ * @param pKey              Key being erased, used to skip nodes whose fingerprint differs (nullptr if the key is not at hand)
+ *
+ * @return true             If the key was successfully found and removed
+ * @return false            If the key could not be removed (no matching key was found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename match_t>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::erase_matching (const hash_t &pKeyHash, match_t pMatch, const key_t *pKey)
+{
+    uint64_t            bucketId;                                   /** Position of the bucket in which to insert the key */
+
+    aggr_ptr_t          *aggrElem;                                  /** Pointer to the new aggregate node's predecessor's next-pointer */
+    aggr_ptr_t          toRem;                                      /** Pointer to the aggregate node to be removed (only used in case the key was the only key with it's hash value) */
+
+    bool                eraseState;                                 /** Stores if erase_util could successfully erase the node from the aggregate node's linked list */
+    uint64_t            observedCount;                              /** Number of buckets at the time the decision to shrink was made */
+
+    // modifications need exclusive access to the bucket (the bucket array can not be resized while the lock is held)
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex>     stripeLock  {mLocks[get_lock_id (pKeyHash)]};
+    )
+
+    // during an incremental resize, the keys of the old bucket are moved over first, so that they only ever live in the new array
+    if (mOldBucketArray != nullptr) {
+        migrate (pKeyHash & (mOldBucketCount - 1));
+    }
+
+    // find the bucket in which it should be present
+    bucketId        = pKeyHash & (mBucketCount - 1);
+
+    // get a pointer to the pointer to the aggregate list's head
+    aggrElem        = &(mBucketArray[bucketId].hashListHead);
+
+    while ((*aggrElem) != nullptr) {
+
+        // if the current aggregate node's representative hash value matches with the key's hash value,
+        // try to insert the new key into it's linked list
+        if ((*aggrElem)->keyHash == pKeyHash) {
+            eraseState  = erase_util (pMatch, &((*aggrElem)->nodePtr), pKey);
+
+            // if successfully erased the key, decrement all key counters
+            if (eraseState) {
+                --mKeyCount;
+                --(*aggrElem)->keyCount;
+                --mBucketArray[bucketId].keyCount;
+
+                // if this aggregate node has no elements, delete it and decrement the number of distinct hashs in the bucket
+                if ((*aggrElem)->keyCount == 0) {
+
+                    --mBucketArray[bucketId].distinctHashCount;
+                    DBG_MODE (
+                    --mAggregateCnt;
+                    )
+
+                    // take the node out and put it's successor in it's place
+                    toRem           = *aggrElem;
+                    *aggrElem       = (*aggrElem)->nextPtr;
+
+                    // destroy it and return it to its pool
+                    toRem->~aggregate_node_t ();
+                    mAggrPool.deallocate (toRem);
+                }
+
+                // the erased node (or its aggregate node) may have been the first one of the bucket
+                sync_head (mBucketArray[bucketId]);
+
+                // shrink the table if too few keys are left for its buckets (only if its growth policy allows shrinking)
+                if (should_shrink ()) {
+
+                    // the bucket's lock must be released before resizing, since resizing takes every lock
+                    observedCount   = mBucketCount;
+                    MULTITHREADED_MODE (
+                    stripeLock.unlock ();
+                    )
+                    shrink (observedCount);
+                }
+            }
+            return eraseState;
+        }
+
+        // go to the next aggregate node
+        aggrElem    = &((*aggrElem)->nextPtr);
+    }
+
+    // if the loop was completed, but no aggregate node with matching representative hash value could be found,
+    // return failed erase
+    return false;
+}
+
+/**
+ * @brief                   Utility function to check if a key exists in an aggregate node's linked list
+ *
+ * @param pKey              Key to find
+ * @param pListElem         Linked list to search in
+ *
+ * @return true             If the key could successfully be found
+ * @return false            If the key could not be found
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::exists_util (const key_t &pKey, node_ptr_t pListElem) const
+{
+    fingerprint_t       fingerprint {};                             /** Fingerprint of the key (only computed if filtered is true) */
+    bool                filtered;                                   /** Stores if nodes are skipped by comparing fingerprints */
+
+    filtered        = fingerprint_list (&pKey, pListElem, fingerprint);
+
+    // iterator through all elements of the linked list
+    while (pListElem != nullptr) {
+
+        // if a matching key has been found, return successful find
+        if (!fingerprint_differs (pListElem, filtered, fingerprint) && tEquals (pKey, pListElem->key)) {
+            return true;
+        }
+
+        // go to the next node
+        pListElem   = pListElem->nextPtr;
+    }
+
+    // if no duplicate key could be found, return failed find
+    return false;
+}
+
+/**
+ * @brief                   Utility function to search for a key in an aggregate node's linked list and return an iterator to it (end() if no matching key is found)
+ *
+ * @tparam match_t          Type of the predicate
+ *
+ * @param pMatch            Predicate which returns true for the key being searched for
+ * @param pListElem         Linked list of the aggregate node (passed separately, since the bucket holds it for its first aggregate node)
+ * @param pAggrPtr          Aggregate node whose linked list is to be searched
+ * @param pBucketId         Position of the bucket which contains the aggregate node
+ * @param pKey              Key being searched for, used to skip nodes whose fingerprint differs (may be nullptr)
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename match_t>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::find_util (match_t &pMatch, node_ptr_t pListElem, aggr_ptr_t pAggrPtr, const uint64_t &pBucketId, const key_t *pKey) const
+{
+    fingerprint_t   fingerprint {};                 /** Fingerprint of the key (only computed if filtered is true) */
+    bool            filtered;                       /** Stores if nodes are skipped by comparing fingerprints */
+
+    filtered        = fingerprint_list (pKey, pListElem, fingerprint);
+
+    // iterator through all elements of the linked list
+    while (pListElem != nullptr) {
+
+        // if a matching key has been found, return successful find
+        if (!fingerprint_differs (pListElem, filtered, fingerprint) && pMatch (pListElem->key)) {
+            return iterator {pListElem, pAggrPtr, pBucketId, this};
+        }
+
+        // go to the next node
+        pListElem   = pListElem->nextPtr;
+    }
+
+    // if no duplicate key could be found, return failed find
+    return end ();
+}
+
+/**
+ * @brief                   Computes the fingerprint of a key if the nodes of a linked list should be filtered by it, which is only the
+ *                          case with AgChainedFingerprintLayout, when the key is known and when the list has more than one node (a
+ *                          single key is compared directly, which avoids computing the fingerprint at all)
+ *
+ * @param pKey              Key being searched for (may be nullptr, in which case nodes are not filtered)
+ * @param pListElem         Linked list to be searched
+ * @param pFingerprint      Set to the fingerprint of the key if nodes are to be filtered
+ *
+ * @return true             If nodes are to be filtered by their fingerprints
+ * @return false            If every node is to be compared
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::fingerprint_list (const key_t *pKey, node_ptr_t pListElem, fingerprint_t &pFingerprint) const
+{
+    if constexpr (sFingerprinted) {
+        if (pKey != nullptr && pListElem != nullptr && pListElem->nextPtr != nullptr) {
+            pFingerprint    = tLayout::sFingerprintFunc (pKey);
+            return true;
+        }
+    }
+
+    (void)pKey;
+    (void)pListElem;
+    (void)pFingerprint;
+
+    return false;
+}
+
+/**
+ * @brief                   Checks if a node can be skipped without comparing its key, since its fingerprint differs from the key's
+ *
+ * @param pNode             Node to check
+ * @param pFiltered         If nodes are being filtered (see fingerprint_list ())
+ * @param pFingerprint      Fingerprint of the key being searched for (only read if pFiltered is true)
+ *
+ * @return true             If the node does not hold the key
+ * @return false            If the node's key has to be compared
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::fingerprint_differs (node_ptr_t pNode, const bool &pFiltered, const fingerprint_t &pFingerprint)
+{
+    if constexpr (sFingerprinted) {
+        return pFiltered && (pNode->fingerprint != pFingerprint);
+    }
+    else {
+        (void)pNode;
+        (void)pFiltered;
+        (void)pFingerprint;
+
+        return false;
+    }
+}
+
+/**
+ * @brief                   Utility function to insert a key in an aggregate node's linked list, unless a matching key already exists
+ *
+ * @tparam match_t          Type of the predicate
+ * @tparam make_t           Type of the function which creates the key to insert
+ *
+ * @param pMatch            Predicate which returns true for a key equal to the one being inserted
+ * @param pMake             Function which returns the key to insert (only called if no matching key exists)
+ * @param pListElem         Linked list to insert the key into
+ * @param pInserted         Set to true if a new node was inserted, false otherwise
+ * @param pKey              Key being inserted, used to skip nodes whose fingerprint differs (may be nullptr)
+ *
+ * @return node_ptr_t       Pointer to the matching node or the newly inserted node (nullptr on allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename match_t, typename make_t>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::node_ptr_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::insert_util (match_t &pMatch, make_t &pMake, node_ptr_t *pListElem, bool &pInserted, const key_t *pKey)
+{
+    node_ptr_t          newNode;                                    /** Pointer to new node */
+    fingerprint_t       fingerprint {};                             /** Fingerprint of the key (only computed if filtered is true) */
+    bool                filtered;                                   /** Stores if nodes are skipped by comparing fingerprints */
+
+    pInserted       = false;
+    filtered        = fingerprint_list (pKey, *pListElem, fingerprint);
+
+    while ((*pListElem) != nullptr) {
+
+        // if a duplicate key is found to already exist, return it without inserting
+        if (!fingerprint_differs (*pListElem, filtered, fingerprint) && pMatch ((*pListElem)->key)) {
+            return *pListElem;
+        }
+
+        // go to the next node
+        pListElem       = &((*pListElem)->nextPtr);
+    }
+
+    // if the loop finished executing, no duplicate key exists, so try to insert this
+    // try to create a new node (return failed insertion on failure)
+    newNode         = mNodePool.allocate ();
+    if (newNode == nullptr) {
+        return nullptr;
+    }
+    else {
+        DBG_MODE (
+        ++mAllocCnt;
+        mAllocAmt   += sizeof (node_t);
+        )
+    }
+
+    // construct the node (with the key created directly inside it) and place it at the vacant position
+    if constexpr (sFingerprinted) {
+        new (newNode) node_t {nullptr, fingerprint, pMake ()};
+        if (!filtered) {
+            newNode->fingerprint    = tLayout::sFingerprintFunc (&(newNode->key));
+        }
+    }
+    else {
+        new (newNode) node_t {nullptr, pMake ()};
+    }
+    (*pListElem)    = newNode;
+
+    pInserted       = true;
+    return newNode;
+}
+
+/**
+ * @brief                   Utility function to erase a key from an aggregate node's linked list
+ *
+ * @tparam match_t          Type of the predicate
+ *
+ * @param pMatch            Predicate which returns true for the key to erase
+ * @param pListElem         Linked list to erase the key from
+ * @param pKey              Key being erased, used to skip nodes whose fingerprint differs (may be nullptr)
+ *
+ * @return true             If the key could successfully be erased
+ * @return false            If the key could not be erased
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename match_t>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::erase_util (match_t &pMatch, node_ptr_t *pListElem, const key_t *pKey)
+{
+    node_ptr_t          foundNode;                                  /** Pointer to node with matching key */
+    fingerprint_t       fingerprint {};                             /** Fingerprint of the key (only computed if filtered is true) */
+    bool                filtered;                                   /** Stores if nodes are skipped by comparing fingerprints */
+
+    filtered        = fingerprint_list (pKey, *pListElem, fingerprint);
+
+    while ((*pListElem) != nullptr) {
+
+        // if a node is found with matching key, erase it
+        if (!fingerprint_differs (*pListElem, filtered, fingerprint) && pMatch ((*pListElem)->key)) {
+
+            // take the current node out and set it's predecessor's successor to it's successor
+            foundNode           = *pListElem;
+            *pListElem          = foundNode->nextPtr;
+
+            // destroy it and return it to its pool
+            foundNode->~node_t ();
+            mNodePool.deallocate (foundNode);
+
+            DBG_MODE (
+            ++mDeleteCnt;
+            mAllocAmt           -= sizeof (node_t);
+            )
+
+            return true;
+        }
+
+        // go to the next node
+        pListElem   = &((*pListElem)->nextPtr);
+    }
+
+    // if no matching key could be found, return failed erase
+    return false;
+}
+
+/**
+ * @brief                   Resizes the hash table to have the supplied number of buckets
+ *
+ *                          Creates a new array of buckets of the specified size and moves aggregate nodes from
+ *                          the old bucket array to the new one, after which the old array is deleted
+ *                          Every aggregate node is placed using the hash stored in it, so no key is hashed again (or even touched)
+ *                          While growing, the old buckets may be split across several threads (see set_rehash_threads ())
+ *
+ * @param pNumBuckets       Number of buckets the hash table be resized to
+ * @param pThreadCount      Number of threads to split the old buckets across while growing (fewer are used for small tables)
+ *
+ * @return true             If the hash table could be resized successfully
+ * @return false            If the hash table could not be resized successfully (allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::resize (const uint64_t &pNumBuckets, const uint64_t &pThreadCount)
+{
+    bucket_ptr_t        newArray;                                   /** New array of buckets to use */
+    uint64_t            threadCount;                                /** Number of threads the old buckets are split across */
+
+    DBG_MODE (
+    ++mResizeCnt;
+    )
+
+    // allocate the new array (return failed resize in case of failure)
+    newArray        = new (std::nothrow) bucket_t[pNumBuckets];
+    if (newArray == nullptr) {
+        DBG_MODE (
+        std::cout << "Allocation of new bucket array failed while resizing" << std::endl;
+        std::cout << "Present Size: " << mBucketCount << std::endl;
+        std::cout << "Target Size: " << pNumBuckets << std::endl;
+        )
+
+        return false;
+    }
+    else {
+        DBG_MODE (
+        ++mAllocCnt;
+        mAllocAmt       += sizeof (bucket_t) * pNumBuckets;
+        )
+    }
+
+    // while growing, every new bucket receives aggregate nodes from a single old bucket (the one at its position modulo the number of old
+    // buckets), so contiguous ranges of old buckets can be moved by separate threads without any synchronization
+    threadCount     = (pNumBuckets > mBucketCount) ? (pThreadCount) : (1ULL);
+    threadCount     = (threadCount < mBucketCount / sMinBucketsPerThread) ? (threadCount) : (mBucketCount / sMinBucketsPerThread);
+
+    if (threadCount <= 1ULL) {
+        move_buckets (newArray, pNumBuckets, 0ULL, mBucketCount);
+    }
+    else {
+        std::thread     workers[sMaxRehashThreads];                 /** Threads moving every range but the first */
+
+        // the calling thread moves the first range itself, and any range whose thread could not be started
+        for (uint64_t threadId = 1; threadId < threadCount; ++threadId) {
+            try {
+                workers[threadId]   = std::thread {&AgHashTable::move_buckets, this, newArray, pNumBuckets,
+                                                   mBucketCount * threadId / threadCount, mBucketCount * (threadId + 1) / threadCount};
+            }
+            catch (const std::system_error &) {
+                move_buckets (newArray, pNumBuckets, mBucketCount * threadId / threadCount, mBucketCount * (threadId + 1) / threadCount);
+            }
+        }
+
+        move_buckets (newArray, pNumBuckets, 0ULL, mBucketCount / threadCount);
+
+        for (uint64_t threadId = 1; threadId < threadCount; ++threadId) {
+            if (workers[threadId].joinable ()) {
+                workers[threadId].join ();
+            }
+        }
+    }
+
+    // delete the old bucket array (which should not have any aggregate nodes left)
+    delete[] mBucketArray;
+    DBG_MODE (
+    ++mDeleteCnt;
+    mAllocAmt       -= sizeof (bucket_t) * mBucketCount;
+    )
+
+    // make the current bucket array point to the new array and update the bucket count
+    mBucketArray    = newArray;
+    mBucketCount    = pNumBuckets;
+
+    return true;
+}
+
+/**
+ * @brief                   Moves the aggregate nodes of a range of buckets of the present bucket array to the front of their buckets in
+ *                          a new array (so every node is placed in constant time, however crowded its new bucket is)
+ *
+ * @param pArray            New bucket array
+ * @param pCount            Number of buckets in the new array
+ * @param pBegin            Position of the first old bucket to move
+ * @param pEnd              Position after the last old bucket to move
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::move_buckets (bucket_ptr_t pArray, const uint64_t &pCount, const uint64_t &pBegin, const uint64_t &pEnd)
+{
+    aggr_ptr_t          aggrPtr;                                    /** Aggregate node being moved */
+    uint64_t            newPosition;                                /** Position of the aggregate node's bucket in the new array */
+
+    for (uint64_t bucketId = pBegin; bucketId < pEnd; ++bucketId) {
+
+        // the first aggregate node of a bucket a few positions ahead is fetched while this one is being moved
+        if (bucketId + sResizePrefetchDistance < pEnd) {
+            ag_prefetch (mBucketArray[bucketId + sResizePrefetchDistance].hashListHead);
+        }
+
+        while (mBucketArray[bucketId].hashListHead != nullptr) {
+
+            // take the aggregate node out of the old bucket
+            aggrPtr                                 = mBucketArray[bucketId].hashListHead;
+            mBucketArray[bucketId].hashListHead     = aggrPtr->nextPtr;
+
+            // and place it at the front of its new bucket
+            newPosition                             = aggrPtr->keyHash & (pCount - 1);
+            push_aggregate (pArray[newPosition], aggrPtr);
+        }
+    }
+}
+
+/**
+ * @brief                   Places an aggregate node at the front of a bucket, incrementing the bucket's distinct hash and key counts
+ *
+ *                          The aggregate node becomes the bucket's first one, so its hash and list are copied into the bucket as well
+ *
+ * @param pBucket           Bucket to place the aggregate node in
+ * @param pAggrPtr          Aggregate node to place (its list of nodes must already be set)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::push_aggregate (bucket_t &pBucket, aggr_ptr_t pAggrPtr)
+{
+    pAggrPtr->nextPtr       = pBucket.hashListHead;
+
+    pBucket.hashListHead    = pAggrPtr;
+    pBucket.headHash        = pAggrPtr->keyHash;
+    pBucket.headNode        = pAggrPtr->nodePtr;
+    // the bucket's keys all come from a single bucket when growing, and shrinking is refused when the table holds more than
+    // sMaxBucketKeys keys (see rehash_util ()), so the sum always fits
+    pBucket.keyCount        += static_cast<uint32_t> (pAggrPtr->keyCount);
+    ++pBucket.distinctHashCount;
+}
+
+/**
+ * @brief                   Copies the hash and list of a bucket's first aggregate node into the bucket, after the bucket's aggregate
+ *                          list or the first aggregate node's list of nodes has been modified
+ *
+ * @param pBucket           Bucket to update
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::sync_head (bucket_t &pBucket)
+{
+    if (pBucket.hashListHead != nullptr) {
+        pBucket.headHash    = pBucket.hashListHead->keyHash;
+        pBucket.headNode    = pBucket.hashListHead->nodePtr;
+    }
+    else {
+        pBucket.headHash    = hash_t {};
+        pBucket.headNode    = nullptr;
+    }
+}
+
+/**
+ * @brief                   Checks if a bucket holds enough keys (with enough distinct hashes) for the table to grow, according to its
+ *                          growth policy
+ *
+ *                          Buckets whose keys all have the same hash never trigger growth, since they would still be in the same
+ *                          bucket after growing, which would cause repeated growing at every subsequent insert
+ *
+ * @param pBucketId         Position of the bucket in the current bucket array
+ *
+ * @return true             If the table should grow
+ * @return false            If the table should not grow (or can not grow any further)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::should_grow (const uint64_t &pBucketId) const
+{
+    return (mBucketArray[pBucketId].distinctHashCount > mGrowth.numDistinctAllowed)
+           && (mBucketArray[pBucketId].keyCount > mGrowth.numKeysAllowed)
+           && (mBucketCount < get_max_bucket_count ());
+}
+
+/**
+ * @brief                   Grows the hash table by the resize factor of its growth policy, unless it has already been grown since the given
+ *                          bucket count was observed
+ *
+ *                          Must be called without holding any of the table's locks
+ *
+ * @param pObservedCount    Number of buckets at the time the decision to grow was made
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::grow (const uint64_t &pObservedCount)
+{
+    uint64_t            newCount;                                   /** Number of buckets to grow to */
+
+    MULTITHREADED_MODE (
+    lock_all ();
+    )
+
+    // another thread might have grown the table after the decision was made, in which case there is nothing left to do
+    if (mBucketCount == pObservedCount) {
+
+        // the last step is cut short, so that the table ends up with exactly the maximum number of buckets
+        newCount    = pObservedCount * mGrowth.resizeFactor;
+        newCount    = (newCount < get_max_bucket_count ()) ? (newCount) : (get_max_bucket_count ());
+
+        if (!mIncremental) {
+            resize (newCount, (mParallelGrowth) ? (mRehashThreads) : (1ULL));
+        }
+        // a new incremental resize can only be started once the previous one has migrated every bucket
+        else if (mOldBucketArray == nullptr) {
+            start_migration (newCount);
+        }
+    }
+
+    MULTITHREADED_MODE (
+    unlock_all ();
+    )
+}
+
+/**
+ * @brief                   Returns the number of keys per bucket a table with the given growth policy is sized for by reserve (),
+ *                          rehash () and shrinking
+ *
+ *                          An eighth of the keys allowed per bucket, so that buckets are well clear of triggering growth
+ *
+ * @param pGrowth           Growth policy of the table
+ *
+ * @return uint64_t         Number of keys per bucket (atleast 1)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::target_load (const AgGrowthPolicy &pGrowth)
+{
+    return (pGrowth.numKeysAllowed < 8ULL) ? (1ULL) : (pGrowth.numKeysAllowed / 8ULL);
+}
+
+/**
+ * @brief                   Returns the fewest buckets (a power of 2) which hold the given number of keys at the target load
+ *
+ *                          The result is never more than the maximum number of buckets, and never fewer than the number of locks
+ *                          (keys in the same bucket must map to the same lock)
+ *
+ * @param pKeyCount         Number of keys
+ *
+ * @return uint64_t         Number of buckets
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::bucket_count_for (const uint64_t &pKeyCount) const
+{
+    uint64_t            load;                                       /** Number of keys per bucket */
+    uint64_t            count       {1ULL};                         /** Number of buckets */
+
+    load            = target_load (mGrowth);
+
+    MULTITHREADED_MODE (
+    count           = mLockCount;
+    )
+
+    while ((count * load < pKeyCount) && (count < get_max_bucket_count ())) {
+        count       <<= 1;
+    }
+
+    return count;
+}
+
+/**
+ * @brief                   Checks if the table holds few enough keys for its buckets to shrink, according to its growth policy
+ *
+ *                          A table which is in the middle of an incremental resize does not shrink until the resize is finished, and
+ *                          a table with more keys than a bucket can count does not shrink at all (see rehash_util ())
+ *
+ * @return true             If the table should shrink
+ * @return false            If the table should not shrink (or can not shrink any further)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::should_shrink () const
+{
+    return (mGrowth.shrinkLoadPercent != 0ULL)
+           && (mOldBucketArray == nullptr)
+           && (mKeyCount <= sMaxBucketKeys)
+           && (mKeyCount * 100ULL < mBucketCount * mGrowth.shrinkLoadPercent)
+           && (bucket_count_for (mKeyCount) < mBucketCount);
+}
+
+/**
+ * @brief                   Shrinks the hash table to the number of buckets which holds its keys at the target load, unless it has
+ *                          already been resized since the given bucket count was observed
+ *
+ *                          Must be called without holding any of the table's locks
+ *
+ * @param pObservedCount    Number of buckets at the time the decision to shrink was made
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::shrink (const uint64_t &pObservedCount)
+{
+    MULTITHREADED_MODE (
+    lock_all ();
+    )
+
+    // another thread might have resized the table (or inserted keys) after the decision was made, so the decision is made again
+    if ((mBucketCount == pObservedCount) && should_shrink ()) {
+
+        if (!mIncremental) {
+            resize (bucket_count_for (mKeyCount));
+        }
+        else {
+            start_migration (bucket_count_for (mKeyCount));
+        }
+    }
+
+    MULTITHREADED_MODE (
+    unlock_all ();
+    )
+}
+
+/**
+ * @brief                   Resizes the hash table to the given number of buckets at once (finishing any incremental resize in progress)
+ *
+ *                          Must be called without holding any of the table's locks
+ *
+ * @param pNumBuckets       Number of buckets to resize to (power of 2)
+ * @param pShrink           If the table may end up with fewer buckets than it has (otherwise a smaller count leaves it as it is)
+ *
+ * @return true             If the table was resized (or already had the given number of buckets)
+ * @return false            If the table could not be resized (allocation failure, or shrinking a table with more than sMaxBucketKeys keys)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::rehash_util (const uint64_t &pNumBuckets, const bool &pShrink)
+{
+    bool                resized     {true};                         /** Stores if the table could be resized */
+
+    MULTITHREADED_MODE (
+    lock_all ();
+    )
+
+    if (mOldBucketArray != nullptr) {
+        while (mMigratePos < mOldBucketCount) {
+            migrate_bucket (mMigratePos++);
+        }
+        finish_migration ();
+    }
+
+    // growing only ever splits buckets, but shrinking merges them, which could overflow the key count of a bucket if the table
+    // holds more keys than a bucket can count
+    if (pShrink && (mBucketCount > pNumBuckets) && (mKeyCount > sMaxBucketKeys)) {
+        resized     = false;
+    }
+    else if ((mBucketCount < pNumBuckets) || (pShrink && (mBucketCount > pNumBuckets))) {
+        resized     = resize (pNumBuckets, mRehashThreads);
+    }
+
+    MULTITHREADED_MODE (
+    unlock_all ();
+    )
+
+    return resized;
+}
+
+/**
+ * @brief                   Starts an incremental resize, by allocating a new bucket array of the supplied size (no keys are moved yet)
+ *
+ * @param pNumBuckets       Number of buckets the hash table be resized to
+ *
+ * @return true             If the incremental resize could be started
+ * @return false            If the incremental resize could not be started (allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::start_migration (const uint64_t &pNumBuckets)
+{
+    bucket_ptr_t        newArray;                                   /** New array of buckets to use */
+
+    DBG_MODE (
+    ++mResizeCnt;
+    )
+
+    // allocate the new array (return failed resize in case of failure)
+    newArray        = new (std::nothrow) bucket_t[pNumBuckets];
+    if (newArray == nullptr) {
+        DBG_MODE (
+        std::cout << "Allocation of new bucket array failed while resizing" << std::endl;
+        std::cout << "Present Size: " << mBucketCount << std::endl;
+        std::cout << "Target Size: " << pNumBuckets << std::endl;
+        )
+
+        return false;
+    }
+    else {
+        DBG_MODE (
+        ++mAllocCnt;
+        mAllocAmt       += sizeof (bucket_t) * pNumBuckets;
+        )
+    }
+
+    // keep the current array around until all of its buckets have been migrated
+    mOldBucketArray = mBucketArray;
+    mOldBucketCount = mBucketCount;
+    mMigratePos     = 0ULL;
+
+    mBucketArray    = newArray;
+    mBucketCount    = pNumBuckets;
+
+    return true;
+}
+
+/**
+ * @brief                   Performs one step of an incremental resize
+ *
+ *                          Migrates the given old bucket (the one the current operation is about to use), followed by the next
+ *                          sMigrateStep buckets of the sweep, and finishes the resize once the sweep reaches the end of the old array
+ *
+ * @param pOldBucketId      Position of the old bucket the current operation is about to use
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::migrate (const uint64_t &pOldBucketId)
+{
+    migrate_bucket (pOldBucketId);
+
+    for (uint64_t step = 0; (step < sMigrateStep) && (mMigratePos < mOldBucketCount); ++step) {
+        migrate_bucket (mMigratePos++);
+    }
+
+    if (mMigratePos == mOldBucketCount) {
+        finish_migration ();
+    }
+}
+
+/**
+ * @brief                   Moves every aggregate node of the given old bucket into the new bucket array
+ *
+ *                          Aggregate nodes are placed at the front of their new buckets (using the hash stored in them, so no key is
+ *                          hashed again), since the order of aggregate nodes within a bucket does not matter
+ *
+ * @param pOldBucketId      Position of the bucket in the old array
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::migrate_bucket (const uint64_t &pOldBucketId)
+{
+    bucket_t            &oldBucket  = mOldBucketArray[pOldBucketId];    /** Bucket being migrated */
+    aggr_ptr_t          aggrPtr;                                        /** Aggregate node being moved */
+    uint64_t            newPosition;                                    /** Position of the aggregate node's bucket in the new array */
+
+    while (oldBucket.hashListHead != nullptr) {
+
+        // take the aggregate node out of the old bucket
+        aggrPtr                 = oldBucket.hashListHead;
+        oldBucket.hashListHead  = aggrPtr->nextPtr;
+
+        // and place it at the front of its new bucket
+        newPosition             = aggrPtr->keyHash & (mBucketCount - 1);
+        push_aggregate (mBucketArray[newPosition], aggrPtr);
+    }
+
+    oldBucket   = bucket_t {};
+}
+
+/**
+ * @brief                   Deletes the old bucket array once every one of its buckets has been migrated
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::finish_migration ()
+{
+    delete[] mOldBucketArray;
+    DBG_MODE (
+    ++mDeleteCnt;
+    mAllocAmt       -= sizeof (bucket_t) * mOldBucketCount;
+    )
+
+    mOldBucketArray = nullptr;
+    mOldBucketCount = 0ULL;
+    mMigratePos     = 0ULL;
+}
+
+/**
+ * @brief                   Destroys every key of the table and deletes its bucket arrays and locks, leaving it without any buckets
+ *                          (initialized () returns false for it afterwards)
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::release ()
+{
+    // destroy every node in both arrays (if an incremental resize was in progress, the old one still holds keys) and delete them
+    destroy_all ();
+    delete[] mBucketArray;
+    delete[] mOldBucketArray;
+
+    MULTITHREADED_MODE (
+    delete[] mLocks;
+    mLocks          = nullptr;
+    mLockCount      = 0ULL;
+    )
+
+    mBucketArray    = nullptr;
+    mBucketCount    = 0ULL;
+    mKeyCount       = 0ULL;
+
+    mOldBucketArray = nullptr;
+    mOldBucketCount = 0ULL;
+    mMigratePos     = 0ULL;
+}
+
+/**
+ * @brief                   Destroys every node and aggregate node in the table (in both bucket arrays during an incremental resize)
+ *
+ *                          With pools which can release all of their storage at once, the nodes are not returned one at a time, and
+ *                          are not even visited if their keys need not be destroyed, so the buckets are left pointing to released
+ *                          storage (they must be reset or deleted by the caller)
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::destroy_all ()
+{
+    if constexpr (node_pool_t::sBulkRelease && aggr_pool_t::sBulkRelease) {
+        if constexpr (!std::is_trivially_destructible<node_t>::value) {
+            destroy_keys (mBucketArray, mBucketCount);
+            destroy_keys (mOldBucketArray, mOldBucketCount);
+        }
+
+        mNodePool.release_all ();
+        mAggrPool.release_all ();
+    }
+    else {
+        destroy_buckets (mBucketArray, mBucketCount);
+        destroy_buckets (mOldBucketArray, mOldBucketCount);
+    }
+}
+
+/**
+ * @brief                   Destroys every node and aggregate node in the given bucket array, returning them to their pools
+ *
+ *                          The bucket array itself is not deleted
+ *
+ * @param pArray            Pointer to the bucket array (nothing is done if nullptr)
+ * @param pCount            Number of buckets in the array
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::destroy_buckets (bucket_ptr_t pArray, const uint64_t &pCount)
+{
+    aggr_ptr_t          aggrPtr;                                    /** Aggregate node being destroyed */
+    aggr_ptr_t          nextAggr;                                   /** Aggregate node after the one being destroyed */
+    node_ptr_t          nodePtr;                                    /** Node being destroyed */
+    node_ptr_t          nextNode;                                   /** Node after the one being destroyed */
+
+    if (pArray == nullptr) {
+        return;
+    }
+
+    for (uint64_t bucketId = 0; bucketId < pCount; ++bucketId) {
+
+        aggrPtr     = pArray[bucketId].hashListHead;
+
+        while (aggrPtr != nullptr) {
+
+            nodePtr     = aggrPtr->nodePtr;
+
+            while (nodePtr != nullptr) {
+                nextNode    = nodePtr->nextPtr;
+
+                nodePtr->~node_t ();
+                mNodePool.deallocate (nodePtr);
+
+                nodePtr     = nextNode;
+            }
+
+            nextAggr    = aggrPtr->nextPtr;
+
+            aggrPtr->~aggregate_node_t ();
+            mAggrPool.deallocate (aggrPtr);
+
+            aggrPtr     = nextAggr;
+        }
+
+        pArray[bucketId]    = bucket_t {};
+    }
+}
+
+/**
+ * @brief                   Destroys every node in the given bucket array without returning them to their pool (the storage is released
+ *                          along with the whole pool)
+ *
+ * @param pArray            Pointer to the bucket array (nothing is done if nullptr)
+ * @param pCount            Number of buckets in the array
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::destroy_keys (bucket_ptr_t pArray, const uint64_t &pCount)
+{
+    aggr_ptr_t          aggrPtr;                                    /** Aggregate node whose nodes are being destroyed */
+    node_ptr_t          nodePtr;                                    /** Node being destroyed */
+    node_ptr_t          nextNode;                                   /** Node after the one being destroyed */
 
-        // set its successor to NULL and delete it
-        newAggr->nextPtr    = nullptr;
-        delete newAggr;
+    if (pArray == nullptr) {
+        return;
     }
 
-    return insertionState;
+    for (uint64_t bucketId = 0; bucketId < pCount; ++bucketId) {
+        for (aggrPtr = pArray[bucketId].hashListHead; aggrPtr != nullptr; aggrPtr = aggrPtr->nextPtr) {
+            for (nodePtr = aggrPtr->nodePtr; nodePtr != nullptr; nodePtr = nextNode) {
+                nextNode    = nodePtr->nextPtr;
+                nodePtr->~node_t ();
+            }
+        }
+    }
 }
 
 /**
- * @brief                   Attempts to erase a given key from the hash table
+ * @brief                   Copies every aggregate node of a list (along with its nodes, in the same order) into the buckets of another
+ *                          array, placing each one using the hash stored in it
  *
- * @param pKey              Key to erase
+ *                          Everything copied is linked into the array as soon as it is created, so destroy_buckets () can release a
+ *                          partial copy
  *
- * @return true             If the key was successfully found and removed
- * @return false            If the key could not be removed (no matching key was found)
+ * @param pSource           Head of the aggregate node list to copy
+ * @param pArray            Bucket array to copy into
+ * @param pCount            Number of buckets in the array
+ *
+ * @return true             If every aggregate node and node was copied
+ * @return false            If an aggregate node or node could not be allocated
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 bool
-AgHashTable<key_t, tHashFunc, tEquals>::erase (const key_t &pKey)
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::copy_aggregates (aggr_ptr_t pSource, bucket_ptr_t pArray, const uint64_t &pCount)
 {
-    hash_t              keyHash;                                    /** Hash value of the key */
-    uint64_t            bucketId;                                   /** Position of the bucket in which to insert the key */
-
-    aggr_ptr_t          *aggrElem;                                  /** Pointer to the new aggregate node's predecessor's next-pointer */
-    aggr_ptr_t          toRem;                                      /** Pointer to the aggregate node to be removed (only used in case the key was the only key with it's hash value) */
-
-    bool                eraseState;                                 /** Stores if erase_util could successfully erase the node from the aggregate node's linked list */
+    aggr_ptr_t          newAggr;                                    /** Copy of the aggregate node */
+    node_ptr_t          nodePtr;                                    /** Node being copied */
+    node_ptr_t          *nodeElem;                                  /** Pointer to the next-pointer the next copied node is linked to */
+    uint64_t            newPosition;                                /** Position of the aggregate node's bucket in the array */
 
-    // calculate the hash value of the key and find the bucket in which it should be insert into
-    keyHash         = tHashFunc (&pKey);
-    bucketId        = keyHash & (mBucketCount - 1);
+    for (; pSource != nullptr; pSource = pSource->nextPtr) {
 
-    // get a pointer to the pointer to the aggregate list's head
-    aggrElem        = &(mBucketArray[bucketId].hashListHead);
+        newAggr     = mAggrPool.allocate ();
+        if (newAggr == nullptr) {
+            return false;
+        }
 
-    while ((*aggrElem) != nullptr) {
+        DBG_MODE (
+        ++mAllocCnt;
+        mAllocAmt   += sizeof (aggregate_node_t);
+        )
 
-        // if the current aggregate node's representative hash value matches with the key's hash value,
-        // try to insert the new key into it's linked list
-        if ((*aggrElem)->keyHash == keyHash) {
-            eraseState  = erase_util (pKey, &((*aggrElem)->nodePtr));
+        // the copy is placed at the front of its bucket (the order of aggregate nodes within a bucket does not matter)
+        newPosition = pSource->keyHash & (pCount - 1);
+        new (newAggr) aggregate_node_t {nullptr, pSource->keyCount, pSource->keyHash, nullptr};
+        push_aggregate (pArray[newPosition], newAggr);
 
-            // if successfully erased the key, decrement all key counters
-            if (eraseState) {
-                --mKeyCount;
-                --(*aggrElem)->keyCount;
-                --mBucketArray[bucketId].keyCount;
+        nodeElem    = &(newAggr->nodePtr);
 
-                // if this aggregate node has no elements, delete it and decrement the number of distinct hashs in the bucket
-                if ((*aggrElem)->keyCount == 0) {
+        for (nodePtr = pSource->nodePtr; nodePtr != nullptr; nodePtr = nodePtr->nextPtr) {
 
-                    --mBucketArray[bucketId].distinctHashCount;
-                    DBG_MODE (
-                    --mAggregateCnt;
-                    )
+            *nodeElem   = mNodePool.allocate ();
+            if (*nodeElem == nullptr) {
+                return false;
+            }
 
-                    // take the node out and put it's successor in it's place
-                    toRem           = *aggrElem;
-                    *aggrElem       = (*aggrElem)->nextPtr;
+            DBG_MODE (
+            ++mAllocCnt;
+            mAllocAmt   += sizeof (node_t);
+            )
 
-                    // set it's successor to NULL (to avoid recursive deletion)
-                    toRem->nextPtr  = nullptr;
+            // the key (and its fingerprint) are copied as they are
+            new (*nodeElem) node_t {*nodePtr};
+            (*nodeElem)->nextPtr    = nullptr;
 
-                    // delete it
-                    delete toRem;
-                }
-            }
-            return eraseState;
+            nodeElem    = &((*nodeElem)->nextPtr);
         }
 
-        // go to the next aggregate node
-        aggrElem    = &((*aggrElem)->nextPtr);
+        pArray[newPosition].headNode    = newAggr->nodePtr;
     }
 
-    // if the loop was completed, but no aggregate node with matching representative hash value could be found,
-    // return failed erase
-    return false;
+    return true;
 }
 
 /**
- * @brief                   Utility function to check if a key exists in an aggregate node's linked list
- *
- * @param pKey              Key to find
- * @param pListElem         Linked list to search in
+ * @brief                   Exchanges the values of two counters
  *
- * @return true             If the key could successfully be found
- * @return false            If the key could not be found
+ * @param pFirst            First counter
+ * @param pSecond           Second counter
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-bool
-AgHashTable<key_t, tHashFunc, tEquals>::exists_util (const key_t &pKey, node_ptr_t pListElem) const
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::swap_counter (counter_t &pFirst, counter_t &pSecond) noexcept
 {
-    // iterator through all elements of the linked list
-    while (pListElem != nullptr) {
+    uint64_t            temp;                                       /** Value of the first counter */
 
-        // if a matching key has been found, return successful find
-        if (tEquals (pKey, pListElem->key)) {
-            return true;
-        }
-
-        // go to the next node
-        pListElem   = pListElem->nextPtr;
-    }
-
-    // if no duplicate key could be found, return failed find
-    return false;
+    temp            = pFirst;
+    pFirst          = (uint64_t)pSecond;
+    pSecond         = temp;
 }
 
 /**
- * @brief                   Utility function to search for a key in an aggregate node's linked list and return an iterator to it (end() if no matching key is found)
+ * @brief                   Looks up every key of an array in a software pipeline, calling the given function with the aggregate node of each key
  *
- * @param pKey              Key to find
- * @param pListElem         Linked list to search in
+ *                          Keys are split into groups of sBatchWidth, and each lookup is split into sBatchStages stages (hashing and
+ *                          prefetching the bucket, reading the bucket and prefetching its first aggregate node, finding the aggregate
+ *                          node with the key's hash and prefetching its first node, comparing the keys)
+ *                          Every step runs a different stage on each of sBatchStages consecutive groups, so the memory prefetched
+ *                          for a group has a whole step to arrive before the group's next stage uses it
  *
- * @return true             If the key could successfully be found
- * @return false            If the key could not be found
+ * @tparam resolve_t        Type of the function called for every key
+ *
+ * @param pKeys             Pointer to the array of keys
+ * @param pCount            Number of keys in the array
+ * @param pResolve          Function called (in order) with the position of each key, the aggregate node with its hash (nullptr if
+ *                          there is none) and the position of its bucket
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-typename AgHashTable<key_t, tHashFunc, tEquals>::iterator
-AgHashTable<key_t, tHashFunc, tEquals>::find_util (const key_t &pKey, aggr_ptr_t pAggrPtr) const
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+template <typename resolve_t>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::lookup_batch (const key_t *pKeys, const uint64_t &pCount, resolve_t pResolve) const
 {
-    node_ptr_t      pListElem;                      /** Pointer to nodes in the linked list (used while iterating over the linked list to find a matching key) */
+    hash_t              hashes[sBatchStages][sBatchWidth];          /** Hash values of the keys of the groups in flight */
+    aggr_ptr_t          aggrs[sBatchStages][sBatchWidth];           /** Aggregate nodes of the keys of the groups in flight */
+    uint64_t            bucketIds[sBatchStages][sBatchWidth];       /** Positions of the buckets of the keys of the groups in flight */
 
-    pListElem       = pAggrPtr->nodePtr;
+    uint64_t            groupCount;                                 /** Number of groups */
+    uint64_t            groupId;                                    /** Group which a stage is run on */
+    uint64_t            slot;                                       /** Position of the group's state in the arrays above */
 
-    // iterator through all elements of the linked list
-    while (pListElem != nullptr) {
+    // returns the number of keys in a group (the last group may be smaller than the others)
+    auto                group_size  = [pCount] (const uint64_t &pGroupId) {
+        return ((pCount - pGroupId * sBatchWidth) < sBatchWidth) ? (pCount - pGroupId * sBatchWidth) : (sBatchWidth);
+    };
 
-        // if a matching key has been found, return successful find
-        if (tEquals (pKey, pListElem->key)) {
-            return iterator {pListElem, pAggrPtr, this};
+    groupCount      = (pCount + sBatchWidth - 1) / sBatchWidth;
+
+    // step i runs the first stage on group i, the second on group i - 1 and so on (skipping groups which do not exist)
+    for (uint64_t step = 0; step < groupCount + sBatchStages - 1; ++step) {
+
+        if (step < groupCount) {
+            groupId     = step;
+            slot        = groupId % sBatchStages;
+            prefetch_batch (pKeys + groupId * sBatchWidth, group_size (groupId), hashes[slot]);
         }
 
-        // go to the next node
-        pListElem   = pListElem->nextPtr;
-    }
+        if ((step >= 1) && (step - 1 < groupCount)) {
+            groupId     = step - 1;
+            slot        = groupId % sBatchStages;
+            head_batch (hashes[slot], group_size (groupId), aggrs[slot], bucketIds[slot]);
+        }
 
-    // if no duplicate key could be found, return failed find
-    return end ();
+        if ((step >= 2) && (step - 2 < groupCount)) {
+            groupId     = step - 2;
+            slot        = groupId % sBatchStages;
+            match_batch (hashes[slot], group_size (groupId), aggrs[slot]);
+        }
+
+        if (step >= 3) {
+            groupId     = step - 3;
+            slot        = groupId % sBatchStages;
+
+            for (uint64_t keyId = 0; keyId < group_size (groupId); ++keyId) {
+                pResolve (groupId * sBatchWidth + keyId, aggrs[slot][keyId], bucketIds[slot][keyId]);
+            }
+        }
+    }
 }
 
 /**
- * @brief                   Utility function to insert a key in an aggregate node's linked list
- *
- * @param pKey              Key to insert
- * @param pKeyHash          Hash of the given key
- * @param pListElem         Linked list to insert the key into
+ * @brief                   First stage of the batched operations, calculates the hash of every key of a group and prefetches their buckets
  *
- * @return true             If the key could successfully be inserted
- * @return false            If the key could not be inserted
+ * @param pKeys             Pointer to the keys of the group
+ * @param pCount            Number of keys in the group (atmost sBatchWidth)
+ * @param pHashes           Pointer to the array to write the hashes into
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-bool
-AgHashTable<key_t, tHashFunc, tEquals>::insert_util (const key_t &pKey, node_ptr_t *pListElem)
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::prefetch_batch (const key_t *pKeys, const uint64_t &pCount, hash_t *pHashes) const
 {
-    node_ptr_t          newNode;                                    /** Pointer to new node */
-
-    while ((*pListElem) != nullptr) {
+    ag_bucket_hash_keys<key_t, tHashFunc> (pKeys, pCount, pHashes);
 
-        // if a duplicate key is found to already exist, return failed insertion
-        if (tEquals (pKey, (*pListElem)->key)) {
-            return false;
-        }
+    for (uint64_t keyId = 0; keyId < pCount; ++keyId) {
 
-        // go to the next node
-        pListElem       = &((*pListElem)->nextPtr);
-    }
+        ag_prefetch (&mBucketArray[pHashes[keyId] & (mBucketCount - 1)]);
 
-    // if the loop finished executing, no duplicate key exists, so try to insert this
-    // try to create a new node (return failed insertion on failure)
-    newNode         = new (std::nothrow) node_t {nullptr, pKey};
-    if (newNode == nullptr) {
-        return false;
-    }
-    else {
-        DBG_MODE (
-        ++mAllocCnt;
-        mAllocAmt   += sizeof (node_t);
-        )
+        // during an incremental resize, the key might still be in the old array
+        if (mOldBucketArray != nullptr) {
+            ag_prefetch (&mOldBucketArray[pHashes[keyId] & (mOldBucketCount - 1)]);
+        }
     }
-
-    // place the new node at the vacant position
-    (*pListElem)    = newNode;
-
-    return true;
 }
 
 /**
- * @brief                   Utility function to erase a key from an aggregate node's linked list
- *
- * @param pKey              Key to erase
- * @param pKeyHash          Hash of the given key
- * @param pListElem         Linked list to erase the key from
+ * @brief                   Second stage of the batched operations, finds the bucket of every key of a group and prefetches its first aggregate node
  *
- * @return true             If the key could successfully be erased
- * @return false            If the key could not be erased
+ * @param pHashes           Pointer to the hashes of the keys of the group (their buckets should already have been prefetched)
+ * @param pCount            Number of keys in the group (atmost sBatchWidth)
+ * @param pAggrs            Pointer to the array to write the first aggregate node of each key's bucket into (nullptr if the bucket can not hold the key)
+ * @param pBucketIds        Pointer to the array to write the position of the bucket of each key into (see locate ())
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-bool
-AgHashTable<key_t, tHashFunc, tEquals>::erase_util (const key_t &pKey, node_ptr_t *pListElem)
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::head_batch (const hash_t *pHashes, const uint64_t &pCount, aggr_ptr_t *pAggrs, uint64_t *pBucketIds) const
 {
-    node_ptr_t          foundNode;                                  /** Pointer to node with matching key */
-
-    while ((*pListElem) != nullptr) {
-
-        // if a node is found with matching key, erase it
-        if (tEquals (pKey, (*pListElem)->key)) {
-
-            // take the current node out and set it's predecessor's successor to it's successor
-            foundNode           = *pListElem;
-            *pListElem          = foundNode->nextPtr;
+    for (uint64_t keyId = 0; keyId < pCount; ++keyId) {
 
-            // set it's successor to nullptr and delete it
-            foundNode->nextPtr  = nullptr;
+        pBucketIds[keyId]   = locate (pHashes[keyId]);
 
-            delete foundNode;
+        const bucket_t  &bucket = bucket_at (pBucketIds[keyId]);    /** Bucket in which the key should be present */
 
-            DBG_MODE (
-            ++mDeleteCnt;
-            mAllocAmt           -= sizeof (node_t);
-            )
+        pAggrs[keyId]       = bucket.hashListHead;
 
-            return true;
+        // the bucket holds the first aggregate node's hash and list, so if the hash matches, the keys are loaded along with
+        // the aggregate node, and if it does not and there are no other aggregate nodes, the bucket has nothing to search
+        if (pAggrs[keyId] != nullptr && bucket.headHash == pHashes[keyId]) {
+            ag_prefetch (bucket.headNode);
+        }
+        else if (bucket.distinctHashCount <= 1) {
+            pAggrs[keyId]   = nullptr;
         }
 
-        // go to the next node
-        pListElem   = &((*pListElem)->nextPtr);
+        ag_prefetch (pAggrs[keyId]);
     }
-
-    return true;
 }
 
 /**
- * @brief                   Resizes the hash table to have the supplied number of buckets
+ * @brief                   Third stage of the batched operations, finds the aggregate node with the hash of every key of a group and prefetches its first node
  *
- *                          Creates a new array of buckets of the specified size and moves aggregate nodes from
- *                          the old bucket array to the new one, after which the old array is deleted
- *
- * @param pNumBuckets       Number of buckets the hash table be resized to
+ *                          The aggregate lists of all the keys are walked together, one aggregate node per key in each pass, so that
+ *                          the cache misses of different lists overlap instead of waiting for each list to be walked to its end
  *
- * @return true             If the hash table could be resized successfully
- * @return false            If the hash table could not be resized successfully (allocation failure)
+ * @param pHashes           Pointer to the hashes of the keys of the group
+ * @param pCount            Number of keys in the group (atmost sBatchWidth)
+ * @param pAggrs            Pointer to the first aggregate node of each key's bucket (replaced by the aggregate node with the key's hash, or nullptr if there is none)
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-bool
-AgHashTable<key_t, tHashFunc, tEquals>::resize (const uint64_t &pNumBuckets)
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::match_batch (const hash_t *pHashes, const uint64_t &pCount, aggr_ptr_t *pAggrs) const
 {
-    bucket_ptr_t        newArray;                                   /** New array of buckets to use */
-    aggr_ptr_t          *aggrElem;                                  /** Pointer to pointer to an aggregate node (used while iterating over aggregate nodes in the new bucket) */
-    aggr_ptr_t          *aggrInsertElem;                            /** Pointer to pointer to an aggregate node (used while iterating over aggregate nodes in the old bucket) */
-
-    uint64_t            newPosition;                                /** For each aggregate node, stores the position in which it will be inserted in the new bucket */
-
-    DBG_MODE (
-    ++mResizeCnt;
-    )
-
-    // allocate the new array (return failed resize in case of failure)
-    newArray        = new (std::nothrow) bucket_t[pNumBuckets];
-    if (newArray == nullptr) {
-        DBG_MODE (
-        std::cout << "Allocation of new bucket array failed while resizing" << std::endl;
-        std::cout << "Present Size: " << mBucketCount << std::endl;
-        std::cout << "Target Size: " << pNumBuckets << std::endl;
-        )
+    uint64_t            pending[sBatchWidth];                       /** Positions of the keys whose aggregate node has not been found yet */
+    uint64_t            pendingCnt;                                 /** Number of keys whose aggregate node has not been found yet */
+    uint64_t            keyId;                                      /** Position of the current key */
 
-        return false;
-    }
-    else {
-        DBG_MODE (
-        ++mAllocCnt;
-        mAllocAmt       += sizeof (bucket_t) * pNumBuckets;
-        )
+    for (keyId = 0; keyId < pCount; ++keyId) {
+        pending[keyId]  = keyId;
     }
+    pendingCnt      = pCount;
 
-    // iterare through all buckets in the old array for moving the aggregate nodes
-    for (uint64_t bucketId = 0ULL; bucketId < mBucketCount; ++bucketId) {
+    while (pendingCnt > 0) {
 
-        // get a pointer to the pointer to the head of the current bucket's aggregate node list
-        aggrInsertElem  = &(mBucketArray[bucketId].hashListHead);
+        // keys which are still pending after this pass are moved to the front of the array (the order does not matter)
+        uint64_t        keptCnt     {0ULL};
 
-        // while an aggregate node exists in the current list, move it to the new bucket array
-        while (*aggrInsertElem != nullptr) {
+        for (uint64_t pos = 0; pos < pendingCnt; ++pos) {
 
-            // using the hash value of the aggregate node, calculate its position in the new array and get a pointer to it's pointer
-            newPosition                     = (*aggrInsertElem)->keyHash & (pNumBuckets - 1);
-            aggrElem                        = &(newArray[newPosition].hashListHead);
+            keyId       = pending[pos];
+
+            // the end of the list was reached without finding the hash
+            if (pAggrs[keyId] == nullptr) {
+                continue;
+            }
 
-            // move to the end of the aggregate node list of the new array to find a vacant spot
-            while (*aggrElem != nullptr) {
-                aggrElem    = &((*aggrElem)->nextPtr);
+            // found the hash, start loading the first node so that it is ready when the keys are compared
+            if (pAggrs[keyId]->keyHash == pHashes[keyId]) {
+                ag_prefetch (pAggrs[keyId]->nodePtr);
+                continue;
             }
 
-            // make the found empty spot point to the current aggregate node and accordingly increment the new bucket's distinct hash and key counts
-            *aggrElem                       = *aggrInsertElem;
-            ++newArray[newPosition].distinctHashCount;
-            newArray[newPosition].keyCount  += (*aggrElem)->keyCount;
+            // otherwise start loading the next aggregate node, which will only be read in the next pass
+            pAggrs[keyId]   = pAggrs[keyId]->nextPtr;
+            ag_prefetch (pAggrs[keyId]);
 
-            // move the aggregate node's successor in its place, and disconnect it from it's successor
-            *aggrInsertElem                 = (*aggrInsertElem)->nextPtr;
-            (*aggrElem)->nextPtr            = nullptr;
+            pending[keptCnt++]  = keyId;
         }
+
+        pendingCnt  = keptCnt;
     }
+}
 
-    // delete the old bucket array (which should not have any aggregate nodes left)
-    delete mBucketArray;
-    DBG_MODE (
-    ++mDeleteCnt;
-    mAllocAmt       -= sizeof (bucket_t) * mBucketCount;
-    )
+/**
+ * @brief                   Returns the position of the bucket which holds the keys with the given hash
+ *
+ *                          During an incremental resize, an old bucket which still has keys has not been migrated yet, so keys
+ *                          with the hash can only be in it, otherwise they can only be in the new array
+ *                          Positions in the old array are numbered after those in the new array
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint64_t         Position of the bucket (see bucket_at ())
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::locate (const hash_t &pKeyHash) const
+{
+    uint64_t            oldBucketId;                                /** Position of the key's bucket in the old array */
 
-    // make the current bucket array point to the new array and update the bucket count
-    mBucketArray    = newArray;
-    mBucketCount    = pNumBuckets;
+    if (mOldBucketArray != nullptr) {
 
-    return true;
+        oldBucketId = pKeyHash & (mOldBucketCount - 1);
+
+        if (mOldBucketArray[oldBucketId].hashListHead != nullptr) {
+            return mBucketCount + oldBucketId;
+        }
+    }
+
+    return pKeyHash & (mBucketCount - 1);
 }
 
 /**
- * @brief                   Returns a pointer to the aggregate node which contains nodes with the given hash value
+ * @brief                   Returns the bucket at the given position (positions after the end of the current array refer to the old array)
  *
- * @param pKeyHash          Hash value to search for
+ * @param pPos              Position of the bucket
  *
- * @return aggr_ptr_t       Pointer to aggregate node with the matching hash value
+ * @return bucket_t&        Reference to the bucket
  */
-template<typename key_t, auto tHashFunc, auto tEquals>
-typename AgHashTable<key_t, tHashFunc, tEquals>::aggr_ptr_t
-AgHashTable<key_t, tHashFunc, tEquals>::getHashAggr (const hash_t &pKeyHash) const
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::bucket_t &
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::bucket_at (const uint64_t &pPos) const
 {
-    uint64_t        bucketId;                                       /** Index of the bucket in which the aggregate node should lie */
-    aggr_ptr_t      aggrElem;                                       /** Used to iterator over elements in the linked list of the aggregate node list */
+    return (pPos < mBucketCount) ? (mBucketArray[pPos]) : (mOldBucketArray[pPos - mBucketCount]);
+}
 
-    // calculate the bucket in which the aggregate node should lie in (assuming it exists)
-    bucketId        = pKeyHash & (mBucketCount - 1);
-    aggrElem        = mBucketArray[bucketId].hashListHead;
+MULTITHREADED_MODE (
 
-    // iterate through all the aggregate nodes in the bucket until one with the maching hash is found
-    while (aggrElem != nullptr) {
-        if (aggrElem->keyHash == pKeyHash) {
-            break;
-        }
-        aggrElem    = aggrElem->nextPtr;
+/**
+ * @brief                   Returns the position of the lock which guards the buckets that keys with the given hash can fall in
+ *
+ *                          Depends only on the hash and the (fixed) number of locks, so it can be found without reading the
+ *                          bucket count, which may be changed by a concurrent resize
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint64_t         Position of the lock
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::get_lock_id (const hash_t &pKeyHash) const
+{
+    return pKeyHash & (mLockCount - 1);
+}
+
+/**
+ * @brief                   Takes exclusive ownership of every lock (in increasing order, so that concurrent calls can not deadlock)
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::lock_all ()
+{
+    for (uint64_t lockId = 0; lockId < mLockCount; ++lockId) {
+        mLocks[lockId].lock ();
     }
+}
 
-    // return the found aggregate node (return null in case no such node is found)
-    return aggrElem;
+/**
+ * @brief                   Releases every lock taken by lock_all ()
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::unlock_all ()
+{
+    for (uint64_t lockId = mLockCount; lockId > 0; --lockId) {
+        mLocks[lockId - 1].unlock ();
+    }
 }
 
+)
+
 /**
- * @brief                   Returns an iterator to the key with the smallest hash value in the table
+ * @brief                   Returns an iterator to the first key in the first non-empty bucket at or after the given position
  *
- * @return AgHashTable<key_t, tHashFunc, tEquals>::iterator
+ * @param pBucketId         Position of the bucket to start searching from
+ *
+ * @return iterator         Iterator to the first key found (end() if all remaining buckets are empty)
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-typename AgHashTable<key_t, tHashFunc, tEquals>::iterator
-AgHashTable<key_t, tHashFunc, tEquals>::begin () const
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::first_from_bucket (uint64_t pBucketId) const
 {
-    //! if the smallest hash value present in the table is too high, then the function may take a lot of time
-    //! try to use the fact that the size of the table can't become too big
-    //! also use this while incrementing the iterators
+    aggr_ptr_t      aggrPtr;                                        /** Pointer to the head of the aggregate node list of the current bucket */
 
-    aggr_ptr_t  aggrPtr;                                            /** Pointer to the aggregate node with the minimum hash value in the table */
-    hash_t      newHash;                                            /** Minimum hash value present in the table */
+    uint64_t        totalCount;                                     /** Number of buckets in both arrays */
 
-    // if no keys are present, return end() iterator
-    if (mKeyCount == 0) {
-        return end ();
-    }
+    totalCount      = mBucketCount + ((mOldBucketArray != nullptr) ? (mOldBucketCount) : (0ULL));
 
-    // start with a hash of 0 and keep incrementing it while no aggregate node is found
-    newHash     = 0;
-    while (true) {
+    // skip over empty buckets (every aggregate node in the table has atleast one key), including the buckets of the old
+    // array during an incremental resize (those which have been migrated are empty)
+    for (; pBucketId < totalCount; ++pBucketId) {
 
-        aggrPtr     = getHashAggr (newHash);
+        aggrPtr     = bucket_at (pBucketId).hashListHead;
 
         if (aggrPtr != nullptr) {
-            break;
+            return iterator {aggrPtr->nodePtr, aggrPtr, pBucketId, this};
         }
+    }
 
-        // if the keycount suddenyl becomes 0, return end()
-        if (mKeyCount == 0) {
-            return end ();
-        }
+    return end ();
+}
+
+/**
+ * @brief                   Returns an iterator to the first key in the first non-empty bucket of the table
+ *
+ * @return AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::begin () const
+{
+    // if no keys are present, return end() iterator without scanning the buckets
+    if (mKeyCount == 0) {
+        return end ();
     }
 
-    return iterator {aggrPtr->nodePtr, aggrPtr, this};
+    return first_from_bucket (0ULL);
 }
 
 /**
  * @brief                   Returns an iterator to the logical key after the last key
  *
- * @return AgHashTable<key_t, tHashFunc, tEquals>::iterator
+ * @return AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-typename AgHashTable<key_t, tHashFunc, tEquals>::iterator
-AgHashTable<key_t, tHashFunc, tEquals>::end () const
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::end () const
 {
-    return iterator {nullptr, nullptr, this};
+    return iterator {nullptr, nullptr, 0ULL, this};
 }
 
 #include "AgHashTable_iter.h"
+#include "AgHashTable_open.h"
+#include "AgHashTable_swiss.h"
+#include "AgHashTable_cuckoo.h"
 
 #undef  DBG_MODE
 #undef  NO_DBG_MODE
 #undef  MULTITHREADED_MODE
+#undef  NO_MULTITHREADED_MODE
 
 #endif          // Header Guard
@@ -0,0 +1,462 @@
+/**
+ * @file            AgHashTableAllocators.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           Allocator policies used by AgHashTable for its nodes (included by AgHashTable.h)
+ *
+ * @note            An allocator policy provides a class template pool_t<val_t>, an instance of which is created by the table for
+ *                  each type of node it allocates
+ *                  A pool only hands out and takes back uninitialized storage for a single val_t, constructing and destroying
+ *                  the objects is left to the table
+ *
+ *                  pool_t<val_t> must provide
+ *                      val_t   *allocate ()                        returns storage for one val_t (nullptr on allocation failure)
+ *                      void    deallocate (val_t *pPtr)            takes back storage returned by allocate ()
+ *                      void    swap (pool_t &pOther) noexcept      exchanges the storage held by two pools (used when tables are
+ *                                                                  moved or swapped, since every node stays with its pool)
+ *                      static constexpr bool sBulkRelease          if the pool can take back all of its storage at once, in which
+ *                                                                  case it must also provide
+ *                      void    release_all ()                      takes back all storage handed out by allocate (), without it
+ *                                                                  having to be deallocated one node at a time
+ *
+ *                  and in AG_DBG_MODE
+ *                      uint64_t get_system_alloc_count () const    number of allocations made from the system
+ *                      uint64_t get_reserved_amount () const       number of bytes currently held from the system
+ *                      uint64_t get_free_count () const            number of freed nodes waiting to be reused
+ */
+
+#ifndef AG_HASH_TABLE_ALLOCATORS_GUARD_H
+
+#define     AG_HASH_TABLE_ALLOCATORS_GUARD_H
+
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+#include <cstdint>
+
+/**
+ * @brief                   Allocator policy which allocates every node separately from the heap (the default)
+ *
+ */
+struct AgHeapAllocator {
+
+    template <typename val_t>
+    class pool_t {
+
+        public:
+
+        static constexpr bool   sBulkRelease    = false;                /** Every allocation is separate, so each one must be freed by itself */
+
+        pool_t                                  () = default;
+
+        pool_t                                  (const pool_t &pOther) = delete;
+        pool_t          &operator=              (const pool_t &pOther) = delete;
+
+        /**
+         * @brief           Exchanges the storage held by two pools (every allocation is separate, so only the counters move)
+         *
+         * @param pOther    Pool to exchange storage with
+         */
+        void
+        swap (pool_t &pOther) noexcept
+        {
+            DBG_MODE (
+            mAllocCnt   = pOther.mAllocCnt.exchange (mAllocCnt);
+            mLiveCnt    = pOther.mLiveCnt.exchange (mLiveCnt);
+            )
+
+            (void)pOther;
+        }
+
+        /**
+         * @brief           Returns storage for a single val_t
+         *
+         * @return val_t*   Pointer to the storage (nullptr on allocation failure)
+         */
+        val_t *
+        allocate ()
+        {
+            val_t       *res    = static_cast<val_t *> (::operator new (sizeof (val_t), std::nothrow));
+
+            DBG_MODE (
+            if (res != nullptr) {
+                ++mAllocCnt;
+                ++mLiveCnt;
+            }
+            )
+
+            return res;
+        }
+
+        /**
+         * @brief           Frees storage returned by allocate ()
+         *
+         * @param pPtr      Pointer to the storage
+         */
+        void
+        deallocate (val_t *pPtr)
+        {
+            ::operator delete (pPtr);
+
+            DBG_MODE (
+            --mLiveCnt;
+            )
+        }
+
+        DBG_MODE (
+        uint64_t    get_system_alloc_count  () const    { return mAllocCnt; }
+        uint64_t    get_reserved_amount     () const    { return mLiveCnt * sizeof (val_t); }
+        uint64_t    get_free_count          () const    { return 0ULL; }
+        )
+
+        private:
+
+        DBG_MODE (
+        std::atomic<uint64_t>   mAllocCnt   {0ULL};                     /** Number of allocations made from the system */
+        std::atomic<uint64_t>   mLiveCnt    {0ULL};                     /** Number of allocations which have not been freed yet */
+        )
+    };
+};
+
+/**
+ * @brief                   Allocator policy which carves nodes out of large chunks, recycling freed nodes through a free list
+ *
+ *                          Memory is only returned to the system when the pool is destroyed or the table is cleared, which
+ *                          releases every chunk at once (without visiting the nodes, if the keys need not be destroyed)
+ *                          In multithreaded mode, each pool is split into sShardCount shards with their own lock, chunks and free
+ *                          list, and every thread allocates from and frees into the shard it is assigned to, so that threads
+ *                          inserting and erasing at the same time rarely wait for each other (a slot may be freed into a different
+ *                          shard than the one it was carved out of, since all slots have the same size)
+ *
+ * @tparam tNodesPerChunk   Number of nodes carved out of each chunk
+ */
+template <uint64_t tNodesPerChunk = 1024ULL>
+struct AgSlabAllocator {
+
+    static_assert (tNodesPerChunk > 0, "Chunks must hold at least one node");
+
+    template <typename val_t>
+    class pool_t {
+
+        /**
+         * @brief           Storage for a single node, which holds the link to the next free node while it is not in use
+         *
+         */
+        union slot_t {
+
+            slot_t                  *nextPtr;                           /** Pointer to the next free slot */
+            alignas (val_t) unsigned char storage[sizeof (val_t)];      /** Storage for the node */
+        };
+
+        /**
+         * @brief           Chunk of slots allocated from the system at once
+         *
+         */
+        struct chunk_t {
+
+            chunk_t                 *nextPtr;                           /** Pointer to the chunk allocated before this one */
+            slot_t                  slots[tNodesPerChunk];              /** Slots carved out of the chunk */
+        };
+
+        MULTITHREADED_MODE (
+        static constexpr uint64_t   sShardCount     = 16ULL;            /** Number of shards the pool is split into */
+        static constexpr uint64_t   sShardAlignment = 64ULL;            /** Shards are kept in separate cache lines, since they are used by different threads */
+        )
+        NO_MULTITHREADED_MODE (
+        static constexpr uint64_t   sShardCount     = 1ULL;             /** Number of shards the pool is split into */
+        static constexpr uint64_t   sShardAlignment = alignof (void *); /** A single shard needs no more than the alignment of its members */
+        )
+
+        /**
+         * @brief           Part of the pool used by a subset of the threads
+         *
+         */
+        struct alignas (sShardAlignment) shard_t {
+
+            chunk_t         *chunks         {nullptr};                  /** Pointer to the most recently allocated chunk */
+            slot_t          *freeList       {nullptr};                  /** Pointer to the most recently freed slot */
+            uint64_t        usedInChunk     {tNodesPerChunk};           /** Number of slots of the most recent chunk which have been carved out */
+
+            MULTITHREADED_MODE (
+            std::mutex      lock;                                       /** Guards the shard */
+            )
+
+            DBG_MODE (
+            uint64_t        chunkCnt        {0ULL};                     /** Number of chunks allocated */
+            uint64_t        heldCnt         {0ULL};                     /** Number of chunks held (allocated and not yet released) */
+            uint64_t        freeCnt         {0ULL};                     /** Number of slots in the free list */
+            )
+        };
+
+        public:
+
+        static constexpr bool   sBulkRelease    = true;                 /** Every chunk can be released at once, regardless of which slots are in use */
+
+        pool_t                                  () = default;
+        ~pool_t                                 ();
+
+        pool_t                                  (const pool_t &pOther) = delete;
+        pool_t          &operator=              (const pool_t &pOther) = delete;
+
+        val_t           *allocate               ();
+        void            deallocate              (val_t *pPtr);
+
+        void            swap                    (pool_t &pOther) noexcept;
+        void            release_all             ();
+
+        DBG_MODE (
+        uint64_t        get_system_alloc_count  () const;
+        uint64_t        get_reserved_amount     () const;
+        uint64_t        get_free_count          () const;
+        )
+
+        private:
+
+        shard_t         &local_shard            ();
+
+        shard_t         mShards[sShardCount];                           /** Shards of the pool */
+    };
+};
+
+/**
+ * @brief                   Destroy the pool, returning every chunk to the system
+ *
+ *                          Every node must already have been destroyed (their storage does not have to be deallocated)
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::~pool_t ()
+{
+    release_all ();
+}
+
+/**
+ * @brief                   Returns the shard used by the calling thread (threads are assigned to shards in turn, the first time they
+ *                          use any pool of this type)
+ *
+ * @return shard_t&         Shard used by the calling thread
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+typename AgSlabAllocator<tNodesPerChunk>::template pool_t<val_t>::shard_t &
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::local_shard ()
+{
+    MULTITHREADED_MODE (
+    static std::atomic<uint64_t>    nextShard   {0ULL};
+    thread_local const uint64_t     shardId     = nextShard.fetch_add (1ULL, std::memory_order_relaxed) % sShardCount;
+
+    return mShards[shardId];
+    )
+
+    NO_MULTITHREADED_MODE (
+    return mShards[0];
+    )
+}
+
+/**
+ * @brief                   Returns storage for a single val_t, reusing a freed slot if possible
+ *
+ * @return val_t*           Pointer to the storage (nullptr on allocation failure)
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+val_t *
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::allocate ()
+{
+    shard_t             &shard      = local_shard ();               /** Shard used by the calling thread */
+    slot_t              *slot;                                      /** Slot handed out */
+    chunk_t             *newChunk;                                  /** Newly allocated chunk */
+
+    MULTITHREADED_MODE (
+    std::lock_guard<std::mutex>     shardLock   {shard.lock};
+    )
+
+    // reuse the most recently freed slot (which is the most likely to still be in the cache)
+    if (shard.freeList != nullptr) {
+        slot            = shard.freeList;
+        shard.freeList  = slot->nextPtr;
+
+        DBG_MODE (
+        --shard.freeCnt;
+        )
+
+        return reinterpret_cast<val_t *> (slot->storage);
+    }
+
+    // otherwise carve the next slot out of the current chunk, allocating a new chunk if it has been used up
+    if (shard.usedInChunk == tNodesPerChunk) {
+
+        newChunk    = new (std::nothrow) chunk_t;
+        if (newChunk == nullptr) {
+            return nullptr;
+        }
+
+        newChunk->nextPtr   = shard.chunks;
+        shard.chunks        = newChunk;
+        shard.usedInChunk   = 0ULL;
+
+        DBG_MODE (
+        ++shard.chunkCnt;
+        ++shard.heldCnt;
+        )
+    }
+
+    slot            = &(shard.chunks->slots[shard.usedInChunk++]);
+
+    return reinterpret_cast<val_t *> (slot->storage);
+}
+
+/**
+ * @brief                   Takes back storage returned by allocate (), to be handed out again by a later call
+ *
+ * @param pPtr              Pointer to the storage
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+void
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::deallocate (val_t *pPtr)
+{
+    shard_t             &shard      = local_shard ();               /** Shard used by the calling thread */
+    slot_t              *slot;                                      /** Slot being freed */
+
+    MULTITHREADED_MODE (
+    std::lock_guard<std::mutex>     shardLock   {shard.lock};
+    )
+
+    slot            = reinterpret_cast<slot_t *> (pPtr);
+    slot->nextPtr   = shard.freeList;
+    shard.freeList  = slot;
+
+    DBG_MODE (
+    ++shard.freeCnt;
+    )
+}
+
+/**
+ * @brief                   Exchanges the chunks and free slots held by two pools
+ *
+ *                          The locks are not exchanged, and neither pool may be in use by other threads
+ *
+ * @param pOther            Pool to exchange storage with
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+void
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::swap (pool_t &pOther) noexcept
+{
+    for (uint64_t shardId = 0; shardId < sShardCount; ++shardId) {
+
+        shard_t         &shard      = mShards[shardId];
+        shard_t         &other      = pOther.mShards[shardId];
+
+        std::swap (shard.chunks, other.chunks);
+        std::swap (shard.freeList, other.freeList);
+        std::swap (shard.usedInChunk, other.usedInChunk);
+
+        DBG_MODE (
+        std::swap (shard.chunkCnt, other.chunkCnt);
+        std::swap (shard.heldCnt, other.heldCnt);
+        std::swap (shard.freeCnt, other.freeCnt);
+        )
+    }
+}
+
+/**
+ * @brief                   Returns every chunk to the system at once, taking back all storage handed out by the pool
+ *
+ *                          Every node must already have been destroyed (their storage does not have to be deallocated), and the pool
+ *                          may be used again afterwards
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+void
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::release_all ()
+{
+    chunk_t             *chunk;                                     /** Chunk being freed */
+
+    for (shard_t &shard : mShards) {
+
+        MULTITHREADED_MODE (
+        std::lock_guard<std::mutex>     shardLock   {shard.lock};
+        )
+
+        while (shard.chunks != nullptr) {
+            chunk           = shard.chunks;
+            shard.chunks    = chunk->nextPtr;
+
+            delete chunk;
+        }
+
+        shard.freeList      = nullptr;
+        shard.usedInChunk   = tNodesPerChunk;
+
+        DBG_MODE (
+        shard.heldCnt       = 0ULL;
+        shard.freeCnt       = 0ULL;
+        )
+    }
+}
+
+DBG_MODE (
+
+/**
+ * @brief                   Returns the number of chunks allocated from the system by every shard
+ *
+ * @return uint64_t         Number of chunks allocated
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+uint64_t
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::get_system_alloc_count () const
+{
+    uint64_t            res     {0ULL};                             /** Sum over the shards */
+
+    for (const shard_t &shard : mShards) {
+        res     += shard.chunkCnt;
+    }
+
+    return res;
+}
+
+/**
+ * @brief                   Returns the number of bytes held from the system by every shard
+ *
+ * @return uint64_t         Number of bytes held
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+uint64_t
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::get_reserved_amount () const
+{
+    uint64_t            res     {0ULL};                             /** Sum over the shards */
+
+    for (const shard_t &shard : mShards) {
+        res     += shard.heldCnt * sizeof (chunk_t);
+    }
+
+    return res;
+}
+
+/**
+ * @brief                   Returns the number of freed slots waiting to be reused in every shard
+ *
+ * @return uint64_t         Number of freed slots
+ */
+template <uint64_t tNodesPerChunk>
+template <typename val_t>
+uint64_t
+AgSlabAllocator<tNodesPerChunk>::pool_t<val_t>::get_free_count () const
+{
+    uint64_t            res     {0ULL};                             /** Sum over the shards */
+
+    for (const shard_t &shard : mShards) {
+        res     += shard.freeCnt;
+    }
+
+    return res;
+}
+)
+
+#endif          // Header Guard
@@ -0,0 +1,215 @@
+/**
+ * @file            AgHashTablePolicies.hpp
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           Policy types used to configure the storage layout of AgHashTable
+ *
+ */
+
+#ifndef AG_HASH_TABLE_POLICIES_GUARD_HPP
+
+#define     AG_HASH_TABLE_POLICIES_GUARD_HPP
+
+#include <cstdint>
+
+/**
+ * @brief                   Storage layout in which each bucket holds a linked list of aggregate nodes (one per distinct hash), each of which holds a linked list of keys
+ *
+ *                          This is the default layout of AgHashTable
+ */
+struct AgChainedLayout {};
+
+/**
+ * @brief                   Chained layout in which every node also stores a fingerprint of its key, computed with a second hash function
+ *
+ *                          All keys with the same hash share an aggregate node, so narrow or weak hash functions make lookups
+ *                          compare many stored keys against the key being searched for
+ *                          With this layout only the keys whose fingerprint agrees are compared (the fingerprint of the key being
+ *                          searched for is only computed when an aggregate node holds more than one key)
+ *
+ * @tparam tFingerprintFunc Function which returns an unsigned integer fingerprint of a key (should be independent of the hash function)
+ */
+template <auto tFingerprintFunc>
+struct AgChainedFingerprintLayout {
+
+    static constexpr auto       sFingerprintFunc    = tFingerprintFunc;     /** Function which returns the fingerprint of a key */
+};
+
+/**
+ * @brief                   Growth policy of the chained layout, which decides when the bucket array grows and by how much
+ *
+ *                          A bucket triggers growth once it holds more than numKeysAllowed keys with more than numDistinctAllowed
+ *                          distinct hashes (keys which all share a hash would still share a bucket after growing), after which the
+ *                          bucket array grows by resizeFactor, upto maxBucketCount buckets
+ *                          Once the bucket array can not grow any further, buckets keep growing longer instead
+ *
+ *                          If shrinkLoadPercent is not 0, erasing a key shrinks the bucket array once the table holds fewer keys than
+ *                          that percentage of its buckets, down to the number of buckets reserve () would choose for its keys
+ *                          That number is chosen to hold numKeysAllowed / 8 keys per bucket, and shrinkLoadPercent must be atmost
+ *                          half of that load, so that the table can not shrink again (or grow back) until many keys have been erased
+ *                          (or inserted)
+ *
+ *                          balanced () is the default, memory_lean () grows in smaller steps (so the bucket array overshoots the
+ *                          number of keys less), while latency_lean () keeps buckets short at the cost of more buckets
+ */
+struct AgGrowthPolicy {
+
+    uint64_t            numDistinctAllowed;                         /** Number of distinct hashes allowed per bucket before growing is considered */
+    uint64_t            numKeysAllowed;                             /** Number of keys allowed per bucket before growing is considered */
+    uint64_t            resizeFactor;                               /** Factor by which the bucket array grows (power of 2, atleast 2) */
+    uint64_t            maxBucketCount;                             /** Maximum number of buckets (power of 2, further limited by the bitness of the hash) */
+    uint64_t            shrinkLoadPercent;                          /** Keys per 100 buckets below which erasing shrinks the table (0 never shrinks it) */
+
+    /**
+     * @brief               Policy used by default, which grows eightfold once a bucket holds more than 16 keys
+     *
+     */
+    static constexpr AgGrowthPolicy
+    balanced ()
+    {
+        return AgGrowthPolicy {1ULL, 16ULL, 8ULL, 1ULL << 32, 0ULL};
+    }
+
+    /**
+     * @brief               Policy which overshoots the number of buckets the least, growing twofold once a bucket holds more than 16 keys
+     *
+     */
+    static constexpr AgGrowthPolicy
+    memory_lean ()
+    {
+        return AgGrowthPolicy {1ULL, 16ULL, 2ULL, 1ULL << 32, 0ULL};
+    }
+
+    /**
+     * @brief               Policy which keeps buckets short, growing fourfold once a bucket holds more than 8 keys
+     *
+     */
+    static constexpr AgGrowthPolicy
+    latency_lean ()
+    {
+        return AgGrowthPolicy {1ULL, 8ULL, 4ULL, 1ULL << 32, 0ULL};
+    }
+};
+
+/**
+ * @brief                   Probe strategy which visits consecutive slots after the home slot
+ *
+ */
+struct AgProbeLinear {
+
+    static constexpr bool       sRobinHood          = false;        /** If displacement based insertion and backward shift deletion is to be used */
+    static constexpr uint64_t   sMaxLoadPercent     = 75ULL;        /** Percentage of slots (including tombstones) which may be used before growing */
+
+    /**
+     * @brief               Returns the position of the slot to visit after the current one
+     *
+     * @param pPos          Position of the current slot
+     * @param pStep         Number of slots visited so far (starting from 1 for the first call)
+     * @param pMask         Number of slots in the table - 1
+     *
+     * @return uint64_t     Position of the next slot
+     */
+    static constexpr uint64_t
+    next (const uint64_t &pPos, const uint64_t &pStep, const uint64_t &pMask)
+    {
+        (void)pStep;
+        return (pPos + 1ULL) & pMask;
+    }
+};
+
+/**
+ * @brief                   Probe strategy which visits slots at triangular offsets from the home slot (visits every slot if the number of slots is a power of 2)
+ *
+ */
+struct AgProbeQuadratic {
+
+    static constexpr bool       sRobinHood          = false;        /** If displacement based insertion and backward shift deletion is to be used */
+    static constexpr uint64_t   sMaxLoadPercent     = 75ULL;        /** Percentage of slots (including tombstones) which may be used before growing */
+
+    /**
+     * @brief               Returns the position of the slot to visit after the current one
+     *
+     * @param pPos          Position of the current slot
+     * @param pStep         Number of slots visited so far (starting from 1 for the first call)
+     * @param pMask         Number of slots in the table - 1
+     *
+     * @return uint64_t     Position of the next slot
+     */
+    static constexpr uint64_t
+    next (const uint64_t &pPos, const uint64_t &pStep, const uint64_t &pMask)
+    {
+        return (pPos + pStep) & pMask;
+    }
+};
+
+/**
+ * @brief                   Linear probe strategy where keys which are further from their home slot displace keys which are closer to theirs
+ *
+ *                          Lookups can stop as soon as a key closer to its home slot than the searched key would be is found, and
+ *                          erasure shifts the following keys back instead of leaving tombstones
+ */
+struct AgProbeRobinHood {
+
+    static constexpr bool       sRobinHood          = true;         /** If displacement based insertion and backward shift deletion is to be used */
+    static constexpr uint64_t   sMaxLoadPercent     = 87ULL;        /** Percentage of slots which may be used before growing */
+
+    /**
+     * @brief               Returns the position of the slot to visit after the current one
+     *
+     * @param pPos          Position of the current slot
+     * @param pStep         Number of slots visited so far (starting from 1 for the first call)
+     * @param pMask         Number of slots in the table - 1
+     *
+     * @return uint64_t     Position of the next slot
+     */
+    static constexpr uint64_t
+    next (const uint64_t &pPos, const uint64_t &pStep, const uint64_t &pMask)
+    {
+        (void)pStep;
+        return (pPos + 1ULL) & pMask;
+    }
+};
+
+/**
+ * @brief                   Storage layout in which keys are stored inline in a flat array of slots (open addressing)
+ *
+ *                          Each slot stores the full hash of its key alongside it and a separate array of metadata bytes stores
+ *                          a short tag of the hash (or the probe distance for Robin Hood probing), so that most slots can be
+ *                          rejected without touching the slot array at all
+ *
+ * @tparam tProbe           Probe strategy to use (AgProbeLinear, AgProbeQuadratic or AgProbeRobinHood)
+ */
+template <typename tProbe = AgProbeLinear>
+struct AgOpenAddressingLayout {
+
+    using       probe_t         = tProbe;
+};
+
+/**
+ * @brief                   Storage layout in which keys are stored inline in a flat array of slots, which are probed a group at a time
+ *
+ *                          An array of control bytes (one per slot) stores a 7 bit fingerprint of the hash of each key, so that
+ *                          an entire group of slots (32 with AVX2, 16 with SSE2 and 8 otherwise) can be matched against a
+ *                          fingerprint with a handful of instructions before any key is compared (similar to Swiss tables)
+ */
+struct AgSwissLayout {};
+
+/**
+ * @brief                   Storage layout in which keys are stored inline in buckets of a few slots, and every key can only be in one of
+ *                          two buckets (bucketized cuckoo hashing)
+ *
+ *                          Both buckets of a key are found from its hash (the second from the first and a tag of the hash), so a
+ *                          lookup reads atmost two buckets, each of which fits in a single cache line (such as 4 keys of 8 bytes or
+ *                          8 keys of 4 bytes)
+ *                          A key whose buckets are both full moves other keys into their other buckets (along the shortest such
+ *                          path, found with a breadth first search), and the table grows if there is no such path
+ *
+ * @tparam tSlots           Number of slots per bucket (between 4 and 8)
+ */
+template <uint64_t tSlots = 4ULL>
+struct AgCuckooLayout {
+
+    static_assert (tSlots >= 4ULL && tSlots <= 8ULL, "Buckets of the cuckoo layout must have between 4 and 8 slots");
+};
+
+#endif          // Header Guard
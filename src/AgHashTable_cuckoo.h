@@ -0,0 +1,1255 @@
+/**
+ * @file            AgHashTable_cuckoo.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           Bucketized cuckoo layout of AgHashTable (partial specialization for AgCuckooLayout)
+ *
+ *                  Keys are stored inline in buckets of a few slots, along with an 8 bit tag of their hash per slot
+ *                  Every key can only be in its primary bucket (chosen by the hash) or its alternate bucket (chosen by the
+ *                  primary bucket and the tag), so a lookup compares the tags of atmost two buckets
+ *                  The alternate bucket of a key can be found from the bucket it is in and its tag alone, so keys are moved
+ *                  between their buckets without hashing them again
+ */
+
+#include <new>
+
+/**
+ * @brief                   Bucketized cuckoo implementation of AgHashTable
+ *
+ *                          Keys which can not be placed in either of their buckets even after growing the table (which only happens
+ *                          when many keys share the same buckets regardless of the number of buckets, such as with a poor hash
+ *                          function) are kept in a stash of sStashCapacity keys, which is only searched while it holds any keys
+ *                          Once the stash is full, such keys can not be inserted, so a lookup never compares more than two buckets
+ *                          and the stash (no larger than a bucket), however poor the hash function is
+ *
+ * @tparam key_t            Type of keys held by the hash table
+ * @tparam tHashFunc        Hash function to use
+ * @tparam tEquals          Comparator to use while making equals comparisons
+ * @tparam tSlots           Number of slots per bucket
+ * @tparam tAlloc           Allocator policy (unused, since keys are stored inline in the buckets)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+class AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc> {
+
+
+
+    protected:
+
+
+
+    using       hash_t          = typename std::invoke_result<decltype (tHashFunc), const key_t *>::type;     /** Data type returned by the hash function (must be unsigned integral type */
+
+    static_assert (std::is_unsigned<hash_t>::value, "Return type of hash functions must be unsigned integer");
+
+
+    static constexpr uint64_t   sSlots                  = tSlots;                       /** Number of slots per bucket */
+    static constexpr uint64_t   sResizeFactor           = 2ULL;                         /** Factor by which the number of buckets grows */
+    static constexpr uint64_t   sMinBucketCount         = 2ULL;                         /** Minimum number of buckets in the table */
+    static constexpr uint64_t   sMaxBucketsAllowed      = 1ULL << 44;                   /** Maximum number of buckets allowed in the table */
+
+    static constexpr uint64_t   sMaxSearchNodes         = 512ULL;                       /** Maximum number of buckets visited while searching for a path to a free slot */
+    static constexpr uint64_t   sMinGrowLoadPercent     = 50ULL;                        /** Percentage of slots which must be used before the table grows for a key which could not be placed */
+    static constexpr uint64_t   sStashCapacity          = tSlots;                       /** Maximum number of keys in the stash (which is searched on every miss while it holds any) */
+
+    static constexpr uint8_t    sEmpty                  = 0x00;                         /** Tag of a slot which does not hold a key */
+    static constexpr uint64_t   sTagMultiplier          = 0x9E3779B97F4A7C15ULL;        /** Multiplier which mixes every bit of the hash into the tag */
+    static constexpr uint64_t   sAlternateMultiplier    = 0xC6A4A7935BD1E995ULL;        /** Multiplier which spreads the tag over the bits of the bucket position */
+
+    static constexpr uint64_t   sNotFound               = std::numeric_limits<uint64_t>::max ();   /** Position returned when a key could not be found */
+
+    /**
+     * @brief               Returns the alignment of the buckets, which is the size of a bucket rounded upto a power of 2 (but no more
+     *                      than a cache line), so that no bucket which fits in a cache line is split across two of them
+     *
+     * @return uint64_t     Alignment of the buckets
+     */
+    static constexpr uint64_t
+    bucket_alignment ()
+    {
+        uint64_t    size        = ((sSlots + alignof (key_t) - 1ULL) / alignof (key_t)) * alignof (key_t) + sizeof (key_t) * sSlots;
+        uint64_t    alignment   = alignof (key_t);
+
+        while (alignment < size && alignment < 64ULL) {
+            alignment   *= 2ULL;
+        }
+
+        return alignment;
+    }
+
+    /**
+     * @brief               Bucket in the table, which holds a tag per slot followed by the keys themselves
+     *
+     */
+    struct alignas (bucket_alignment ()) bucket_t {
+
+        uint8_t             tags[sSlots]        {};                                         /** Tag of the key in each slot (sEmpty if the slot does not hold a key) */
+        alignas (key_t) unsigned char   keys[sizeof (key_t) * sSlots];                      /** Storage for the keys (only the slots with a tag hold a key) */
+    };
+
+    /**
+     * @brief               Bucket visited while searching for a path to a free slot
+     *
+     */
+    struct search_node_t {
+
+        uint64_t            bucketId;                               /** Position of the bucket */
+        uint64_t            parent;                                 /** Position (in the search) of the bucket whose key would move into this one */
+        uint64_t            slot;                                   /** Slot of the parent bucket which holds the key that would move into this one */
+    };
+
+    using       bucket_ptr_t    = bucket_t *;                                           /** Helper alias for pointers to buckets/arrays of buckets */
+    using       stash_ptr_t     = key_t *;                                              /** Helper alias for pointers to the stash */
+
+
+
+    public:
+
+
+
+    struct iterator {
+
+        protected:
+
+        using table_ptr_t       = const AgHashTable *;
+        using ref_t             = const key_t &;
+
+        uint64_t    mPos        {sNotFound};                                /** Position of the slot (bucket * slots per bucket + slot, followed by the stash), sNotFound if points to end() */
+        table_ptr_t mTablePtr   {nullptr};                                  /** Pointer to table instance */
+
+        public:
+
+        iterator                (const uint64_t &pPos, table_ptr_t pTablePtr);
+        iterator                () = default;
+
+        iterator operator++     ();
+        iterator operator++     (int);
+
+        ref_t    operator*      () const;
+
+        bool     operator==     (const iterator & pOther) const;
+        bool     operator!=     (const iterator & pOther) const;
+
+    };
+
+    //  Constructors
+
+    AgHashTable     ();
+    AgHashTable     (const uint64_t &pBucketCount);
+    AgHashTable     (const AgHashTable &pOther) = delete;
+
+    //  Destructors
+
+    ~AgHashTable    ();
+
+    //  Getters
+
+    bool                initialized             () const;
+
+    uint64_t            size                    () const;
+    uint64_t            get_key_count           () const;
+
+    uint64_t            get_bucket_count        () const;
+    uint64_t            get_max_bucket_count    () const;
+    uint64_t            get_slot_count          () const;
+    uint64_t            get_stash_count         () const;
+    uint64_t            get_stash_capacity      () const;
+
+    uint64_t            get_bucket_key_count    (const uint64_t &pBucketId) const;
+    uint64_t            get_bucket_hash_count   (const uint64_t &pBucketId) const;
+
+    uint64_t            get_bucket_of_key       (const key_t &pKey) const;
+    // Testing and debugging
+
+    DBG_MODE (
+    uint64_t            get_alloc_amount        () const;
+    uint64_t            get_alloc_count         () const;
+    uint64_t            get_delete_count        () const;
+
+    uint64_t            get_resize_count        () const;
+
+    uint64_t            get_displacement_count  () const;
+    )
+
+    iterator            find                    (const key_t &pKey) const;
+    bool                exists                  (const key_t &pkey) const;
+
+    //  Modifiers
+
+    bool                insert                  (const key_t &pKey);
+    bool                erase                   (const key_t &pKey);
+
+    // Iterators and Iteration
+
+    iterator            begin                   () const;
+    iterator            end                     () const;
+
+
+
+    private:
+
+
+
+    // Getters
+
+    static uint8_t      get_tag                 (const hash_t &pKeyHash);
+    static key_t        *key_at                 (bucket_t &pBucket, const uint64_t &pSlot);
+
+    uint64_t            get_primary             (const hash_t &pKeyHash) const;
+    uint64_t            get_alternate           (const uint64_t &pBucketId, const uint8_t &pTag) const;
+
+    uint64_t            find_util               (const key_t &pKey, const hash_t &pKeyHash) const;
+    uint64_t            next_full               (uint64_t pPos) const;
+
+    // Modifiers
+
+    void                init                    ();
+
+    bool                make_room               (const hash_t &pKeyHash, uint64_t &pBucketId, uint64_t &pSlot, uint64_t *pOrigins = nullptr);
+    static bool         on_path                 (const search_node_t *pNodes, uint64_t pPos, const uint64_t &pBucketId);
+    void                move_key                (const uint64_t &pFromBucket, const uint64_t &pFromSlot, const uint64_t &pToBucket, const uint64_t &pToSlot,
+                                                 uint64_t *pOrigins);
+
+    bool                stash_reserve           ();
+    template <typename arg_t>
+    bool                stash_push              (arg_t &&pKey);
+    void                stash_remove            (const uint64_t &pPos);
+
+    bool                resize                  (const uint64_t &pNumBuckets);
+
+
+    bucket_ptr_t        mBuckets        {nullptr};                          /** Pointer to array of buckets */
+    stash_ptr_t         mStash          {nullptr};                          /** Pointer to array of keys which could not be placed in either of their buckets */
+
+    MULTITHREADED_MODE (
+    mutable std::shared_mutex   mLock;                                      /** Guards the whole table (keys move between buckets on insertion, so the buckets can not be locked independently) */
+    )
+
+    uint64_t            mKeyCount       {0ULL};                             /** Number of keys in the table (including the stash) */
+    uint64_t            mBucketCount    {16ULL};                            /** Number of buckets in the table */
+    uint64_t            mStashCount     {0ULL};                             /** Number of keys in the stash (never more than sStashCapacity) */
+
+    DBG_MODE (
+    uint64_t            mAllocAmt       {0ULL};                             /** Number of bytes allocated by the hash table (does not count allocations done by keys internally) */
+    uint64_t            mAllocCnt       {0ULL};                             /** Number of times operator new/malloc has been used to perform a new allocation (does not count allocations done by keys internally) */
+    uint64_t            mDeleteCnt      {0ULL};                             /** Number of times operator delete/free has been used to free up memory (does not count frees done by keys internally) */
+
+    uint64_t            mResizeCnt      {0ULL};                             /** Number of times the bucket array of the table has been resized */
+    uint64_t            mDisplaceCnt    {0ULL};                             /** Number of times a key has been moved to its other bucket to make room for another key */
+    )
+
+};
+
+/**
+ * @brief                   Construct a new bucketized cuckoo AgHashTable object
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::AgHashTable ()
+{
+    init ();
+}
+
+/**
+ * @brief                   Construct a new bucketized cuckoo AgHashTable object
+ *
+ * @param pBucketCount      Number of buckets to initialize the hash table with (rounded up to a power of 2)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::AgHashTable (const uint64_t &pBucketCount)
+{
+    mBucketCount        = sMinBucketCount;
+    while (mBucketCount < pBucketCount && mBucketCount < sMaxBucketsAllowed) {
+        mBucketCount    *= 2ULL;
+    }
+
+    init ();
+}
+
+/**
+ * @brief                   Initialize the hash table with the specified number of buckets
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::init ()
+{
+    // try to allocate the buckets (all slots start out empty)
+    mBuckets            = new (std::nothrow) bucket_t[mBucketCount];
+
+    DBG_MODE (
+    if (mBuckets == nullptr) {
+        std::cout << "Allocation of bucket array failed while constructing\n";
+    }
+    else {
+        ++mAllocCnt;
+        mAllocAmt       += sizeof (bucket_t) * mBucketCount;
+    }
+    )
+
+#if defined (AG_DBG_MODE) && defined (AG_PRINT_INIT_INFO)
+    std::cout << "slots per bucket: " << sSlots << std::endl;
+    std::cout << "sizeof bucket_t: " << sizeof (bucket_t) << std::endl;
+#endif
+}
+
+/**
+ * @brief                   Destroy the bucketized cuckoo AgHashTable object
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::~AgHashTable ()
+{
+    // destroy the keys held by all full slots and the stash
+    if (mBuckets != nullptr) {
+        for (uint64_t bucketId = 0; bucketId < mBucketCount; ++bucketId) {
+            for (uint64_t slot = 0; slot < sSlots; ++slot) {
+                if (mBuckets[bucketId].tags[slot] != sEmpty) {
+                    key_at (mBuckets[bucketId], slot)->~key_t ();
+                }
+            }
+        }
+    }
+
+    for (uint64_t pos = 0; pos < mStashCount; ++pos) {
+        mStash[pos].~key_t ();
+    }
+
+    delete[] mBuckets;
+    ::operator delete (mStash);
+}
+
+/**
+ * @brief                   Returns if the table could be successfully initialized
+ *
+ * @return true             If the table could be successfully initialized
+ * @return false            If the table could not be successfully initialized
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::initialized () const
+{
+    return mBuckets != nullptr;
+}
+
+/**
+ * @brief                   Returns the number of keys in the hash table (identical to get_key_count())
+ *
+ * @return uint64_t         Number of keys in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::size () const
+{
+    return mKeyCount;
+}
+
+/**
+ * @brief                   Returns the number of keys in the hash table (identical to size())
+ *
+ * @return uint64_t         Number of keys in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_key_count () const
+{
+    return mKeyCount;
+}
+
+/**
+ * @brief                   Returns the number of buckets in the hash table
+ *
+ * @return uint64_t         Number of buckets in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_bucket_count () const
+{
+    return mBucketCount;
+}
+
+/**
+ * @brief                   Returns the maximum number of buckets which the hash table can have
+ *
+ * @return uint64_t         Maximum number of buckets which the hash table can have
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_max_bucket_count () const
+{
+    return sMaxBucketsAllowed;
+}
+
+/**
+ * @brief                   Returns the number of slots in the hash table (number of buckets * slots per bucket)
+ *
+ * @return uint64_t         Number of slots in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_slot_count () const
+{
+    return mBucketCount * sSlots;
+}
+
+/**
+ * @brief                   Returns the number of keys in the stash (lookups are bounded to two buckets only while this is 0)
+ *
+ * @return uint64_t         Number of keys which could not be placed in either of their buckets
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_stash_count () const
+{
+    return mStashCount;
+}
+
+/**
+ * @brief                   Returns the maximum number of keys in the stash (keys which fit neither in their buckets nor in the stash can
+ *                          not be inserted)
+ *
+ * @return uint64_t         Maximum number of keys in the stash
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_stash_capacity () const
+{
+    return sStashCapacity;
+}
+
+DBG_MODE (
+
+/**
+ * @brief                   Returns the amount of memory currently allocated by the hash table
+ *
+ * @return uint64_t         Amount of memory (in bytes) allocated by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_alloc_amount () const
+{
+    return mAllocAmt;
+}
+
+/**
+ * @brief                   Returns the number of allocations performed by the hash table
+ *
+ * @return uint64_t         Number of allocations performed by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_alloc_count () const
+{
+    return mAllocCnt;
+}
+
+/**
+ * @brief                   Returns the number of times memory has been freed by the hash table
+ *
+ * @return uint64_t         Number of times memory has been freed by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_delete_count () const
+{
+    return mDeleteCnt;
+}
+
+/**
+ * @brief                   Returns the number of times the hash table has been resized (number of buckets have been changed)
+ *
+ * @return uint64_t         Number of times the hash table has been resized
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_resize_count () const
+{
+    return mResizeCnt;
+}
+
+/**
+ * @brief                   Returns the number of times a key has been moved to its other bucket to make room for another key
+ *
+ * @return uint64_t         Number of keys moved between buckets
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_displacement_count () const
+{
+    return mDisplaceCnt;
+}
+
+)
+
+/**
+ * @brief                   Returns the number of keys in the supplied bucket
+ *
+ * @param pBucketId         Position of the bucket whose key count is to be found
+ *
+ * @return uint64_t         Number of keys in the bucket (atmost the number of slots per bucket)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_bucket_key_count (const uint64_t &pBucketId) const
+{
+    uint64_t            keyCount    {0ULL};                         /** Number of full slots in the bucket */
+
+    if (pBucketId >= mBucketCount) {
+        return 0ULL;
+    }
+
+    for (uint64_t slot = 0; slot < sSlots; ++slot) {
+        keyCount    += (mBuckets[pBucketId].tags[slot] != sEmpty);
+    }
+
+    return keyCount;
+}
+
+/**
+ * @brief                   Returns the number of keys with unique hashs in the supplied bucket (the hashes are not stored, so every key
+ *                          is counted)
+ *
+ * @param pBucketId         Position of the bucket whose unique hash count is to be returned
+ *
+ * @return uint64_t         Number of keys in the bucket
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_bucket_hash_count (const uint64_t &pBucketId) const
+{
+    return get_bucket_key_count (pBucketId);
+}
+
+/**
+ * @brief                   Returns the primary bucket of a key (the first of its two buckets to be searched)
+ *
+ * @param pKey              Key to get the primary bucket of
+ *
+ * @return uint64_t         Position of the primary bucket of the key
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_bucket_of_key (const key_t &pKey) const
+{
+    return get_primary (ag_bucket_hash<key_t, tHashFunc> (&pKey));
+}
+
+/**
+ * @brief                   Returns if a given key exists in the hash table
+ *
+ * @param pKey              Key to search for
+ *
+ * @return true             If the supplied key exists in the hash table
+ * @return false            If the supplied key does not exist in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::exists (const key_t &pKey) const
+{
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    return find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey)) != sNotFound;
+}
+
+/**
+ * @brief                   Searches for a given key in the hash table and returns an iterator to it (returns end() if no matching key is found)
+ *
+ * @param pKey              Key to search for
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::find (const key_t &pKey) const
+{
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    return iterator {find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey)), this};
+}
+
+/**
+ * @brief                   Attempts to insert a new key into the hash table
+ *
+ *                          If both buckets of the key are full, keys are moved to their other buckets to make room, and if that is not
+ *                          possible, the table grows (if enough of its slots are used) or the key is placed in the stash
+ *
+ * @param pKey              Key to insert
+ *
+ * @return true             If the key could successfully be inserted
+ * @return false            If the key could not be inserted (duplicate key found, the key's buckets and the stash are full, or
+ *                          allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::insert (const key_t &pKey)
+{
+    hash_t              keyHash;                                    /** Hash value of the key */
+    uint64_t            bucketId;                                   /** Position of the bucket to place the key in */
+    uint64_t            slot;                                       /** Slot of the bucket to place the key in */
+
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    keyHash         = ag_bucket_hash<key_t, tHashFunc> (&pKey);
+
+    // if a duplicate key already exists, return failed insertion
+    if (find_util (pKey, keyHash) != sNotFound) {
+        return false;
+    }
+
+    while (!make_room (keyHash, bucketId, slot)) {
+
+        // if few of the slots are used, then the key's buckets are crowded by keys which share them regardless of the number of
+        // buckets (which growing would not help with), so the key is placed in the stash instead (as it is if growing fails)
+        if ((mKeyCount + 1ULL) * 100ULL < mBucketCount * sSlots * sMinGrowLoadPercent
+            || mBucketCount * sResizeFactor > sMaxBucketsAllowed
+            || !resize (mBucketCount * sResizeFactor)) {
+
+            // a full stash is not grown, since every miss searches it
+            if (!stash_push (pKey)) {
+                return false;
+            }
+
+            ++mKeyCount;
+            return true;
+        }
+    }
+
+    new (key_at (mBuckets[bucketId], slot)) key_t (pKey);
+    mBuckets[bucketId].tags[slot]   = get_tag (keyHash);
+    ++mKeyCount;
+
+    return true;
+}
+
+/**
+ * @brief                   Attempts to erase a given key from the hash table
+ *
+ * @param pKey              Key to erase
+ *
+ * @return true             If the key was successfully found and removed
+ * @return false            If the key could not be removed (no matching key was found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::erase (const key_t &pKey)
+{
+    uint64_t            pos;                                        /** Position of the slot holding the key */
+
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    pos             = find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey));
+
+    if (pos == sNotFound) {
+        return false;
+    }
+
+    if (pos < mBucketCount * sSlots) {
+        key_at (mBuckets[pos / sSlots], pos % sSlots)->~key_t ();
+        mBuckets[pos / sSlots].tags[pos % sSlots]   = sEmpty;
+    }
+    else {
+        stash_remove (pos - mBucketCount * sSlots);
+    }
+
+    --mKeyCount;
+    return true;
+}
+
+/**
+ * @brief                   Returns the 8 bit tag of a hash which is stored alongside the key (never sEmpty)
+ *
+ *                          Every bit of the hash is mixed into the tag, so that keys whose hashes only differ in their low bits (which
+ *                          choose the primary bucket) still get different tags and alternate buckets
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint8_t          Tag of the key
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint8_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_tag (const hash_t &pKeyHash)
+{
+    uint8_t             tag;                                        /** Highest byte of the mixed hash */
+
+    tag             = (uint8_t)(((uint64_t)pKeyHash * sTagMultiplier) >> 56ULL);
+
+    return (tag == sEmpty) ? (uint8_t)1 : (tag);
+}
+
+/**
+ * @brief                   Returns a pointer to the key in a slot of a bucket
+ *
+ * @param pBucket           Bucket holding the key
+ * @param pSlot             Slot of the bucket
+ *
+ * @return key_t*           Pointer to the key (only valid if the slot holds a key)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+key_t *
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::key_at (bucket_t &pBucket, const uint64_t &pSlot)
+{
+    return std::launder (reinterpret_cast<key_t *> (pBucket.keys + sizeof (key_t) * pSlot));
+}
+
+/**
+ * @brief                   Returns the primary bucket of a key with the given hash
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint64_t         Position of the primary bucket
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_primary (const hash_t &pKeyHash) const
+{
+    return (uint64_t)pKeyHash & (mBucketCount - 1);
+}
+
+/**
+ * @brief                   Returns the other bucket of a key, given the bucket it is in and its tag
+ *
+ *                          The same function gives the primary bucket from the alternate one, so a key can be moved to its other
+ *                          bucket without knowing which of the two it is in (the two are the same for a few tags in small tables)
+ *
+ * @param pBucketId         Position of the bucket the key is in
+ * @param pTag              Tag of the key
+ *
+ * @return uint64_t         Position of the other bucket
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::get_alternate (const uint64_t &pBucketId, const uint8_t &pTag) const
+{
+    return (pBucketId ^ ((uint64_t)pTag * sAlternateMultiplier)) & (mBucketCount - 1);
+}
+
+/**
+ * @brief                   Utility function to find the slot which holds a key
+ *
+ *                          The alternate bucket is prefetched before the primary bucket is searched, so that both are loaded at the
+ *                          same time
+ *
+ * @param pKey              Key to find
+ * @param pKeyHash          Hash of the given key
+ *
+ * @return uint64_t         Position of the slot holding the key (sNotFound if the key could not be found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::find_util (const key_t &pKey, const hash_t &pKeyHash) const
+{
+    const uint8_t       tag         = get_tag (pKeyHash);                       /** Tag to match */
+    const uint64_t      primary     = get_primary (pKeyHash);                   /** Position of the primary bucket of the key */
+    const uint64_t      alternate   = get_alternate (primary, tag);             /** Position of the alternate bucket of the key */
+
+    ag_prefetch (mBuckets + alternate);
+
+    for (uint64_t bucketId = primary, pass = 0; pass < 2; bucketId = alternate, ++pass) {
+
+        bucket_t        &bucket     = mBuckets[bucketId];
+
+        for (uint64_t slot = 0; slot < sSlots; ++slot) {
+            if (bucket.tags[slot] == tag && tEquals (pKey, *key_at (bucket, slot))) {
+                return bucketId * sSlots + slot;
+            }
+        }
+
+        if (alternate == primary) {
+            break;
+        }
+    }
+
+    // the stash is only searched while it holds keys, which does not happen unless many keys share the same buckets
+    for (uint64_t pos = 0; pos < mStashCount; ++pos) {
+        if (tEquals (pKey, mStash[pos])) {
+            return mBucketCount * sSlots + pos;
+        }
+    }
+
+    return sNotFound;
+}
+
+/**
+ * @brief                   Returns the position of the first full slot at or after the given position (slots of the buckets are
+ *                          followed by the stash)
+ *
+ * @param pPos              Position to start at
+ *
+ * @return uint64_t         Position of the full slot (sNotFound if there is none)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::next_full (uint64_t pPos) const
+{
+    for (; pPos < mBucketCount * sSlots; ++pPos) {
+        if (mBuckets[pPos / sSlots].tags[pPos % sSlots] != sEmpty) {
+            return pPos;
+        }
+    }
+
+    return (pPos < mBucketCount * sSlots + mStashCount) ? (pPos) : (sNotFound);
+}
+
+/**
+ * @brief                   Finds a free slot in one of the two buckets of a key with the given hash, moving other keys to their other
+ *                          buckets if both are full
+ *
+ *                          Buckets are searched breadth first, starting from the two buckets of the key, where the children of a bucket
+ *                          are the other buckets of its keys, so the first bucket found with a free slot is reached by the fewest moves
+ *                          The keys on the path to it are then moved starting from its end, so that each one moves into a slot which
+ *                          has just been freed (no bucket appears twice on a path, so no key is moved twice)
+ *
+ * @param pKeyHash          Hash of the key which needs a slot
+ * @param pBucketId         Set to the position of the bucket with the free slot
+ * @param pSlot             Set to the free slot
+ * @param pOrigins          Origin of the key planned for each slot, which is moved in place of the keys (nullptr to move the keys)
+ *
+ * @return true             If a slot was freed
+ * @return false            If no free slot was found within sMaxSearchNodes buckets
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::make_room (const hash_t &pKeyHash, uint64_t &pBucketId, uint64_t &pSlot, uint64_t *pOrigins)
+{
+    search_node_t       nodes[sMaxSearchNodes];                     /** Buckets visited by the search, in the order they were found */
+    uint64_t            nodeCount   {0ULL};                         /** Number of buckets found */
+
+    uint64_t            freeSlot;                                   /** Free slot of the bucket being visited */
+    uint64_t            child;                                      /** Other bucket of a key in the bucket being visited */
+
+    nodes[nodeCount++]  = {get_primary (pKeyHash), sNotFound, 0ULL};
+    child               = get_alternate (nodes[0].bucketId, get_tag (pKeyHash));
+
+    if (child != nodes[0].bucketId) {
+        nodes[nodeCount++]  = {child, sNotFound, 0ULL};
+    }
+
+    for (uint64_t head = 0; head < nodeCount; ++head) {
+
+        bucket_t        &bucket     = mBuckets[nodes[head].bucketId];
+
+        for (freeSlot = 0; freeSlot < sSlots && bucket.tags[freeSlot] != sEmpty; ++freeSlot);
+
+        // move the keys along the path, from the bucket with the free slot back to one of the buckets of the key
+        if (freeSlot < sSlots) {
+
+            for (uint64_t pos = head; nodes[pos].parent != sNotFound; pos = nodes[pos].parent) {
+
+                move_key (nodes[nodes[pos].parent].bucketId, nodes[pos].slot, nodes[pos].bucketId, freeSlot, pOrigins);
+                freeSlot    = nodes[pos].slot;
+                head        = nodes[pos].parent;
+            }
+
+            pBucketId   = nodes[head].bucketId;
+            pSlot       = freeSlot;
+
+            return true;
+        }
+
+        // otherwise every key of the bucket could move to its other bucket
+        for (uint64_t slot = 0; slot < sSlots && nodeCount < sMaxSearchNodes; ++slot) {
+
+            child       = get_alternate (nodes[head].bucketId, bucket.tags[slot]);
+
+            if (!on_path (nodes, head, child)) {
+                nodes[nodeCount++]  = {child, head, slot};
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief                   Checks if a bucket is on the path from one of the buckets of the key to a visited bucket (including it)
+ *
+ * @param pNodes            Buckets visited by the search
+ * @param pPos              Position (in the search) of the last bucket on the path
+ * @param pBucketId         Position of the bucket to look for
+ *
+ * @return true             If the bucket is on the path
+ * @return false            If the bucket is not on the path
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::on_path (const search_node_t *pNodes, uint64_t pPos, const uint64_t &pBucketId)
+{
+    for (; pPos != sNotFound; pPos = pNodes[pPos].parent) {
+        if (pNodes[pPos].bucketId == pBucketId) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief                   Moves a key (along with its tag) from a full slot to an empty slot
+ *
+ * @param pFromBucket       Position of the bucket holding the key
+ * @param pFromSlot         Slot holding the key
+ * @param pToBucket         Position of the bucket to move the key to
+ * @param pToSlot           Empty slot to move the key to
+ * @param pOrigins          Origin of the key planned for each slot, which is moved in place of the key (nullptr to move the key)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::move_key (const uint64_t &pFromBucket, const uint64_t &pFromSlot, const uint64_t &pToBucket, const uint64_t &pToSlot,
+                                                                                  uint64_t *pOrigins)
+{
+    key_t               *from   = key_at (mBuckets[pFromBucket], pFromSlot);   /** Key being moved */
+
+    if (pOrigins != nullptr) {
+        pOrigins[pToBucket * sSlots + pToSlot]  = pOrigins[pFromBucket * sSlots + pFromSlot];
+    }
+    else {
+        new (key_at (mBuckets[pToBucket], pToSlot)) key_t (std::move (*from));
+        from->~key_t ();
+
+        DBG_MODE (
+        ++mDisplaceCnt;
+        )
+    }
+
+    mBuckets[pToBucket].tags[pToSlot]       = mBuckets[pFromBucket].tags[pFromSlot];
+    mBuckets[pFromBucket].tags[pFromSlot]   = sEmpty;
+}
+
+/**
+ * @brief                   Allocates the stash (which holds upto sStashCapacity keys), unless it is already allocated
+ *
+ * @return true             If the stash is allocated
+ * @return false            If the stash could not be allocated
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::stash_reserve ()
+{
+    if (mStash != nullptr) {
+        return true;
+    }
+
+    mStash          = static_cast<stash_ptr_t> (::operator new (sizeof (key_t) * sStashCapacity, std::nothrow));
+
+    if (mStash == nullptr) {
+        DBG_MODE (
+        std::cout << "Allocation of stash failed" << std::endl;
+        )
+        return false;
+    }
+
+    DBG_MODE (
+    ++mAllocCnt;
+    mAllocAmt       += sizeof (key_t) * sStashCapacity;
+    )
+
+    return true;
+}
+
+/**
+ * @brief                   Places a key at the end of the stash
+ *
+ * @tparam arg_t            Type of the key (copied or moved into the stash)
+ *
+ * @param pKey              Key to place
+ *
+ * @return true             If the key was placed
+ * @return false            If the key could not be placed (the stash is full, or could not be allocated)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+template <typename arg_t>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::stash_push (arg_t &&pKey)
+{
+    if (mStashCount == sStashCapacity || !stash_reserve ()) {
+        return false;
+    }
+
+    new (mStash + mStashCount) key_t (std::forward<arg_t> (pKey));
+    ++mStashCount;
+
+    return true;
+}
+
+/**
+ * @brief                   Removes a key from the stash, moving the last key of the stash into its place
+ *
+ * @param pPos              Position of the key in the stash
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::stash_remove (const uint64_t &pPos)
+{
+    --mStashCount;
+
+    if (pPos != mStashCount) {
+        mStash[pPos]    = std::move (mStash[mStashCount]);
+    }
+
+    mStash[mStashCount].~key_t ();
+}
+
+/**
+ * @brief                   Resizes the hash table to have the supplied number of buckets
+ *
+ *                          The position of every key (including those in the stash) in the new bucket array is planned first, by
+ *                          placing only the tags along with the position each key comes from, after which the keys are moved to
+ *                          their planned positions and the old array is deleted
+ *                          If some key fits neither in its buckets nor in the stash, the plan is thrown away before any key is
+ *                          moved, so a failed resize leaves the table exactly as it was
+ *
+ * @param pNumBuckets       Number of buckets the hash table be resized to (must be a power of 2)
+ *
+ * @return true             If the hash table could be resized successfully
+ * @return false            If the hash table could not be resized successfully (allocation failure, or keys which would not fit)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::resize (const uint64_t &pNumBuckets)
+{
+    bucket_ptr_t        oldBuckets;                                 /** Bucket array being replaced */
+    uint64_t            oldCount;                                   /** Number of buckets in the array being replaced */
+    uint64_t            oldSlotCount;                               /** Number of slots in the array being replaced */
+
+    bucket_ptr_t        newBuckets;                                 /** New bucket array */
+    uint64_t            *origins;                                   /** Position each slot of the new array takes its key from (a slot of the old array, or oldSlotCount + a position in the stash) */
+    uint64_t            stashOrigins[sStashCapacity];               /** Position each key of the new stash is taken from */
+    uint64_t            stashCount  {0ULL};                         /** Number of keys planned for the new stash */
+    bool                planned     {true};                         /** Stores if every key so far could be given a position */
+
+    hash_t              keyHash;                                    /** Hash of the key being placed */
+    uint64_t            bucketId;                                   /** Position of the bucket the key is placed in */
+    uint64_t            slot;                                       /** Slot the key is placed in */
+    key_t               *from;                                      /** Key being moved */
+
+    newBuckets      = new (std::nothrow) bucket_t[pNumBuckets];
+    origins         = new (std::nothrow) uint64_t[pNumBuckets * sSlots];
+
+    if (newBuckets == nullptr || origins == nullptr) {
+        delete[] newBuckets;
+        delete[] origins;
+
+        DBG_MODE (
+        std::cout << "Allocation of new bucket array failed while resizing" << std::endl;
+        std::cout << "Present Size: " << mBucketCount << std::endl;
+        std::cout << "Target Size: " << pNumBuckets << std::endl;
+        )
+
+        return false;
+    }
+
+    oldBuckets      = mBuckets;
+    oldCount        = mBucketCount;
+    oldSlotCount    = oldCount * sSlots;
+
+    mBuckets        = newBuckets;
+    mBucketCount    = pNumBuckets;
+
+    // gives the key a position in the new array (moving the planned positions of other keys to make room) or in the new stash
+    auto        plan        = [&] (const key_t *pKey, const uint64_t &pOrigin) {
+
+        keyHash     = ag_bucket_hash<key_t, tHashFunc> (pKey);
+
+        if (make_room (keyHash, bucketId, slot, origins)) {
+            mBuckets[bucketId].tags[slot]       = get_tag (keyHash);
+            origins[bucketId * sSlots + slot]   = pOrigin;
+            return true;
+        }
+        if (stashCount < sStashCapacity) {
+            stashOrigins[stashCount++]          = pOrigin;
+            return true;
+        }
+
+        return false;
+    };
+
+    // the keys of the stash are planned first, so those which stay in it keep their order and only move towards its front
+    for (uint64_t pos = 0; planned && pos < mStashCount; ++pos) {
+        planned     = plan (mStash + pos, oldSlotCount + pos);
+    }
+    for (uint64_t pos = 0; planned && pos < oldSlotCount; ++pos) {
+        if (oldBuckets[pos / sSlots].tags[pos % sSlots] != sEmpty) {
+            planned     = plan (key_at (oldBuckets[pos / sSlots], pos % sSlots), pos);
+        }
+    }
+
+    if (!planned || (stashCount > 0 && !stash_reserve ())) {
+        mBuckets        = oldBuckets;
+        mBucketCount    = oldCount;
+
+        delete[] newBuckets;
+        delete[] origins;
+
+        return false;
+    }
+
+    // keys are moved into the buckets first, since some of them come from the stash (which is then compacted in place)
+    for (uint64_t pos = 0; pos < pNumBuckets * sSlots; ++pos) {
+
+        if (mBuckets[pos / sSlots].tags[pos % sSlots] == sEmpty) {
+            continue;
+        }
+
+        from        = (origins[pos] < oldSlotCount) ? (key_at (oldBuckets[origins[pos] / sSlots], origins[pos] % sSlots))
+                                                    : (mStash + (origins[pos] - oldSlotCount));
+
+        new (key_at (mBuckets[pos / sSlots], pos % sSlots)) key_t (std::move (*from));
+        from->~key_t ();
+    }
+
+    // every position of the stash before the one a key is taken from no longer holds a key, since the keys which stay in the stash
+    // were planned in order
+    for (uint64_t pos = 0; pos < stashCount; ++pos) {
+
+        if (stashOrigins[pos] == oldSlotCount + pos) {
+            continue;
+        }
+
+        from        = (stashOrigins[pos] < oldSlotCount) ? (key_at (oldBuckets[stashOrigins[pos] / sSlots], stashOrigins[pos] % sSlots))
+                                                         : (mStash + (stashOrigins[pos] - oldSlotCount));
+
+        new (mStash + pos) key_t (std::move (*from));
+        from->~key_t ();
+    }
+
+    mStashCount     = stashCount;
+
+    delete[] oldBuckets;
+    delete[] origins;
+
+    DBG_MODE (
+    ++mResizeCnt;
+    mAllocCnt       += 2ULL;
+    mDeleteCnt      += 2ULL;
+    mAllocAmt       += sizeof (bucket_t) * pNumBuckets;
+    mAllocAmt       -= sizeof (bucket_t) * oldCount;
+    )
+
+    return true;
+}
+
+/**
+ * @brief                   Returns an iterator to the key in the first full slot of the table
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::begin () const
+{
+    return iterator {next_full (0ULL), this};
+}
+
+/**
+ * @brief                   Returns an iterator to the logical key after the last key
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::end () const
+{
+    return iterator {sNotFound, this};
+}
+
+/**
+ * @brief                   Construct a new iterator object
+ *
+ * @param pPos              Position of the slot to be encapsulated
+ * @param pTablePtr         Pointer to the table which contains the slot
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator::iterator (const uint64_t &pPos, table_ptr_t pTablePtr) :
+    mPos {pPos}, mTablePtr {pTablePtr}
+{
+}
+
+/**
+ * @brief                   Prefix increment operator (increments the iterator if not end() and returns it)
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator::operator++ ()
+{
+    // if this is the end, return itself
+    if (mPos == sNotFound || mTablePtr == nullptr) {
+        return *this;
+    }
+
+    // move to the next full slot (or end() if there is none)
+    mPos        = mTablePtr->next_full (mPos + 1ULL);
+    return *this;
+}
+
+/**
+ * @brief                   Suffix increment operator (increments the iterator if not end() and returns a copy of the old one)
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator::operator++ (int)
+{
+    iterator    res {mPos, mTablePtr};
+
+    ++(*this);
+
+    return res;
+}
+
+/**
+ * @brief                   Dereferences and returns the key held by the encapsulated slot
+ *
+ * @return ref_t
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator::ref_t
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator::operator* () const
+{
+    const uint64_t      slotCount   = mTablePtr->mBucketCount * sSlots;     /** Number of slots in the buckets (positions after them are in the stash) */
+
+    if (mPos < slotCount) {
+        return *key_at (mTablePtr->mBuckets[mPos / sSlots], mPos % sSlots);
+    }
+
+    return mTablePtr->mStash[mPos - slotCount];
+}
+
+/**
+ * @brief                   Checks if two iterators point to the same slot in the same table
+ *
+ * @param pOther            Iterator to compare to
+ *
+ * @return true             If both iterators point to the same slot in the same table
+ * @return false            If both iterators point to different slots or different tables
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator::operator== (const iterator &pOther) const
+{
+    return (mPos == pOther.mPos) && (mTablePtr == pOther.mTablePtr);
+}
+
+/**
+ * @brief                   Checks if two iterators point to different slots
+ *
+ * @param pOther            Iterator to compare to
+ *
+ * @return true             If both iterators point to different slots (or different tables)
+ * @return false            If both iterators point to the same slot in the same table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, uint64_t tSlots, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgCuckooLayout<tSlots>, tAlloc>::iterator::operator!= (const iterator &pOther) const
+{
+    return (mPos != pOther.mPos) || (mTablePtr != pOther.mTablePtr);
+}
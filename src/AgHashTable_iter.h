@@ -5,30 +5,32 @@
  */
 
 /**
- * @brief                   Construct a new AgHashTable<key_t, tHashFunc, tEquals>::iterator object
+ * @brief                   Construct a new AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator object
  *
  * @param pPtr              Pointer to node to be encapsulated
  * @param pAggrPtr          Pointer to corresponding aggregate node
+ * @param pBucketId         Position of the bucket which contains the aggregate node
  * @param pTablePtr         Pointer to the table which contains the node
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-AgHashTable<key_t, tHashFunc, tEquals>::iterator::iterator (node_ptr_t pPtr, aggr_ptr_t pAggrPtr, table_ptr_t pTablePtr) :
-    mPtr {pPtr}, mAggrPtr {pAggrPtr}, mTablePtr {pTablePtr}
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator::iterator (node_ptr_t pPtr, aggr_ptr_t pAggrPtr, uint64_t pBucketId, table_ptr_t pTablePtr) :
+    mPtr {pPtr}, mAggrPtr {pAggrPtr}, mBucketId {pBucketId}, mTablePtr {pTablePtr}
 {
 }
 
 /**
  * @brief                   Prefix increment operator (increments the iterator if not end() and returns it)
  *
- * @return AgHashTable<key_t, tHashFunc, tEquals>::iterator
+ *                          Walks the keys of the current aggregate node, then the remaining aggregate nodes of the current bucket and
+ *                          then the following buckets, so iterating over the whole table takes time proportional to the number of
+ *                          buckets and keys
+ *
+ * @return AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-typename AgHashTable<key_t, tHashFunc, tEquals>::iterator
-AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator++ ()
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator::operator++ ()
 {
-    hash_t          newHash;                                    /** Hash value of the next key to use (only used if all keys with the current hash value have been iterated over) */
-    aggr_ptr_t      newAggrPtr;                                 /** Pointer to the new aggregate node to use (only used if all keys with the current hash value have been iterated over) */
-
     // if this is the end, return itseld
     if (mPtr == nullptr || mAggrPtr == nullptr || mTablePtr == nullptr) {
         return *this;
@@ -40,30 +42,15 @@ AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator++ ()
         return *this;
     }
 
-    // try to find the next hash which is present in the table and use the aggregate node corresponding to it
-    newHash     = mAggrPtr->keyHash;
-    while (true) {
-
-        // if all hashs have been used, return end()
-        if (++newHash == 0) {
-            mPtr        = nullptr;
-            mAggrPtr    = nullptr;
-
-            return *this;
-        }
-
-        // try to find an aggregate node with the given hash
-        newAggrPtr      = mTablePtr->getHashAggr (newHash);
-
-        // if such an aggregate node exists, break the loop
-        if (newAggrPtr != nullptr) {
-            break;
-        }
+    // if another aggregate node exists after this one in the same bucket, use its first node and return self
+    if (mAggrPtr->nextPtr != nullptr) {
+        mAggrPtr    = mAggrPtr->nextPtr;
+        mPtr        = mAggrPtr->nodePtr;
+        return *this;
     }
 
-    // use the found aggregate node and the first node in its linked list and return
-    mPtr        = newAggrPtr->nodePtr;
-    mAggrPtr    = newAggrPtr;
+    // otherwise move on to the first key in the next non-empty bucket (or end() if there is none)
+    *this       = mTablePtr->first_from_bucket (mBucketId + 1ULL);
 
     return *this;
 }
@@ -71,13 +58,13 @@ AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator++ ()
 /**
  * @brief                   Suffix increment operator (increments the iterator if not end() and returns a copy of the old one)
  *
- * @return AgHashTable<key_t, tHashFunc, tEquals>::iterator
+ * @return AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-typename AgHashTable<key_t, tHashFunc, tEquals>::iterator
-AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator++ (int)
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator::operator++ (int)
 {
-    iterator    res {mPtr, mAggrPtr, mTablePtr};
+    iterator    res {mPtr, mAggrPtr, mBucketId, mTablePtr};
 
     ++(*this);
 
@@ -87,11 +74,11 @@ AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator++ (int)
 /**
  * @brief                   Dereferences and returns the value held by the encapsulated node
  *
- * @return AgHashTable<key_t, tHashFunc, tEquals>::iterator::ref_t
+ * @return AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator::ref_t
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
-typename AgHashTable<key_t, tHashFunc, tEquals>::iterator::ref_t
-AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator* () const
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator::ref_t
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator::operator* () const
 {
     return mPtr->key;
 }
@@ -104,9 +91,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator* () const
  * @return true             If both iterators point to the same node in the same table
  * @return false            If both iterators point to different nodes or different tables
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 bool
-AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator== (const iterator &pOther) const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator::operator== (const iterator &pOther) const
 {
     return (mPtr == pOther.mPtr) && (mTablePtr == pOther.mTablePtr);
 }
@@ -119,9 +106,9 @@ AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator== (const iterator &pO
  * @return true             If both iterators point to different nodes (or different tables)
  * @return false            If both iterators point to the same node in the same table
  */
-template <typename key_t, auto tHashFunc, auto tEquals>
+template <typename key_t, auto tHashFunc, auto tEquals, typename tLayout, typename tAlloc>
 bool
-AgHashTable<key_t, tHashFunc, tEquals>::iterator::operator!= (const iterator &pOther) const
+AgHashTable<key_t, tHashFunc, tEquals, tLayout, tAlloc>::iterator::operator!= (const iterator &pOther) const
 {
     return (mPtr != pOther.mPtr) || (mTablePtr != pOther.mTablePtr);
 }
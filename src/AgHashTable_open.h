@@ -0,0 +1,970 @@
+/**
+ * @file            AgHashTable_open.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           Open addressing layout of AgHashTable (partial specialization for AgOpenAddressingLayout)
+ *
+ *                  Keys are stored inline in a flat array of slots along with their full hash, while a parallel array of
+ *                  metadata bytes stores either a 7 bit tag of the hash (linear and quadratic probing) or the probe distance
+ *                  of the slot (Robin Hood probing)
+ */
+
+/**
+ * @brief                   Open addressing implementation of AgHashTable
+ *
+ * @tparam key_t            Type of keys held by the hash table
+ * @tparam tHashFunc        Hash function to use
+ * @tparam tEquals          Comparator to use while making equals comparisons
+ * @tparam tProbe           Probe strategy to use (AgProbeLinear, AgProbeQuadratic or AgProbeRobinHood)
+ * @tparam tAlloc           Allocator policy (unused, since keys are stored inline in the slots)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+class AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc> {
+
+
+
+    protected:
+
+
+
+    using       hash_t          = typename std::invoke_result<decltype (tHashFunc), const key_t *>::type;     /** Data type returned by the hash function (must be unsigned integral type */
+
+    static_assert (std::is_unsigned<hash_t>::value, "Return type of hash functions must be unsigned integer");
+
+    /**
+     * @brief               Slot in the table, which holds a key along with its full hash
+     *
+     */
+    struct slot_t {
+
+        hash_t              keyHash;                                /** Hash value of the key held by the slot */
+        key_t               key;                                    /** Key held by the slot */
+    };
+
+    using       slot_ptr_t      = slot_t *;                                             /** Helper alias for pointers to slots/arrays of slots */
+    using       meta_ptr_t      = uint8_t *;                                            /** Helper alias for pointers to arrays of metadata bytes */
+
+
+    static constexpr uint64_t   sHashBitness            = sizeof (hash_t) * 8ULL;       /** Bitness of the return type of the hash function */
+    static constexpr uint64_t   sResizeFactor           = 2ULL;                         /** Factor by which the number of slots grows */
+    static constexpr uint64_t   sMinBucketCount         = 8ULL;                         /** Minimum number of slots in the table */
+    static constexpr uint64_t   sMaxBucketsAllowed      = 1ULL << 48;                   /** Maximum number of slots allowed in the table */
+    static constexpr uint64_t   sHomeShift              = (sHashBitness >= 32ULL) ? (7ULL) : (0ULL);    /** Low bits of the hash skipped while finding the home slot (the tag bits, unless the hash is too narrow to spare them) */
+
+    static constexpr uint8_t    sEmpty                  = 0x00;                         /** Metadata of a slot which has never held a key */
+    static constexpr uint8_t    sDeleted                = 0x01;                         /** Metadata of a slot whose key was erased (never used with Robin Hood probing) */
+    static constexpr uint8_t    sOccupied               = 0x80;                         /** Bit set in the metadata of occupied slots (linear and quadratic probing) */
+    static constexpr uint8_t    sMaxDistance            = 0xFF;                         /** Metadata of slots whose probe distance can not be represented (Robin Hood probing) */
+
+    static constexpr uint64_t   sNotFound               = std::numeric_limits<uint64_t>::max ();   /** Position returned when a key could not be found */
+
+
+
+    public:
+
+
+
+    struct iterator {
+
+        protected:
+
+        using table_ptr_t       = const AgHashTable *;
+        using ref_t             = const key_t &;
+
+        slot_ptr_t  mPtr        {nullptr};                                  /** Pointer to slot (nullptr if points to end()) */
+        table_ptr_t mTablePtr   {nullptr};                                  /** Pointer to table instance */
+
+        public:
+
+        iterator                (slot_ptr_t pPtr, table_ptr_t pTablePtr);
+        iterator                () = default;
+
+        iterator operator++     ();
+        iterator operator++     (int);
+
+        ref_t    operator*      () const;
+
+        bool     operator==     (const iterator & pOther) const;
+        bool     operator!=     (const iterator & pOther) const;
+
+    };
+
+    //  Constructors
+
+    AgHashTable     ();
+    AgHashTable     (const uint64_t &pBucketCount);
+    AgHashTable     (const AgHashTable &pOther) = delete;
+
+    //  Destructors
+
+    ~AgHashTable    ();
+
+    //  Getters
+
+    bool                initialized             () const;
+
+    uint64_t            size                    () const;
+    uint64_t            get_key_count           () const;
+
+    uint64_t            get_bucket_count        () const;
+    uint64_t            get_max_bucket_count    () const;
+
+    uint64_t            get_bucket_key_count    (const uint64_t &pBucketId) const;
+    uint64_t            get_bucket_hash_count   (const uint64_t &pBucketId) const;
+
+    uint64_t            get_bucket_of_key       (const key_t &pKey) const;
+    // Testing and debugging
+
+    DBG_MODE (
+    uint64_t            get_alloc_amount        () const;
+    uint64_t            get_alloc_count         () const;
+    uint64_t            get_delete_count        () const;
+
+    uint64_t            get_resize_count        () const;
+
+    uint64_t            get_tombstone_count     () const;
+    )
+
+    iterator            find                    (const key_t &pKey) const;
+    bool                exists                  (const key_t &pkey) const;
+
+    //  Modifiers
+
+    bool                insert                  (const key_t &pKey);
+    bool                erase                   (const key_t &pKey);
+
+    // Iterators and Iteration
+
+    iterator            begin                   () const;
+    iterator            end                     () const;
+
+
+
+    private:
+
+
+
+    // Getters
+
+    static bool         is_occupied             (const uint8_t &pMeta);
+    static uint8_t      get_tag                 (const hash_t &pKeyHash);
+
+    uint64_t            get_home                (const hash_t &pKeyHash) const;
+
+    uint64_t            get_distance            (const uint64_t &pPos, const hash_t &pKeyHash) const;
+    uint64_t            find_util               (const key_t &pKey, const hash_t &pKeyHash) const;
+
+    // Modifiers
+
+    void                init                    ();
+
+    void                place                   (hash_t pKeyHash, key_t &&pKey);
+    bool                resize                  (const uint64_t &pNumBuckets);
+
+
+    meta_ptr_t          mMeta           {nullptr};                          /** Pointer to array of metadata bytes (one per slot) */
+    slot_ptr_t          mSlots          {nullptr};                          /** Pointer to array of slots */
+
+    MULTITHREADED_MODE (
+    mutable std::shared_mutex   mLock;                                      /** Guards the whole table (keys move between slots on every modification, so the slots can not be locked independently) */
+    )
+
+    uint64_t            mKeyCount       {0ULL};                             /** Number of keys in the table */
+    uint64_t            mTombstoneCount {0ULL};                             /** Number of slots whose key was erased and which have not been reused yet */
+    uint64_t            mBucketCount    {64ULL};                            /** Number of slots in the table */
+
+    DBG_MODE (
+    uint64_t            mAllocAmt       {0ULL};                             /** Number of bytes allocated by the hash table (does not count allocations done by keys internally) */
+    uint64_t            mAllocCnt       {0ULL};                             /** Number of times operator new/malloc has been used to perform a new allocation (does not count allocations done by keys internally) */
+    uint64_t            mDeleteCnt      {0ULL};                             /** Number of times operator delete/free has been used to free up memory (does not count frees done by keys internally) */
+
+    uint64_t            mResizeCnt      {0ULL};                             /** Number of times the slot array of the table has been resized */
+    )
+
+};
+
+/**
+ * @brief                   Construct a new open addressing AgHashTable object
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::AgHashTable ()
+{
+    init ();
+}
+
+/**
+ * @brief                   Construct a new open addressing AgHashTable object
+ *
+ * @param pBucketCount      Number of slots to initialize the hash table with (rounded up to a power of 2 which is atleast sMinBucketCount)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::AgHashTable (const uint64_t &pBucketCount)
+{
+    mBucketCount        = sMinBucketCount;
+    while (mBucketCount < pBucketCount && mBucketCount < sMaxBucketsAllowed) {
+        mBucketCount    *= 2ULL;
+    }
+
+    init ();
+}
+
+/**
+ * @brief                   Initialize the hash table with the specified number of slots
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::init ()
+{
+    // try to allocate the metadata (all slots start out empty) and the slots
+    mMeta               = new (std::nothrow) uint8_t[mBucketCount] ();
+    mSlots              = static_cast<slot_ptr_t> (::operator new (sizeof (slot_t) * mBucketCount, std::nothrow));
+
+    DBG_MODE (
+    if (mMeta == nullptr || mSlots == nullptr) {
+        std::cout << "Allocation of slot array failed while constructing\n";
+    }
+    else {
+        mAllocCnt       += 2;
+        mAllocAmt       += (sizeof (slot_t) + sizeof (uint8_t)) * mBucketCount;
+    }
+    )
+
+#if defined (AG_DBG_MODE) && defined (AG_PRINT_INIT_INFO)
+    std::cout << "sizeof slot_t: " << sizeof (slot_t) << std::endl;
+#endif
+}
+
+/**
+ * @brief                   Destroy the open addressing AgHashTable object
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::~AgHashTable ()
+{
+    // destroy the keys held by all occupied slots
+    if (mMeta != nullptr && mSlots != nullptr) {
+        for (uint64_t pos = 0; pos < mBucketCount; ++pos) {
+            if (is_occupied (mMeta[pos])) {
+                mSlots[pos].~slot_t ();
+            }
+        }
+    }
+
+    delete[] mMeta;
+    ::operator delete (mSlots);
+}
+
+/**
+ * @brief                   Returns if the table could be successfully initialized
+ *
+ * @return true             If the table could be successfully initialized
+ * @return false            If the table could not be successfully initialized
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::initialized () const
+{
+    return (mMeta != nullptr) && (mSlots != nullptr);
+}
+
+/**
+ * @brief                   Returns the number of keys in the hash table (identical to get_key_count())
+ *
+ * @return uint64_t         Number of keys in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::size () const
+{
+    return mKeyCount;
+}
+
+/**
+ * @brief                   Returns the number of keys in the hash table (identical to size())
+ *
+ * @return uint64_t         Number of keys in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_key_count () const
+{
+    return mKeyCount;
+}
+
+/**
+ * @brief                   Returns the number of slots in the hash table
+ *
+ * @return uint64_t         Number of slots in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_bucket_count () const
+{
+    return mBucketCount;
+}
+
+/**
+ * @brief                   Returns the maximum number of slots which the hash table can have
+ *
+ * @return uint64_t         Maximum number of slots which the hash table can have
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_max_bucket_count () const
+{
+    return sMaxBucketsAllowed;
+}
+
+DBG_MODE (
+
+/**
+ * @brief                   Returns the amount of memory currently allocated by the hash table
+ *
+ * @return uint64_t         Amount of memory (in bytes) allocated by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_alloc_amount () const
+{
+    return mAllocAmt;
+}
+
+/**
+ * @brief                   Returns the number of allocations performed by the hash table
+ *
+ * @return uint64_t         Number of allocations performed by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_alloc_count () const
+{
+    return mAllocCnt;
+}
+
+/**
+ * @brief                   Returns the number of times memory has been freed by the hash table
+ *
+ * @return uint64_t         Number of times memory has been freed by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_delete_count () const
+{
+    return mDeleteCnt;
+}
+
+/**
+ * @brief                   Returns the number of times the hash table has been resized (number of slots have been changed)
+ *
+ * @return uint64_t         Number of times the hash table has been resized
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_resize_count () const
+{
+    return mResizeCnt;
+}
+
+/**
+ * @brief                   Returns the number of slots which hold tombstones of erased keys
+ *
+ * @return uint64_t         Number of tombstones in the table (always 0 with Robin Hood probing)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_tombstone_count () const
+{
+    return mTombstoneCount;
+}
+
+)
+
+/**
+ * @brief                   Returns the number of keys in the supplied slot
+ *
+ * @param pBucketId         Position of the slot whose key count is to be found
+ *
+ * @return uint64_t         1 if the slot holds a key, 0 otherwise
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_bucket_key_count (const uint64_t &pBucketId) const
+{
+    return (pBucketId < mBucketCount && is_occupied (mMeta[pBucketId])) ? (1ULL) : (0ULL);
+}
+
+/**
+ * @brief                   Returns the number of keys with unique hashs in the supplied slot
+ *
+ * @param pBucketId         Position of the slot whose unique hash count is to be returned
+ *
+ * @return uint64_t         1 if the slot holds a key, 0 otherwise
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_bucket_hash_count (const uint64_t &pBucketId) const
+{
+    return get_bucket_key_count (pBucketId);
+}
+
+/**
+ * @brief                   Returns the home slot of a key (the first slot probed while searching for it)
+ *
+ * @param pKey              Key to get the home slot of
+ *
+ * @return uint64_t         Home slot of the key
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_bucket_of_key (const key_t &pKey) const
+{
+    return get_home (ag_bucket_hash<key_t, tHashFunc> (&pKey));
+}
+
+/**
+ * @brief                   Returns if a given key exists in the hash table
+ *
+ * @param pKey              Key to search for
+ *
+ * @return true             If the supplied key exists in the hash table
+ * @return false            If the supplied key does not exist in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::exists (const key_t &pKey) const
+{
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    return find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey)) != sNotFound;
+}
+
+/**
+ * @brief                   Searches for a given key in the hash table and returns an iterator to it (returns end() if no matching key is found)
+ *
+ * @param pKey              Key to search for
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::find (const key_t &pKey) const
+{
+    uint64_t            pos;                                        /** Position of the slot holding the key */
+
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    pos             = find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey));
+
+    if (pos == sNotFound) {
+        return end ();
+    }
+
+    return iterator {mSlots + pos, this};
+}
+
+/**
+ * @brief                   Attempts to insert a new key into the hash table
+ *
+ * @param pKey              Key to insert
+ *
+ * @return true             If the key could successfully be inserted
+ * @return false            If the key could not be inserted (duplicate key found or allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::insert (const key_t &pKey)
+{
+    hash_t              keyHash;                                    /** Hash value of the key */
+    uint64_t            newCount;                                   /** Number of slots to resize the table to (if required) */
+
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    keyHash         = ag_bucket_hash<key_t, tHashFunc> (&pKey);
+
+    // if a duplicate key already exists, return failed insertion
+    if (find_util (pKey, keyHash) != sNotFound) {
+        return false;
+    }
+
+    // make room before placing the key if the table would become too crowded (tombstones count towards the load as they
+    // lengthen probe sequences just as much as keys do), only grow if the keys themselves take up more than half the allowed load,
+    // otherwise rebuild the table at the same size to get rid of the tombstones
+    if ((mKeyCount + mTombstoneCount + 1ULL) * 100ULL > mBucketCount * tProbe::sMaxLoadPercent) {
+
+        newCount    = ((mKeyCount + 1ULL) * 200ULL > mBucketCount * tProbe::sMaxLoadPercent) ? (mBucketCount * sResizeFactor) : (mBucketCount);
+
+        if (newCount > sMaxBucketsAllowed || !resize (newCount)) {
+            // a completely full table can not accept any more keys
+            if (mKeyCount + mTombstoneCount + 1ULL >= mBucketCount) {
+                return false;
+            }
+        }
+    }
+
+    place (keyHash, key_t {pKey});
+    ++mKeyCount;
+
+    return true;
+}
+
+/**
+ * @brief                   Attempts to erase a given key from the hash table
+ *
+ * @param pKey              Key to erase
+ *
+ * @return true             If the key was successfully found and removed
+ * @return false            If the key could not be removed (no matching key was found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::erase (const key_t &pKey)
+{
+    uint64_t            pos;                                        /** Position of the slot holding the key */
+    uint64_t            nextPos;                                    /** Position of the slot after pos */
+    uint64_t            mask;                                       /** Number of slots - 1 */
+
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    pos             = find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey));
+    mask            = mBucketCount - 1;
+
+    if (pos == sNotFound) {
+        return false;
+    }
+
+    --mKeyCount;
+
+    if constexpr (tProbe::sRobinHood) {
+
+        // shift every following key which is not in its home slot back by one, so that no gap is left in any probe sequence
+        nextPos     = (pos + 1ULL) & mask;
+        while (mMeta[nextPos] != sEmpty && get_distance (nextPos, mSlots[nextPos].keyHash) != 0) {
+
+            mSlots[pos].keyHash = mSlots[nextPos].keyHash;
+            mSlots[pos].key     = std::move (mSlots[nextPos].key);
+            mMeta[pos]          = (mMeta[nextPos] == sMaxDistance) ? (sMaxDistance) : (mMeta[nextPos] - 1);
+
+            pos         = nextPos;
+            nextPos     = (pos + 1ULL) & mask;
+        }
+
+        mSlots[pos].~slot_t ();
+        mMeta[pos]  = sEmpty;
+    }
+    else {
+
+        mSlots[pos].~slot_t ();
+
+        // with linear probing, a slot followed by an empty slot ends every probe sequence passing through it anyways, so it can
+        // be marked empty instead of leaving a tombstone behind
+        if (std::is_same<tProbe, AgProbeLinear>::value && mMeta[(pos + 1ULL) & mask] == sEmpty) {
+            mMeta[pos]  = sEmpty;
+        }
+        else {
+            mMeta[pos]  = sDeleted;
+            ++mTombstoneCount;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief                   Returns if a metadata byte represents an occupied slot
+ *
+ * @param pMeta             Metadata byte of the slot
+ *
+ * @return true             If the slot holds a key
+ * @return false            If the slot is empty or holds a tombstone
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::is_occupied (const uint8_t &pMeta)
+{
+    if constexpr (tProbe::sRobinHood) {
+        return pMeta != sEmpty;
+    }
+    else {
+        return (pMeta & sOccupied) != 0;
+    }
+}
+
+/**
+ * @brief                   Returns the metadata byte of an occupied slot holding a key with the given hash (linear and quadratic probing)
+ *
+ *                          The tag is made from the lowest 7 bits of the hash, which are not used to find the home slot (unless the
+ *                          hash is narrower than 32 bits, see get_home ())
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint8_t          Metadata byte to store
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint8_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_tag (const hash_t &pKeyHash)
+{
+    return (uint8_t)(sOccupied | ((uint64_t)pKeyHash & 0x7FULL));
+}
+
+/**
+ * @brief                   Returns the home slot of a key with the given hash (the first slot probed while searching for it)
+ *
+ *                          The lowest 7 bits of the hash make up the tag, so the remaining bits are used to find the home slot
+ *                          Hashes narrower than 32 bits are used whole, since skipping the tag bits would leave too few bits to
+ *                          spread their keys over the slots (an 8 bit hash would only reach 2 home slots)
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint64_t         Position of the home slot
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_home (const hash_t &pKeyHash) const
+{
+    return ((uint64_t)pKeyHash >> sHomeShift) & (mBucketCount - 1);
+}
+
+/**
+ * @brief                   Returns how far a slot is from the home slot of the given hash (Robin Hood probing)
+ *
+ * @param pPos              Position of the slot
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint64_t         Number of slots between the home slot and the slot
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::get_distance (const uint64_t &pPos, const hash_t &pKeyHash) const
+{
+    return (pPos - get_home (pKeyHash)) & (mBucketCount - 1);
+}
+
+/**
+ * @brief                   Utility function to find the slot which holds a key
+ *
+ * @param pKey              Key to find
+ * @param pKeyHash          Hash of the given key
+ *
+ * @return uint64_t         Position of the slot holding the key (sNotFound if the key could not be found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::find_util (const key_t &pKey, const hash_t &pKeyHash) const
+{
+    uint64_t            mask;                                       /** Number of slots - 1 */
+    uint64_t            pos;                                        /** Position of the slot being probed */
+    uint8_t             meta;                                       /** Metadata byte of the slot being probed */
+
+    mask            = mBucketCount - 1;
+    pos             = get_home (pKeyHash);
+
+    if constexpr (tProbe::sRobinHood) {
+
+        // keys are ordered by their distance from the home slot, so the search can stop at the first slot whose key is closer
+        // to its home than the searched key would be at that slot
+        for (uint64_t dist = 0; dist <= mask; ++dist) {
+
+            meta        = mMeta[pos];
+
+            if (meta == sEmpty) {
+                break;
+            }
+            if (meta != sMaxDistance && (uint64_t)(meta - 1) < dist) {
+                break;
+            }
+            if (mSlots[pos].keyHash == pKeyHash && tEquals (pKey, mSlots[pos].key)) {
+                return pos;
+            }
+
+            pos         = tProbe::next (pos, dist + 1ULL, mask);
+        }
+    }
+    else {
+
+        const uint8_t   tag     = get_tag (pKeyHash);               /** Metadata of slots which might hold the key */
+
+        // probe until an empty slot is found, skipping over tombstones and slots whose tags do not match
+        for (uint64_t step = 1; step <= mBucketCount; ++step) {
+
+            meta        = mMeta[pos];
+
+            if (meta == sEmpty) {
+                break;
+            }
+            if (meta == tag && mSlots[pos].keyHash == pKeyHash && tEquals (pKey, mSlots[pos].key)) {
+                return pos;
+            }
+
+            pos         = tProbe::next (pos, step, mask);
+        }
+    }
+
+    return sNotFound;
+}
+
+/**
+ * @brief                   Places a key which is not already present in the table into a free slot
+ *
+ *                          Assumes that atleast one free slot exists
+ *
+ * @param pKeyHash          Hash of the key
+ * @param pKey              Key to place
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::place (hash_t pKeyHash, key_t &&pKey)
+{
+    uint64_t            mask;                                       /** Number of slots - 1 */
+    uint64_t            pos;                                        /** Position of the slot being probed */
+
+    mask            = mBucketCount - 1;
+    pos             = get_home (pKeyHash);
+
+    if constexpr (tProbe::sRobinHood) {
+
+        uint64_t        dist    {0ULL};                             /** Distance of the key being placed from its home slot */
+        uint64_t        slotDist;                                   /** Distance of the key in the probed slot from its home slot */
+
+        while (mMeta[pos] != sEmpty) {
+
+            slotDist    = (mMeta[pos] == sMaxDistance) ? (get_distance (pos, mSlots[pos].keyHash)) : (mMeta[pos] - 1ULL);
+
+            // take the slot from a key which is closer to its home slot and carry on placing the displaced key
+            if (slotDist < dist) {
+                std::swap (pKeyHash, mSlots[pos].keyHash);
+                std::swap (pKey, mSlots[pos].key);
+
+                mMeta[pos]  = (dist + 1ULL >= sMaxDistance) ? (sMaxDistance) : (uint8_t)(dist + 1ULL);
+                dist        = slotDist;
+            }
+
+            pos         = tProbe::next (pos, dist + 1ULL, mask);
+            ++dist;
+        }
+
+        new (mSlots + pos) slot_t {pKeyHash, std::move (pKey)};
+        mMeta[pos]  = (dist + 1ULL >= sMaxDistance) ? (sMaxDistance) : (uint8_t)(dist + 1ULL);
+    }
+    else {
+
+        // use the first slot which is either empty or holds a tombstone
+        for (uint64_t step = 1; is_occupied (mMeta[pos]); ++step) {
+            pos         = tProbe::next (pos, step, mask);
+        }
+
+        if (mMeta[pos] == sDeleted) {
+            --mTombstoneCount;
+        }
+
+        new (mSlots + pos) slot_t {pKeyHash, std::move (pKey)};
+        mMeta[pos]  = get_tag (pKeyHash);
+    }
+}
+
+/**
+ * @brief                   Resizes the hash table to have the supplied number of slots
+ *
+ *                          Creates new arrays of the specified size and moves every key into them using its stored hash (the hash
+ *                          function is not called again), after which the old arrays are deleted
+ *
+ * @param pNumBuckets       Number of slots the hash table be resized to (must be a power of 2)
+ *
+ * @return true             If the hash table could be resized successfully
+ * @return false            If the hash table could not be resized successfully (allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::resize (const uint64_t &pNumBuckets)
+{
+    meta_ptr_t          oldMeta;                                    /** Metadata array being replaced */
+    slot_ptr_t          oldSlots;                                   /** Slot array being replaced */
+    uint64_t            oldCount;                                   /** Number of slots in the arrays being replaced */
+
+    meta_ptr_t          newMeta;                                    /** New metadata array */
+    slot_ptr_t          newSlots;                                   /** New slot array */
+
+    newMeta         = new (std::nothrow) uint8_t[pNumBuckets] ();
+    newSlots        = static_cast<slot_ptr_t> (::operator new (sizeof (slot_t) * pNumBuckets, std::nothrow));
+
+    if (newMeta == nullptr || newSlots == nullptr) {
+        DBG_MODE (
+        std::cout << "Allocation of new slot array failed while resizing" << std::endl;
+        std::cout << "Present Size: " << mBucketCount << std::endl;
+        std::cout << "Target Size: " << pNumBuckets << std::endl;
+        )
+
+        delete[] newMeta;
+        ::operator delete (newSlots);
+
+        return false;
+    }
+
+    DBG_MODE (
+    ++mResizeCnt;
+    mAllocCnt       += 2;
+    mAllocAmt       += (sizeof (slot_t) + sizeof (uint8_t)) * pNumBuckets;
+    )
+
+    oldMeta         = mMeta;
+    oldSlots        = mSlots;
+    oldCount        = mBucketCount;
+
+    mMeta           = newMeta;
+    mSlots          = newSlots;
+    mBucketCount    = pNumBuckets;
+    mTombstoneCount = 0ULL;
+
+    // move every key into the new arrays (tombstones are dropped)
+    for (uint64_t pos = 0; pos < oldCount; ++pos) {
+        if (is_occupied (oldMeta[pos])) {
+            place (oldSlots[pos].keyHash, std::move (oldSlots[pos].key));
+            oldSlots[pos].~slot_t ();
+        }
+    }
+
+    delete[] oldMeta;
+    ::operator delete (oldSlots);
+
+    DBG_MODE (
+    mDeleteCnt      += 2;
+    mAllocAmt       -= (sizeof (slot_t) + sizeof (uint8_t)) * oldCount;
+    )
+
+    return true;
+}
+
+/**
+ * @brief                   Returns an iterator to the key in the first occupied slot of the table
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::begin () const
+{
+    for (uint64_t pos = 0; pos < mBucketCount; ++pos) {
+        if (is_occupied (mMeta[pos])) {
+            return iterator {mSlots + pos, this};
+        }
+    }
+
+    return end ();
+}
+
+/**
+ * @brief                   Returns an iterator to the logical key after the last key
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::end () const
+{
+    return iterator {nullptr, this};
+}
+
+/**
+ * @brief                   Construct a new iterator object
+ *
+ * @param pPtr              Pointer to slot to be encapsulated
+ * @param pTablePtr         Pointer to the table which contains the slot
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator::iterator (slot_ptr_t pPtr, table_ptr_t pTablePtr) :
+    mPtr {pPtr}, mTablePtr {pTablePtr}
+{
+}
+
+/**
+ * @brief                   Prefix increment operator (increments the iterator if not end() and returns it)
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator::operator++ ()
+{
+    // if this is the end, return itself
+    if (mPtr == nullptr || mTablePtr == nullptr) {
+        return *this;
+    }
+
+    // move to the next occupied slot (or end() if there is none)
+    for (uint64_t pos = (uint64_t)(mPtr - mTablePtr->mSlots) + 1ULL; pos < mTablePtr->mBucketCount; ++pos) {
+        if (is_occupied (mTablePtr->mMeta[pos])) {
+            mPtr    = mTablePtr->mSlots + pos;
+            return *this;
+        }
+    }
+
+    mPtr        = nullptr;
+    return *this;
+}
+
+/**
+ * @brief                   Suffix increment operator (increments the iterator if not end() and returns a copy of the old one)
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator::operator++ (int)
+{
+    iterator    res {mPtr, mTablePtr};
+
+    ++(*this);
+
+    return res;
+}
+
+/**
+ * @brief                   Dereferences and returns the key held by the encapsulated slot
+ *
+ * @return ref_t
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator::ref_t
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator::operator* () const
+{
+    return mPtr->key;
+}
+
+/**
+ * @brief                   Checks if two iterators point to the same slot in the same table
+ *
+ * @param pOther            Iterator to compare to
+ *
+ * @return true             If both iterators point to the same slot in the same table
+ * @return false            If both iterators point to different slots or different tables
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator::operator== (const iterator &pOther) const
+{
+    return (mPtr == pOther.mPtr) && (mTablePtr == pOther.mTablePtr);
+}
+
+/**
+ * @brief                   Checks if two iterators point to different slots
+ *
+ * @param pOther            Iterator to compare to
+ *
+ * @return true             If both iterators point to different slots (or different tables)
+ * @return false            If both iterators point to the same slot in the same table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tProbe, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgOpenAddressingLayout<tProbe>, tAlloc>::iterator::operator!= (const iterator &pOther) const
+{
+    return (mPtr != pOther.mPtr) || (mTablePtr != pOther.mTablePtr);
+}
@@ -0,0 +1,1104 @@
+/**
+ * @file            AgHashTable_swiss.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           Group probing layout of AgHashTable (partial specialization for AgSwissLayout)
+ *
+ *                  Keys are stored inline in a flat array of slots, while a parallel array of control bytes stores a 7 bit
+ *                  fingerprint of the hash of each key (or a marker for empty and deleted slots)
+ *                  Lookups load a whole group of control bytes at once and compare all of them against the fingerprint of the
+ *                  key using SIMD instructions (AVX2 or SSE2) when available, or using bit tricks on 64 bit integers otherwise
+ *                  Defining AG_HASH_TABLE_NO_SIMD before including AgHashTable.h forces the portable implementation
+ */
+
+#if !defined (AG_HASH_TABLE_NO_SIMD) && defined (__AVX2__)
+#define     AG_SWISS_GROUP_AVX2
+#include <immintrin.h>
+#elif !defined (AG_HASH_TABLE_NO_SIMD) && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define     AG_SWISS_GROUP_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined (_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief                   Operations on a group of consecutive control bytes
+ *
+ *                          Every match function returns a bitmask with one (SIMD) or eight (portable) bits per control byte, which
+ *                          should only be inspected using the other functions of this struct
+ */
+struct AgSwissGroup {
+
+    using       mask_t          = uint64_t;                                             /** Type of the bitmasks returned by match functions */
+
+    static constexpr int8_t     sEmpty                  = -128;                         /** Control byte of a slot which has never held a key */
+    static constexpr int8_t     sDeleted                = -2;                           /** Control byte of a slot whose key was erased */
+
+#if defined (AG_SWISS_GROUP_AVX2)
+    static constexpr uint64_t   sWidth                  = 32ULL;                        /** Number of control bytes in a group */
+    static constexpr uint64_t   sShift                  = 0ULL;                         /** log2 of the number of bits per control byte in a bitmask */
+#elif defined (AG_SWISS_GROUP_SSE2)
+    static constexpr uint64_t   sWidth                  = 16ULL;                        /** Number of control bytes in a group */
+    static constexpr uint64_t   sShift                  = 0ULL;                         /** log2 of the number of bits per control byte in a bitmask */
+#else
+    static constexpr uint64_t   sWidth                  = 8ULL;                         /** Number of control bytes in a group */
+    static constexpr uint64_t   sShift                  = 3ULL;                         /** log2 of the number of bits per control byte in a bitmask */
+
+    static constexpr uint64_t   sLsbs                   = 0x0101010101010101ULL;        /** Lowest bit of every byte */
+    static constexpr uint64_t   sMsbs                   = 0x8080808080808080ULL;        /** Highest bit of every byte */
+
+    /**
+     * @brief               Loads a group of control bytes into an integer, such that the first control byte is the least significant byte
+     *
+     * @param pCtrl         Pointer to the first control byte of the group
+     *
+     * @return uint64_t     Loaded group
+     */
+    static uint64_t
+    load (const int8_t *pCtrl)
+    {
+        uint64_t    res;
+
+        memcpy (&res, pCtrl, sizeof (res));
+
+#if defined (__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        res     = __builtin_bswap64 (res);
+#endif
+
+        return res;
+    }
+#endif
+
+    /**
+     * @brief               Returns a bitmask of the control bytes which are equal to the given fingerprint
+     *
+     *                      The portable implementation may report false positives (never false negatives), which are
+     *                      eliminated anyways when the keys are compared
+     *
+     * @param pCtrl         Pointer to the first control byte of the group
+     * @param pH2           Fingerprint to match
+     *
+     * @return mask_t       Bitmask of matching control bytes
+     */
+    static mask_t
+    match (const int8_t *pCtrl, const int8_t &pH2)
+    {
+#if defined (AG_SWISS_GROUP_AVX2)
+        const __m256i   ctrl    = _mm256_loadu_si256 ((const __m256i *)pCtrl);
+        return (uint32_t)_mm256_movemask_epi8 (_mm256_cmpeq_epi8 (ctrl, _mm256_set1_epi8 (pH2)));
+#elif defined (AG_SWISS_GROUP_SSE2)
+        const __m128i   ctrl    = _mm_loadu_si128 ((const __m128i *)pCtrl);
+        return (uint16_t)_mm_movemask_epi8 (_mm_cmpeq_epi8 (ctrl, _mm_set1_epi8 (pH2)));
+#else
+        const uint64_t  diff    = load (pCtrl) ^ (sLsbs * (uint8_t)pH2);
+        return (diff - sLsbs) & ~diff & sMsbs;
+#endif
+    }
+
+    /**
+     * @brief               Returns a bitmask of the empty control bytes
+     *
+     * @param pCtrl         Pointer to the first control byte of the group
+     *
+     * @return mask_t       Bitmask of empty control bytes
+     */
+    static mask_t
+    match_empty (const int8_t *pCtrl)
+    {
+#if defined (AG_SWISS_GROUP_AVX2)
+        const __m256i   ctrl    = _mm256_loadu_si256 ((const __m256i *)pCtrl);
+        return (uint32_t)_mm256_movemask_epi8 (_mm256_cmpeq_epi8 (ctrl, _mm256_set1_epi8 (sEmpty)));
+#elif defined (AG_SWISS_GROUP_SSE2)
+        const __m128i   ctrl    = _mm_loadu_si128 ((const __m128i *)pCtrl);
+        return (uint16_t)_mm_movemask_epi8 (_mm_cmpeq_epi8 (ctrl, _mm_set1_epi8 (sEmpty)));
+#else
+        // empty (0x80) and deleted (0xFE) are the only bytes with the highest bit set, and only deleted has the second lowest bit set
+        const uint64_t  ctrl    = load (pCtrl);
+        return ctrl & ~(ctrl << 6) & sMsbs;
+#endif
+    }
+
+    /**
+     * @brief               Returns a bitmask of the control bytes which are either empty or deleted
+     *
+     * @param pCtrl         Pointer to the first control byte of the group
+     *
+     * @return mask_t       Bitmask of empty or deleted control bytes
+     */
+    static mask_t
+    match_empty_or_deleted (const int8_t *pCtrl)
+    {
+#if defined (AG_SWISS_GROUP_AVX2)
+        return (uint32_t)_mm256_movemask_epi8 (_mm256_loadu_si256 ((const __m256i *)pCtrl));
+#elif defined (AG_SWISS_GROUP_SSE2)
+        return (uint16_t)_mm_movemask_epi8 (_mm_loadu_si128 ((const __m128i *)pCtrl));
+#else
+        return load (pCtrl) & sMsbs;
+#endif
+    }
+
+    /**
+     * @brief               Returns the position (within the group) of the first control byte in a non-empty bitmask
+     *
+     * @param pMask         Bitmask returned by a match function
+     *
+     * @return uint64_t     Position of the first control byte in the bitmask
+     */
+    static uint64_t
+    lowest (const mask_t &pMask)
+    {
+#if defined (_MSC_VER)
+        unsigned long   idx;
+        _BitScanForward64 (&idx, pMask);
+        return (uint64_t)idx >> sShift;
+#else
+        return (uint64_t)__builtin_ctzll (pMask) >> sShift;
+#endif
+    }
+
+    /**
+     * @brief               Returns the bitmask without its first control byte
+     *
+     * @param pMask         Bitmask returned by a match function
+     *
+     * @return mask_t       Bitmask without the first control byte
+     */
+    static mask_t
+    next (const mask_t &pMask)
+    {
+        return pMask & (pMask - 1ULL);
+    }
+
+    /**
+     * @brief               Returns the number of control bytes at the start of the group which are not in a bitmask
+     *
+     * @param pMask         Bitmask returned by a match function
+     *
+     * @return uint64_t     Number of leading control bytes not in the bitmask
+     */
+    static uint64_t
+    trailing_slots (const mask_t &pMask)
+    {
+        return (pMask == 0) ? (sWidth) : (lowest (pMask));
+    }
+
+    /**
+     * @brief               Returns the number of control bytes at the end of the group which are not in a bitmask
+     *
+     * @param pMask         Bitmask returned by a match function
+     *
+     * @return uint64_t     Number of trailing control bytes not in the bitmask
+     */
+    static uint64_t
+    leading_slots (const mask_t &pMask)
+    {
+        uint64_t        zeros;
+
+        if (pMask == 0) {
+            return sWidth;
+        }
+
+#if defined (_MSC_VER)
+        unsigned long   idx;
+        _BitScanReverse64 (&idx, pMask);
+        zeros   = 63ULL - (uint64_t)idx;
+#else
+        zeros   = (uint64_t)__builtin_clzll (pMask);
+#endif
+
+        // bitmasks of the SIMD implementations only use the lowest sWidth bits
+        if constexpr (sShift == 0) {
+            return zeros - (64ULL - sWidth);
+        }
+        else {
+            return zeros >> sShift;
+        }
+    }
+};
+
+/**
+ * @brief                   Group probing implementation of AgHashTable
+ *
+ * @tparam key_t            Type of keys held by the hash table
+ * @tparam tHashFunc        Hash function to use
+ * @tparam tEquals          Comparator to use while making equals comparisons
+ * @tparam tAlloc           Allocator policy (unused, since keys are stored inline in the slots)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+class AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc> {
+
+
+
+    protected:
+
+
+
+    using       hash_t          = typename std::invoke_result<decltype (tHashFunc), const key_t *>::type;     /** Data type returned by the hash function (must be unsigned integral type */
+
+    static_assert (std::is_unsigned<hash_t>::value, "Return type of hash functions must be unsigned integer");
+
+    using       slot_ptr_t      = key_t *;                                              /** Helper alias for pointers to slots/arrays of slots */
+    using       ctrl_ptr_t      = int8_t *;                                             /** Helper alias for pointers to arrays of control bytes */
+    using       group_t         = AgSwissGroup;                                         /** Helper alias for group operations */
+
+
+    static constexpr uint64_t   sHashBitness            = sizeof (hash_t) * 8ULL;       /** Bitness of the return type of the hash function */
+    static constexpr uint64_t   sGroupWidth             = group_t::sWidth;              /** Number of slots probed at a time */
+    static constexpr uint64_t   sResizeFactor           = 2ULL;                         /** Factor by which the number of slots grows */
+    static constexpr uint64_t   sMaxLoadNumerator       = 7ULL;                         /** Numerator of the fraction of slots (including deleted ones) which may be used before growing */
+    static constexpr uint64_t   sMaxLoadDenominator     = 8ULL;                         /** Denominator of the fraction of slots (including deleted ones) which may be used before growing */
+    static constexpr uint64_t   sMaxBucketsAllowed      = 1ULL << 48;                   /** Maximum number of slots allowed in the table */
+    static constexpr uint64_t   sHomeShift              = (sHashBitness >= 32ULL) ? (7ULL) : (0ULL);    /** Low bits of the hash skipped while finding the home slot (the fingerprint bits, unless the hash is too narrow to spare them) */
+
+    static constexpr uint64_t   sNotFound               = std::numeric_limits<uint64_t>::max ();   /** Position returned when a key could not be found */
+
+
+
+    public:
+
+
+
+    struct iterator {
+
+        protected:
+
+        using table_ptr_t       = const AgHashTable *;
+        using ref_t             = const key_t &;
+
+        slot_ptr_t  mPtr        {nullptr};                                  /** Pointer to slot (nullptr if points to end()) */
+        table_ptr_t mTablePtr   {nullptr};                                  /** Pointer to table instance */
+
+        public:
+
+        iterator                (slot_ptr_t pPtr, table_ptr_t pTablePtr);
+        iterator                () = default;
+
+        iterator operator++     ();
+        iterator operator++     (int);
+
+        ref_t    operator*      () const;
+
+        bool     operator==     (const iterator & pOther) const;
+        bool     operator!=     (const iterator & pOther) const;
+
+    };
+
+    //  Constructors
+
+    AgHashTable     ();
+    AgHashTable     (const uint64_t &pBucketCount);
+    AgHashTable     (const AgHashTable &pOther) = delete;
+
+    //  Destructors
+
+    ~AgHashTable    ();
+
+    //  Getters
+
+    bool                initialized             () const;
+
+    uint64_t            size                    () const;
+    uint64_t            get_key_count           () const;
+
+    uint64_t            get_bucket_count        () const;
+    uint64_t            get_max_bucket_count    () const;
+
+    uint64_t            get_bucket_key_count    (const uint64_t &pBucketId) const;
+    uint64_t            get_bucket_hash_count   (const uint64_t &pBucketId) const;
+
+    uint64_t            get_bucket_of_key       (const key_t &pKey) const;
+    // Testing and debugging
+
+    DBG_MODE (
+    uint64_t            get_alloc_amount        () const;
+    uint64_t            get_alloc_count         () const;
+    uint64_t            get_delete_count        () const;
+
+    uint64_t            get_resize_count        () const;
+
+    uint64_t            get_tombstone_count     () const;
+    )
+
+    iterator            find                    (const key_t &pKey) const;
+    bool                exists                  (const key_t &pkey) const;
+
+    //  Modifiers
+
+    bool                insert                  (const key_t &pKey);
+    bool                erase                   (const key_t &pKey);
+
+    // Iterators and Iteration
+
+    iterator            begin                   () const;
+    iterator            end                     () const;
+
+
+
+    private:
+
+
+
+    // Getters
+
+    static int8_t       get_h2                  (const hash_t &pKeyHash);
+
+    uint64_t            get_home                (const hash_t &pKeyHash) const;
+
+    uint64_t            find_util               (const key_t &pKey, const hash_t &pKeyHash) const;
+    uint64_t            find_free               (const hash_t &pKeyHash) const;
+
+    // Modifiers
+
+    void                init                    ();
+
+    void                set_ctrl                (const uint64_t &pPos, const int8_t &pCtrl);
+    bool                resize                  (const uint64_t &pNumBuckets);
+
+
+    ctrl_ptr_t          mCtrl           {nullptr};                          /** Pointer to array of control bytes (one per slot, followed by copies of the first group) */
+    slot_ptr_t          mSlots          {nullptr};                          /** Pointer to array of slots */
+
+    MULTITHREADED_MODE (
+    mutable std::shared_mutex   mLock;                                      /** Guards the whole table (keys move between slots on every modification, so the slots can not be locked independently) */
+    )
+
+    uint64_t            mKeyCount       {0ULL};                             /** Number of keys in the table */
+    uint64_t            mTombstoneCount {0ULL};                             /** Number of deleted slots which have not been reused yet */
+    uint64_t            mBucketCount    {64ULL};                            /** Number of slots in the table */
+
+    DBG_MODE (
+    uint64_t            mAllocAmt       {0ULL};                             /** Number of bytes allocated by the hash table (does not count allocations done by keys internally) */
+    uint64_t            mAllocCnt       {0ULL};                             /** Number of times operator new/malloc has been used to perform a new allocation (does not count allocations done by keys internally) */
+    uint64_t            mDeleteCnt      {0ULL};                             /** Number of times operator delete/free has been used to free up memory (does not count frees done by keys internally) */
+
+    uint64_t            mResizeCnt      {0ULL};                             /** Number of times the slot array of the table has been resized */
+    )
+
+};
+
+/**
+ * @brief                   Construct a new group probing AgHashTable object
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::AgHashTable ()
+{
+    init ();
+}
+
+/**
+ * @brief                   Construct a new group probing AgHashTable object
+ *
+ * @param pBucketCount      Number of slots to initialize the hash table with (rounded up to a power of 2 which is atleast the group width)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::AgHashTable (const uint64_t &pBucketCount)
+{
+    mBucketCount        = sGroupWidth;
+    while (mBucketCount < pBucketCount && mBucketCount < sMaxBucketsAllowed) {
+        mBucketCount    *= 2ULL;
+    }
+
+    init ();
+}
+
+/**
+ * @brief                   Initialize the hash table with the specified number of slots
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::init ()
+{
+    // try to allocate the control bytes (all slots start out empty) and the slots
+    mCtrl               = new (std::nothrow) int8_t[mBucketCount + sGroupWidth];
+    mSlots              = static_cast<slot_ptr_t> (::operator new (sizeof (key_t) * mBucketCount, std::nothrow));
+
+    if (mCtrl != nullptr) {
+        memset (mCtrl, (uint8_t)group_t::sEmpty, mBucketCount + sGroupWidth);
+    }
+
+    DBG_MODE (
+    if (mCtrl == nullptr || mSlots == nullptr) {
+        std::cout << "Allocation of slot array failed while constructing\n";
+    }
+    else {
+        mAllocCnt       += 2;
+        mAllocAmt       += (sizeof (key_t) + sizeof (int8_t)) * mBucketCount + sizeof (int8_t) * sGroupWidth;
+    }
+    )
+
+#if defined (AG_DBG_MODE) && defined (AG_PRINT_INIT_INFO)
+    std::cout << "group width: " << sGroupWidth << std::endl;
+#endif
+}
+
+/**
+ * @brief                   Destroy the group probing AgHashTable object
+ *
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::~AgHashTable ()
+{
+    // destroy the keys held by all full slots
+    if (mCtrl != nullptr && mSlots != nullptr) {
+        for (uint64_t pos = 0; pos < mBucketCount; ++pos) {
+            if (mCtrl[pos] >= 0) {
+                mSlots[pos].~key_t ();
+            }
+        }
+    }
+
+    delete[] mCtrl;
+    ::operator delete (mSlots);
+}
+
+/**
+ * @brief                   Returns if the table could be successfully initialized
+ *
+ * @return true             If the table could be successfully initialized
+ * @return false            If the table could not be successfully initialized
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::initialized () const
+{
+    return (mCtrl != nullptr) && (mSlots != nullptr);
+}
+
+/**
+ * @brief                   Returns the number of keys in the hash table (identical to get_key_count())
+ *
+ * @return uint64_t         Number of keys in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::size () const
+{
+    return mKeyCount;
+}
+
+/**
+ * @brief                   Returns the number of keys in the hash table (identical to size())
+ *
+ * @return uint64_t         Number of keys in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_key_count () const
+{
+    return mKeyCount;
+}
+
+/**
+ * @brief                   Returns the number of slots in the hash table
+ *
+ * @return uint64_t         Number of slots in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_bucket_count () const
+{
+    return mBucketCount;
+}
+
+/**
+ * @brief                   Returns the maximum number of slots which the hash table can have
+ *
+ * @return uint64_t         Maximum number of slots which the hash table can have
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_max_bucket_count () const
+{
+    return sMaxBucketsAllowed;
+}
+
+DBG_MODE (
+
+/**
+ * @brief                   Returns the amount of memory currently allocated by the hash table
+ *
+ * @return uint64_t         Amount of memory (in bytes) allocated by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_alloc_amount () const
+{
+    return mAllocAmt;
+}
+
+/**
+ * @brief                   Returns the number of allocations performed by the hash table
+ *
+ * @return uint64_t         Number of allocations performed by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_alloc_count () const
+{
+    return mAllocCnt;
+}
+
+/**
+ * @brief                   Returns the number of times memory has been freed by the hash table
+ *
+ * @return uint64_t         Number of times memory has been freed by the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_delete_count () const
+{
+    return mDeleteCnt;
+}
+
+/**
+ * @brief                   Returns the number of times the hash table has been resized (number of slots have been changed)
+ *
+ * @return uint64_t         Number of times the hash table has been resized
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_resize_count () const
+{
+    return mResizeCnt;
+}
+
+/**
+ * @brief                   Returns the number of slots which are marked as deleted
+ *
+ * @return uint64_t         Number of deleted slots in the table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_tombstone_count () const
+{
+    return mTombstoneCount;
+}
+
+)
+
+/**
+ * @brief                   Returns the number of keys in the supplied slot
+ *
+ * @param pBucketId         Position of the slot whose key count is to be found
+ *
+ * @return uint64_t         1 if the slot holds a key, 0 otherwise
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_bucket_key_count (const uint64_t &pBucketId) const
+{
+    return (pBucketId < mBucketCount && mCtrl[pBucketId] >= 0) ? (1ULL) : (0ULL);
+}
+
+/**
+ * @brief                   Returns the number of keys with unique hashs in the supplied slot
+ *
+ * @param pBucketId         Position of the slot whose unique hash count is to be returned
+ *
+ * @return uint64_t         1 if the slot holds a key, 0 otherwise
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_bucket_hash_count (const uint64_t &pBucketId) const
+{
+    return get_bucket_key_count (pBucketId);
+}
+
+/**
+ * @brief                   Returns the home slot of a key (the first slot of the first group probed while searching for it)
+ *
+ * @param pKey              Key to get the home slot of
+ *
+ * @return uint64_t         Home slot of the key
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_bucket_of_key (const key_t &pKey) const
+{
+    return get_home (ag_bucket_hash<key_t, tHashFunc> (&pKey));
+}
+
+/**
+ * @brief                   Returns if a given key exists in the hash table
+ *
+ * @param pKey              Key to search for
+ *
+ * @return true             If the supplied key exists in the hash table
+ * @return false            If the supplied key does not exist in the hash table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::exists (const key_t &pKey) const
+{
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    return find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey)) != sNotFound;
+}
+
+/**
+ * @brief                   Searches for a given key in the hash table and returns an iterator to it (returns end() if no matching key is found)
+ *
+ * @param pKey              Key to search for
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::find (const key_t &pKey) const
+{
+    uint64_t            pos;                                        /** Position of the slot holding the key */
+
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    pos             = find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey));
+
+    if (pos == sNotFound) {
+        return end ();
+    }
+
+    return iterator {mSlots + pos, this};
+}
+
+/**
+ * @brief                   Attempts to insert a new key into the hash table
+ *
+ * @param pKey              Key to insert
+ *
+ * @return true             If the key could successfully be inserted
+ * @return false            If the key could not be inserted (duplicate key found or allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::insert (const key_t &pKey)
+{
+    hash_t              keyHash;                                    /** Hash value of the key */
+    uint64_t            newCount;                                   /** Number of slots to resize the table to (if required) */
+    uint64_t            pos;                                        /** Position of the slot to place the key in */
+
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    keyHash         = ag_bucket_hash<key_t, tHashFunc> (&pKey);
+
+    // if a duplicate key already exists, return failed insertion
+    if (find_util (pKey, keyHash) != sNotFound) {
+        return false;
+    }
+
+    // make room before placing the key if the table would become too crowded, only grow if the keys themselves take up more
+    // than half the allowed load, otherwise rebuild the table at the same size to get rid of the deleted slots
+    if ((mKeyCount + mTombstoneCount + 1ULL) * sMaxLoadDenominator > mBucketCount * sMaxLoadNumerator) {
+
+        newCount    = ((mKeyCount + 1ULL) * 2ULL * sMaxLoadDenominator > mBucketCount * sMaxLoadNumerator) ? (mBucketCount * sResizeFactor) : (mBucketCount);
+
+        if (newCount > sMaxBucketsAllowed || !resize (newCount)) {
+            // a table whose every slot holds a key can not accept any more keys (deleted slots can still be reused)
+            if (mKeyCount + 1ULL > mBucketCount) {
+                return false;
+            }
+        }
+    }
+
+    pos             = find_free (keyHash);
+
+    if (mCtrl[pos] == group_t::sDeleted) {
+        --mTombstoneCount;
+    }
+
+    new (mSlots + pos) key_t (pKey);
+    set_ctrl (pos, get_h2 (keyHash));
+    ++mKeyCount;
+
+    return true;
+}
+
+/**
+ * @brief                   Attempts to erase a given key from the hash table
+ *
+ * @param pKey              Key to erase
+ *
+ * @return true             If the key was successfully found and removed
+ * @return false            If the key could not be removed (no matching key was found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::erase (const key_t &pKey)
+{
+    uint64_t            pos;                                        /** Position of the slot holding the key */
+    group_t::mask_t     emptyBefore;                                /** Empty slots in the group ending just before the slot */
+    group_t::mask_t     emptyAfter;                                 /** Empty slots in the group starting at the slot */
+
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex>     tableLock   {mLock};
+    )
+
+    pos             = find_util (pKey, ag_bucket_hash<key_t, tHashFunc> (&pKey));
+
+    if (pos == sNotFound) {
+        return false;
+    }
+
+    mSlots[pos].~key_t ();
+    --mKeyCount;
+
+    // if every window of sGroupWidth slots containing this slot also contains an empty slot, then no probe sequence has ever
+    // continued past this slot, so it can be marked empty rather than deleted
+    emptyBefore     = group_t::match_empty (mCtrl + ((pos - sGroupWidth) & (mBucketCount - 1)));
+    emptyAfter      = group_t::match_empty (mCtrl + pos);
+
+    if (emptyBefore != 0 && emptyAfter != 0
+        && (group_t::leading_slots (emptyBefore) + group_t::trailing_slots (emptyAfter)) < sGroupWidth) {
+        set_ctrl (pos, group_t::sEmpty);
+    }
+    else {
+        set_ctrl (pos, group_t::sDeleted);
+        ++mTombstoneCount;
+    }
+
+    return true;
+}
+
+/**
+ * @brief                   Returns the 7 bit fingerprint of a hash which is stored in the control byte
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return int8_t           Control byte of a full slot holding a key with the given hash
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+int8_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_h2 (const hash_t &pKeyHash)
+{
+    return (int8_t)((uint64_t)pKeyHash & 0x7FULL);
+}
+
+/**
+ * @brief                   Returns the position of the first slot probed for a key with the given hash
+ *
+ *                          The lowest 7 bits of the hash make up the fingerprint, so the remaining bits are used to find the position
+ *                          Hashes narrower than 32 bits are used whole, since skipping the fingerprint bits would leave too few bits to
+ *                          spread their keys over the groups
+ *
+ * @param pKeyHash          Hash of the key
+ *
+ * @return uint64_t         Position of the home slot
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::get_home (const hash_t &pKeyHash) const
+{
+    return ((uint64_t)pKeyHash >> sHomeShift) & (mBucketCount - 1);
+}
+
+/**
+ * @brief                   Utility function to find the slot which holds a key
+ *
+ *                          Groups are probed at triangular offsets (in units of the group width) from the home slot, which
+ *                          visits every group when the number of slots is a power of 2
+ *
+ * @param pKey              Key to find
+ * @param pKeyHash          Hash of the given key
+ *
+ * @return uint64_t         Position of the slot holding the key (sNotFound if the key could not be found)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::find_util (const key_t &pKey, const hash_t &pKeyHash) const
+{
+    const int8_t        h2      = get_h2 (pKeyHash);                /** Fingerprint to match */
+    const uint64_t      mask    = mBucketCount - 1;                 /** Number of slots - 1 */
+
+    uint64_t            pos;                                        /** Position of the first slot of the group being probed */
+    uint64_t            idx;                                        /** Position of a slot whose control byte matches */
+
+    pos             = get_home (pKeyHash);
+
+    for (uint64_t step = 1; step <= mBucketCount / sGroupWidth; ++step) {
+
+        // compare the keys in all slots whose fingerprint matches
+        for (group_t::mask_t match = group_t::match (mCtrl + pos, h2); match != 0; match = group_t::next (match)) {
+
+            idx     = (pos + group_t::lowest (match)) & mask;
+
+            if (tEquals (pKey, mSlots[idx])) {
+                return idx;
+            }
+        }
+
+        // a group with an empty slot ends the probe sequence, since the key would have been placed there
+        if (group_t::match_empty (mCtrl + pos) != 0) {
+            break;
+        }
+
+        pos         = (pos + step * sGroupWidth) & mask;
+    }
+
+    return sNotFound;
+}
+
+/**
+ * @brief                   Utility function to find the first empty or deleted slot in the probe sequence of the given hash
+ *
+ *                          Assumes that atleast one such slot exists
+ *
+ * @param pKeyHash          Hash of the key to place
+ *
+ * @return uint64_t         Position of the slot
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+uint64_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::find_free (const hash_t &pKeyHash) const
+{
+    const uint64_t      mask    = mBucketCount - 1;                 /** Number of slots - 1 */
+
+    uint64_t            pos;                                        /** Position of the first slot of the group being probed */
+    group_t::mask_t     match;                                      /** Empty and deleted slots in the group */
+
+    pos             = get_home (pKeyHash);
+
+    for (uint64_t step = 1; ; ++step) {
+
+        match       = group_t::match_empty_or_deleted (mCtrl + pos);
+
+        if (match != 0) {
+            return (pos + group_t::lowest (match)) & mask;
+        }
+
+        pos         = (pos + step * sGroupWidth) & mask;
+    }
+}
+
+/**
+ * @brief                   Sets the control byte of a slot (and its copy after the end of the array if the slot is in the first group)
+ *
+ * @param pPos              Position of the slot
+ * @param pCtrl             Control byte to set
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+void
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::set_ctrl (const uint64_t &pPos, const int8_t &pCtrl)
+{
+    mCtrl[pPos]     = pCtrl;
+
+    // groups which start near the end of the array read the copies instead of wrapping around
+    if (pPos < sGroupWidth) {
+        mCtrl[mBucketCount + pPos]  = pCtrl;
+    }
+}
+
+/**
+ * @brief                   Resizes the hash table to have the supplied number of slots
+ *
+ *                          Creates new arrays of the specified size and moves every key into them, after which the old arrays are deleted
+ *
+ * @param pNumBuckets       Number of slots the hash table be resized to (must be a power of 2)
+ *
+ * @return true             If the hash table could be resized successfully
+ * @return false            If the hash table could not be resized successfully (allocation failure)
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::resize (const uint64_t &pNumBuckets)
+{
+    ctrl_ptr_t          oldCtrl;                                    /** Control byte array being replaced */
+    slot_ptr_t          oldSlots;                                   /** Slot array being replaced */
+    uint64_t            oldCount;                                   /** Number of slots in the arrays being replaced */
+
+    ctrl_ptr_t          newCtrl;                                    /** New control byte array */
+    slot_ptr_t          newSlots;                                   /** New slot array */
+
+    hash_t              keyHash;                                    /** Hash of the key being moved */
+    uint64_t            pos;                                        /** Position of the slot the key is moved to */
+
+    newCtrl         = new (std::nothrow) int8_t[pNumBuckets + sGroupWidth];
+    newSlots        = static_cast<slot_ptr_t> (::operator new (sizeof (key_t) * pNumBuckets, std::nothrow));
+
+    if (newCtrl == nullptr || newSlots == nullptr) {
+        DBG_MODE (
+        std::cout << "Allocation of new slot array failed while resizing" << std::endl;
+        std::cout << "Present Size: " << mBucketCount << std::endl;
+        std::cout << "Target Size: " << pNumBuckets << std::endl;
+        )
+
+        delete[] newCtrl;
+        ::operator delete (newSlots);
+
+        return false;
+    }
+
+    memset (newCtrl, (uint8_t)group_t::sEmpty, pNumBuckets + sGroupWidth);
+
+    DBG_MODE (
+    ++mResizeCnt;
+    mAllocCnt       += 2;
+    mAllocAmt       += (sizeof (key_t) + sizeof (int8_t)) * pNumBuckets + sizeof (int8_t) * sGroupWidth;
+    )
+
+    oldCtrl         = mCtrl;
+    oldSlots        = mSlots;
+    oldCount        = mBucketCount;
+
+    mCtrl           = newCtrl;
+    mSlots          = newSlots;
+    mBucketCount    = pNumBuckets;
+    mTombstoneCount = 0ULL;
+
+    // move every key into the new arrays (deleted slots are dropped)
+    for (uint64_t oldPos = 0; oldPos < oldCount; ++oldPos) {
+        if (oldCtrl[oldPos] >= 0) {
+
+            keyHash     = ag_bucket_hash<key_t, tHashFunc> (oldSlots + oldPos);
+            pos         = find_free (keyHash);
+
+            new (mSlots + pos) key_t (std::move (oldSlots[oldPos]));
+            set_ctrl (pos, get_h2 (keyHash));
+
+            oldSlots[oldPos].~key_t ();
+        }
+    }
+
+    delete[] oldCtrl;
+    ::operator delete (oldSlots);
+
+    DBG_MODE (
+    mDeleteCnt      += 2;
+    mAllocAmt       -= (sizeof (key_t) + sizeof (int8_t)) * oldCount + sizeof (int8_t) * sGroupWidth;
+    )
+
+    return true;
+}
+
+/**
+ * @brief                   Returns an iterator to the key in the first full slot of the table
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::begin () const
+{
+    for (uint64_t pos = 0; pos < mBucketCount; ++pos) {
+        if (mCtrl[pos] >= 0) {
+            return iterator {mSlots + pos, this};
+        }
+    }
+
+    return end ();
+}
+
+/**
+ * @brief                   Returns an iterator to the logical key after the last key
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::end () const
+{
+    return iterator {nullptr, this};
+}
+
+/**
+ * @brief                   Construct a new iterator object
+ *
+ * @param pPtr              Pointer to slot to be encapsulated
+ * @param pTablePtr         Pointer to the table which contains the slot
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator::iterator (slot_ptr_t pPtr, table_ptr_t pTablePtr) :
+    mPtr {pPtr}, mTablePtr {pTablePtr}
+{
+}
+
+/**
+ * @brief                   Prefix increment operator (increments the iterator if not end() and returns it)
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator::operator++ ()
+{
+    // if this is the end, return itself
+    if (mPtr == nullptr || mTablePtr == nullptr) {
+        return *this;
+    }
+
+    // move to the next full slot (or end() if there is none)
+    for (uint64_t pos = (uint64_t)(mPtr - mTablePtr->mSlots) + 1ULL; pos < mTablePtr->mBucketCount; ++pos) {
+        if (mTablePtr->mCtrl[pos] >= 0) {
+            mPtr    = mTablePtr->mSlots + pos;
+            return *this;
+        }
+    }
+
+    mPtr        = nullptr;
+    return *this;
+}
+
+/**
+ * @brief                   Suffix increment operator (increments the iterator if not end() and returns a copy of the old one)
+ *
+ * @return iterator
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator::operator++ (int)
+{
+    iterator    res {mPtr, mTablePtr};
+
+    ++(*this);
+
+    return res;
+}
+
+/**
+ * @brief                   Dereferences and returns the key held by the encapsulated slot
+ *
+ * @return ref_t
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+typename AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator::ref_t
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator::operator* () const
+{
+    return *mPtr;
+}
+
+/**
+ * @brief                   Checks if two iterators point to the same slot in the same table
+ *
+ * @param pOther            Iterator to compare to
+ *
+ * @return true             If both iterators point to the same slot in the same table
+ * @return false            If both iterators point to different slots or different tables
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator::operator== (const iterator &pOther) const
+{
+    return (mPtr == pOther.mPtr) && (mTablePtr == pOther.mTablePtr);
+}
+
+/**
+ * @brief                   Checks if two iterators point to different slots
+ *
+ * @param pOther            Iterator to compare to
+ *
+ * @return true             If both iterators point to different slots (or different tables)
+ * @return false            If both iterators point to the same slot in the same table
+ */
+template <typename key_t, auto tHashFunc, auto tEquals, typename tAlloc>
+bool
+AgHashTable<key_t, tHashFunc, tEquals, AgSwissLayout, tAlloc>::iterator::operator!= (const iterator &pOther) const
+{
+    return (mPtr != pOther.mPtr) || (mTablePtr != pOther.mTablePtr);
+}
@@ -0,0 +1,771 @@
+/**
+ * @file            AgStringTable.h
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           AgStringTable class, a hash table of strings which owns the characters of its keys
+ *
+ */
+
+#ifndef AG_STRING_TABLE_GUARD_H
+
+#define     AG_STRING_TABLE_GUARD_H
+
+#include <new>
+#include <mutex>
+#include <shared_mutex>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#include "AgHashTable.h"
+
+#ifdef AG_DBG_MODE
+#define     DBG_MODE(...)                           __VA_ARGS__
+#define     NO_DBG_MODE(...)
+
+#else
+
+#define     DBG_MODE(...)
+#define     NO_DBG_MODE(...)                        __VA_ARGS__
+
+#endif
+
+#ifdef AG_HASH_TABLE_MULTITHREADED_MODE
+#define     MULTITHREADED_MODE(...)                 __VA_ARGS__
+#define     NO_MULTITHREADED_MODE(...)
+#else
+#define     MULTITHREADED_MODE(...)
+#define     NO_MULTITHREADED_MODE(...)              __VA_ARGS__
+#endif
+
+/**
+ * @brief                   Key stored by AgStringTable, holding the length and hash of a string along with its characters
+ *
+ *                          Strings of upto sInlineCapacity characters are stored inside the key itself (and so inside the table's
+ *                          node), while the characters of longer strings are stored in the table's AgStringArena
+ *                          The key does not own the characters of a long string, it is the table which releases them
+ */
+struct AgStringKey {
+
+    static constexpr uint64_t   sInlineCapacity         = 20ULL;                        /** Maximum length of a string stored inside the key */
+
+    uint64_t            hash;                                       /** Hash of the characters of the string (see ag_string_key_hash_chars ()) */
+    uint32_t            length;                                     /** Number of characters in the string */
+
+    union {
+        char            inlineChars[sInlineCapacity];               /** Characters of the string, if it is short enough to be stored inline */
+        const char      *arenaChars;                                /** Pointer to the characters of the string in the arena, otherwise */
+    };
+
+    /**
+     * @brief               Returns if the characters of the string are stored inside the key
+     *
+     * @return true         If the characters are stored inside the key
+     * @return false        If the characters are stored in the arena
+     */
+    bool
+    is_inline () const
+    {
+        return length <= sInlineCapacity;
+    }
+
+    /**
+     * @brief               Returns a view over the characters of the string (which is not NUL-terminated)
+     *
+     * @return std::string_view View over the characters of the string
+     */
+    std::string_view
+    view () const
+    {
+        return std::string_view {is_inline () ? (inlineChars) : (arenaChars), length};
+    }
+};
+
+/**
+ * @brief                   Returns the hash of a string's characters, which is cached inside AgStringKey
+ *
+ * @param pChars            View over the characters of the string
+ *
+ * @return uint64_t         Hash of the characters
+ */
+static inline uint64_t
+ag_string_key_hash_chars (const std::string_view &pChars)
+{
+    return ag_wyhash_n<char, uint64_t> (pChars.data (), pChars.size ());
+}
+
+/**
+ * @brief                   Hash function of AgStringKey, which returns the cached hash instead of hashing the characters again
+ *
+ * @param pKey              Pointer to the key
+ *
+ * @return uint64_t         Hash of the key's characters
+ */
+static inline uint64_t
+ag_string_key_hash (const AgStringKey *pKey)
+{
+    return pKey->hash;
+}
+
+/**
+ * @brief                   Equals comparator of AgStringKey, which only compares the characters of keys with the same length and hash
+ *
+ * @param pA                First operand
+ * @param pB                Second operand
+ *
+ * @return true             If both keys hold the same string
+ * @return false            If the keys hold different strings
+ */
+static inline bool
+ag_string_key_equals (const AgStringKey &pA, const AgStringKey &pB)
+{
+    if ((pA.length != pB.length) || (pA.hash != pB.hash)) {
+        return false;
+    }
+
+    return memcmp (pA.view ().data (), pB.view ().data (), pA.length) == 0;
+}
+
+/**
+ * @brief                   Arena which holds the characters of the long strings of an AgStringTable
+ *
+ *                          Characters are carved out of large chunks in granules of sGranuleSize bytes, and freed blocks are kept
+ *                          in a free list for their number of granules, to be reused by strings which need as many granules
+ *                          Strings longer than sMaxPooledLength are allocated separately from the heap, and linked together so that
+ *                          the arena can free them when it is destroyed
+ *                          Every chunk is released at once when the arena is destroyed
+ *                          In multithreaded mode, the arena is guarded by a single lock
+ */
+class AgStringArena {
+
+    static constexpr uint64_t   sGranuleSize            = 16ULL;                        /** Blocks are allocated in multiples of this many bytes */
+    static constexpr uint64_t   sMaxPooledLength        = 1024ULL;                      /** Strings longer than this are allocated separately from the heap */
+    static constexpr uint64_t   sClassCount             = sMaxPooledLength / sGranuleSize + 1ULL;  /** Number of free lists (one per number of granules) */
+    static constexpr uint64_t   sChunkSize              = 64ULL * 1024ULL;              /** Number of bytes carved out of each chunk */
+
+    /**
+     * @brief               Block in a free list (stored in the freed block itself)
+     *
+     */
+    struct free_block_t {
+
+        free_block_t        *nextPtr;                               /** Pointer to the next free block with the same number of granules */
+    };
+
+    /**
+     * @brief               Header of a block allocated separately from the heap, which is placed right before its characters
+     *
+     */
+    struct large_block_t {
+
+        large_block_t       *prevPtr;                               /** Pointer to the previous separately allocated block */
+        large_block_t       *nextPtr;                               /** Pointer to the next separately allocated block */
+    };
+
+    /**
+     * @brief               Chunk of bytes allocated from the system at once
+     *
+     */
+    struct chunk_t {
+
+        chunk_t             *nextPtr;                               /** Pointer to the chunk allocated before this one */
+        alignas (sGranuleSize) char bytes[sChunkSize];              /** Bytes carved out of the chunk */
+    };
+
+    public:
+
+    AgStringArena                               () = default;
+    ~AgStringArena                              ();
+
+    AgStringArena                               (const AgStringArena &pOther) = delete;
+    AgStringArena   &operator=                  (const AgStringArena &pOther) = delete;
+
+    char            *allocate                   (const uint64_t &pLength);
+    void            deallocate                  (char *pPtr, const uint64_t &pLength);
+
+    void            release_all                 ();
+
+    DBG_MODE (
+    uint64_t        get_chunk_count             () const    { return mChunkCnt; }
+    uint64_t        get_reserved_amount         () const    { return mChunkCnt * sizeof (chunk_t); }
+    uint64_t        get_free_amount             () const    { return mFreeAmt; }
+    )
+
+    private:
+
+    chunk_t         *mChunks            {nullptr};                  /** Pointer to the most recently allocated chunk */
+    uint64_t        mUsedInChunk        {sChunkSize};               /** Number of bytes of the most recent chunk which have been carved out */
+    free_block_t    *mFreeLists[sClassCount]    {};                 /** Free list of blocks of every number of granules */
+    large_block_t   *mLargeBlocks       {nullptr};                  /** Pointer to the most recently allocated separate block */
+
+    MULTITHREADED_MODE (
+    std::mutex      mLock;                                          /** Guards the arena */
+    )
+    DBG_MODE (
+    uint64_t        mChunkCnt           {0ULL};                     /** Number of chunks allocated */
+    uint64_t        mFreeAmt            {0ULL};                     /** Number of bytes in the free lists */
+    )
+};
+
+/**
+ * @brief                   Destroy the arena, returning every chunk to the system
+ *
+ */
+inline
+AgStringArena::~AgStringArena ()
+{
+    release_all ();
+}
+
+/**
+ * @brief                   Returns every chunk and separately allocated block to the system at once, taking back all storage handed
+ *                          out by the arena (which may be used again afterwards)
+ *
+ */
+inline void
+AgStringArena::release_all ()
+{
+    chunk_t             *chunk;                                     /** Chunk being freed */
+    large_block_t       *largeBlock;                                /** Separately allocated block being freed */
+
+    MULTITHREADED_MODE (
+    std::lock_guard<std::mutex>     arenaLock   {mLock};
+    )
+
+    while (mChunks != nullptr) {
+        chunk       = mChunks;
+        mChunks     = chunk->nextPtr;
+
+        delete chunk;
+    }
+
+    while (mLargeBlocks != nullptr) {
+        largeBlock      = mLargeBlocks;
+        mLargeBlocks    = largeBlock->nextPtr;
+
+        delete[] reinterpret_cast<char *> (largeBlock);
+    }
+
+    mUsedInChunk    = sChunkSize;
+    for (uint64_t classId = 0; classId < sClassCount; ++classId) {
+        mFreeLists[classId] = nullptr;
+    }
+
+    DBG_MODE (
+    mChunkCnt       = 0ULL;
+    mFreeAmt        = 0ULL;
+    )
+}
+
+/**
+ * @brief                   Returns storage for the given number of characters, reusing a freed block of the same size if possible
+ *
+ * @param pLength           Number of characters
+ *
+ * @return char*            Pointer to the storage (nullptr on allocation failure)
+ */
+inline char *
+AgStringArena::allocate (const uint64_t &pLength)
+{
+    uint64_t            granules;                                   /** Number of granules needed */
+    free_block_t        *block;                                     /** Block taken from a free list */
+    large_block_t       *largeBlock;                                /** Block allocated separately for a long string */
+    chunk_t             *newChunk;                                  /** Newly allocated chunk */
+    char                *res;                                       /** Storage handed out */
+
+    // long strings are rare enough to be allocated separately
+    if (pLength > sMaxPooledLength) {
+
+        largeBlock  = reinterpret_cast<large_block_t *> (new (std::nothrow) char[sizeof (large_block_t) + pLength]);
+        if (largeBlock == nullptr) {
+            return nullptr;
+        }
+
+        MULTITHREADED_MODE (
+        std::lock_guard<std::mutex>     arenaLock   {mLock};
+        )
+
+        largeBlock->prevPtr     = nullptr;
+        largeBlock->nextPtr     = mLargeBlocks;
+        if (mLargeBlocks != nullptr) {
+            mLargeBlocks->prevPtr   = largeBlock;
+        }
+        mLargeBlocks    = largeBlock;
+
+        return reinterpret_cast<char *> (largeBlock + 1);
+    }
+
+    granules        = (pLength + sGranuleSize - 1) / sGranuleSize;
+
+    MULTITHREADED_MODE (
+    std::lock_guard<std::mutex>     arenaLock   {mLock};
+    )
+
+    // reuse a freed block with the same number of granules
+    if (mFreeLists[granules] != nullptr) {
+        block                   = mFreeLists[granules];
+        mFreeLists[granules]    = block->nextPtr;
+
+        DBG_MODE (
+        mFreeAmt    -= granules * sGranuleSize;
+        )
+
+        return reinterpret_cast<char *> (block);
+    }
+
+    // otherwise carve the block out of the current chunk, allocating a new chunk if there is not enough space left
+    if (mUsedInChunk + granules * sGranuleSize > sChunkSize) {
+
+        newChunk    = new (std::nothrow) chunk_t;
+        if (newChunk == nullptr) {
+            return nullptr;
+        }
+
+        newChunk->nextPtr   = mChunks;
+        mChunks             = newChunk;
+        mUsedInChunk        = 0ULL;
+
+        DBG_MODE (
+        ++mChunkCnt;
+        )
+
+    }
+
+    res             = mChunks->bytes + mUsedInChunk;
+    mUsedInChunk    += granules * sGranuleSize;
+
+    return res;
+}
+
+/**
+ * @brief                   Takes back storage returned by allocate (), to be handed out again for a string needing as many granules
+ *
+ * @param pPtr              Pointer to the storage
+ * @param pLength           Number of characters the storage was allocated for
+ */
+inline void
+AgStringArena::deallocate (char *pPtr, const uint64_t &pLength)
+{
+    uint64_t            granules;                                   /** Number of granules in the block */
+    free_block_t        *block;                                     /** Block being freed */
+    large_block_t       *largeBlock;                                /** Block allocated separately for a long string */
+
+    if (pLength > sMaxPooledLength) {
+
+        largeBlock  = reinterpret_cast<large_block_t *> (pPtr) - 1;
+
+        {
+            MULTITHREADED_MODE (
+            std::lock_guard<std::mutex>     arenaLock   {mLock};
+            )
+
+            if (largeBlock->prevPtr != nullptr) {
+                largeBlock->prevPtr->nextPtr    = largeBlock->nextPtr;
+            }
+            else {
+                mLargeBlocks    = largeBlock->nextPtr;
+            }
+            if (largeBlock->nextPtr != nullptr) {
+                largeBlock->nextPtr->prevPtr    = largeBlock->prevPtr;
+            }
+        }
+
+        delete[] reinterpret_cast<char *> (largeBlock);
+        return;
+    }
+
+    granules        = (pLength + sGranuleSize - 1) / sGranuleSize;
+
+    MULTITHREADED_MODE (
+    std::lock_guard<std::mutex>     arenaLock   {mLock};
+    )
+
+    block                   = reinterpret_cast<free_block_t *> (pPtr);
+    block->nextPtr          = mFreeLists[granules];
+    mFreeLists[granules]    = block;
+
+    DBG_MODE (
+    mFreeAmt        += granules * sGranuleSize;
+    )
+}
+
+/**
+ * @brief                   AgStringTable is a hash table of strings built on the chained layout of AgHashTable, which owns the
+ *                          characters of its keys (so the caller does not have to keep them alive)
+ *
+ *                          Short strings are stored inline in the table's nodes and long strings in an arena owned by the table,
+ *                          while the length and hash of every string are cached next to it, so that comparisons can reject keys of a
+ *                          different length or hash without touching their characters
+ *                          Keys are given and searched for as std::string_view, so C-style strings, std::string and slices of a
+ *                          larger buffer can all be used without being copied into a temporary
+ *
+ * @tparam tAlloc           Allocator policy used for nodes and aggregate nodes (defaults to AgHeapAllocator, see AgHashTableAllocators.h)
+ *
+ * @note                    The table is inherited privately, since the keys point into the arena, which is not exchanged or copied
+ *                          along with the table (so swap, copy_from, clone and insertion of raw keys are not available)
+ *
+ * @note                    If AG_HASH_TABLE_MULTITHREADED_MODE is defined, insert, erase, exists and find may be called concurrently,
+ *                          while clear waits for every insertion and erasure in progress (and blocks new ones) until the arena has
+ *                          been released
+ */
+template <typename tAlloc = AgHeapAllocator>
+class AgStringTable : private AgHashTable<AgStringKey, ag_string_key_hash, ag_string_key_equals, AgChainedLayout, tAlloc> {
+
+
+
+    protected:
+
+
+
+    using       base_t          = AgHashTable<AgStringKey, ag_string_key_hash, ag_string_key_equals, AgChainedLayout, tAlloc>;    /** Table which stores the keys */
+
+
+
+    public:
+
+
+
+    using       iterator        = typename base_t::iterator;                            /** Iterator over the keys of the table (dereferences to a const AgStringKey) */
+
+    //  Constructors
+
+    AgStringTable   ();
+    AgStringTable   (const uint64_t &pBucketCount);
+    AgStringTable   (const AgStringTable &pOther) = delete;
+
+    //  Destructors
+
+    ~AgStringTable  ();
+
+    //  Getters
+
+    using base_t::initialized;
+
+    using base_t::size;
+    using base_t::get_key_count;
+
+    using base_t::get_bucket_count;
+    using base_t::get_max_bucket_count;
+
+    using base_t::get_bucket_key_count;
+    using base_t::get_bucket_hash_count;
+
+    using base_t::get_incremental_resize;
+    using base_t::get_pending_bucket_count;
+
+    using base_t::get_growth_policy;
+
+    using base_t::get_rehash_threads;
+    using base_t::get_parallel_growth;
+
+    // Setters
+
+    using base_t::set_incremental_resize;
+    using base_t::set_growth_policy;
+    using base_t::set_rehash_threads;
+
+    // Testing and debugging
+
+    DBG_MODE (
+    using base_t::get_alloc_amount;
+    using base_t::get_alloc_count;
+    using base_t::get_delete_count;
+
+    using base_t::get_resize_count;
+
+    using base_t::get_aggregate_count;
+
+    using base_t::get_pool_alloc_count;
+    using base_t::get_pool_reserved_amount;
+    using base_t::get_pool_free_count;
+
+    uint64_t            get_arena_chunk_count   () const;
+    uint64_t            get_arena_reserved_amount   () const;
+    uint64_t            get_arena_free_amount   () const;
+    )
+
+    //  Lookup
+
+    iterator            find                    (const std::string_view &pKey) const;
+    bool                exists                  (const std::string_view &pKey) const;
+
+    //  Modifiers
+
+    bool                insert                  (const std::string_view &pKey);
+    bool                erase                   (const std::string_view &pKey);
+
+    using base_t::reserve;
+    using base_t::rehash;
+    using base_t::shrink_to_fit;
+
+    void                clear                   ();
+
+    // Iterators and Iteration
+
+    using base_t::begin;
+    using base_t::end;
+
+
+
+    protected:
+
+
+
+    static bool         matches                 (const std::string_view &pKey, const AgStringKey &pStored);
+
+    AgStringArena       mArena;                                     /** Arena holding the characters of long keys */
+
+    MULTITHREADED_MODE (
+    std::shared_mutex   mClearLock;                                 /** Shared by insertions and erasures, taken exclusively by clear () */
+    )
+};
+
+/**
+ * @brief                   Construct a new AgStringTable<tAlloc>::AgStringTable object
+ *
+ */
+template <typename tAlloc>
+AgStringTable<tAlloc>::AgStringTable () :
+    base_t {}
+{
+}
+
+/**
+ * @brief                   Construct a new AgStringTable<tAlloc>::AgStringTable object
+ *
+ * @param pBucketCount      Number of buckets to initialize the table with
+ */
+template <typename tAlloc>
+AgStringTable<tAlloc>::AgStringTable (const uint64_t &pBucketCount) :
+    base_t {pBucketCount}
+{
+}
+
+/**
+ * @brief                   Destroy the AgStringTable<tAlloc>::AgStringTable object
+ *
+ *                          The characters of long keys are released along with the arena, while the keys themselves (which do not
+ *                          need to be destroyed) are released by the base table
+ */
+template <typename tAlloc>
+AgStringTable<tAlloc>::~AgStringTable ()
+{
+}
+
+/**
+ * @brief                   Returns if a stored key holds the given string (comparing the characters only if the lengths and hashes match)
+ *
+ * @param pKey              String being searched for
+ * @param pStored           Key stored in the table (with the same hash as pKey)
+ *
+ * @return true             If the stored key holds the string
+ * @return false            If the stored key holds a different string
+ */
+template <typename tAlloc>
+bool
+AgStringTable<tAlloc>::matches (const std::string_view &pKey, const AgStringKey &pStored)
+{
+    return (pStored.length == pKey.size ()) && (memcmp (pStored.view ().data (), pKey.data (), pKey.size ()) == 0);
+}
+
+/**
+ * @brief                   Searches for a given string in the table and returns an iterator to it (returns end() if it is not found)
+ *
+ * @param pKey              String to search for
+ *
+ * @return iterator         Iterator to the matching key (end() if no matching key is found)
+ */
+template <typename tAlloc>
+typename AgStringTable<tAlloc>::iterator
+AgStringTable<tAlloc>::find (const std::string_view &pKey) const
+{
+    return this->find_matching (ag_string_key_hash_chars (pKey), [&pKey] (const AgStringKey &pStored) { return matches (pKey, pStored); });
+}
+
+/**
+ * @brief                   Returns if a given string exists in the table
+ *
+ * @param pKey              String to search for
+ *
+ * @return true             If the string exists in the table
+ * @return false            If the string does not exist in the table
+ */
+template <typename tAlloc>
+bool
+AgStringTable<tAlloc>::exists (const std::string_view &pKey) const
+{
+    return find (pKey) != this->end ();
+}
+
+/**
+ * @brief                   Attempts to insert a copy of a given string into the table
+ *
+ * @param pKey              String to insert
+ *
+ * @return true             If the string could successfully be inserted
+ * @return false            If the string could not be inserted (duplicate string found or allocation failure)
+ */
+template <typename tAlloc>
+bool
+AgStringTable<tAlloc>::insert (const std::string_view &pKey)
+{
+    uint64_t            keyHash;                                    /** Hash of the string */
+    char                *chars      {nullptr};                      /** Copy of the characters of a long string in the arena */
+    bool                inserted;                                   /** Stores if the string was inserted */
+
+    // the length is cached as a 32 bit integer
+    if (pKey.size () > std::numeric_limits<uint32_t>::max ()) {
+        return false;
+    }
+
+    keyHash         = ag_string_key_hash_chars (pKey);
+
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex> clearLock   {mClearLock};
+    )
+
+    // the characters of a long string are copied into the arena before the key is linked, since a node must never hold a key
+    // without its characters, so duplicates are rejected first to avoid copying them (the copy is still given back if another
+    // thread inserts the same string in the meantime)
+    if (pKey.size () > AgStringKey::sInlineCapacity) {
+
+        if (this->find_matching (keyHash, [&pKey] (const AgStringKey &pStored) { return matches (pKey, pStored); }) != this->end ()) {
+            return false;
+        }
+
+        chars       = mArena.allocate (pKey.size ());
+        if (chars == nullptr) {
+            return false;
+        }
+
+        memcpy (chars, pKey.data (), pKey.size ());
+    }
+
+    inserted        = this->emplace_matching (keyHash,
+                                              [&pKey] (const AgStringKey &pStored) { return matches (pKey, pStored); },
+                                              [&pKey, keyHash, chars] () {
+                                                  AgStringKey     key;
+
+                                                  key.hash    = keyHash;
+                                                  key.length  = (uint32_t)pKey.size ();
+
+                                                  if (chars != nullptr) {
+                                                      key.arenaChars  = chars;
+                                                  }
+                                                  else {
+                                                      memcpy (key.inlineChars, pKey.data (), pKey.size ());
+                                                  }
+
+                                                  return key;
+                                              },
+                                              [] (AgStringKey &pStored, const bool &pInserted) { (void)pStored; (void)pInserted; });
+
+    if (!inserted && (chars != nullptr)) {
+        mArena.deallocate (chars, pKey.size ());
+    }
+
+    return inserted;
+}
+
+/**
+ * @brief                   Attempts to erase a given string from the table, releasing its characters
+ *
+ * @param pKey              String to erase
+ *
+ * @return true             If the string was successfully found and removed
+ * @return false            If the string could not be removed (no matching key was found)
+ */
+template <typename tAlloc>
+bool
+AgStringTable<tAlloc>::erase (const std::string_view &pKey)
+{
+    const char          *chars      {nullptr};                      /** Characters of the erased key in the arena (nullptr if they were inline) */
+    bool                erased;                                     /** Stores if the string was erased */
+
+    MULTITHREADED_MODE (
+    std::shared_lock<std::shared_mutex> clearLock   {mClearLock};
+    )
+
+    // the erased key's characters are remembered when it is matched, since the key is destroyed by the time erase_matching returns
+    erased          = this->erase_matching (ag_string_key_hash_chars (pKey), [&pKey, &chars] (const AgStringKey &pStored) {
+        if (!matches (pKey, pStored)) {
+            return false;
+        }
+
+        chars       = (pStored.is_inline ()) ? (nullptr) : (pStored.arenaChars);
+        return true;
+    });
+
+    if (erased && (chars != nullptr)) {
+        mArena.deallocate (const_cast<char *> (chars), pKey.size ());
+    }
+
+    return erased;
+}
+
+/**
+ * @brief                   Erases every string from the table (keeping its buckets), releasing the characters of every long key at once
+ *                          along with the arena
+ *
+ *                          In multithreaded mode, insertions and erasures are excluded until the arena has been released, so that no
+ *                          key can be linked to characters which are about to be released
+ */
+template <typename tAlloc>
+void
+AgStringTable<tAlloc>::clear ()
+{
+    MULTITHREADED_MODE (
+    std::unique_lock<std::shared_mutex> clearLock   {mClearLock};
+    )
+
+    base_t::clear ();
+    mArena.release_all ();
+}
+
+DBG_MODE (
+
+/**
+ * @brief                   Returns the number of chunks allocated by the arena
+ *
+ * @return uint64_t         Number of chunks allocated by the arena
+ */
+template <typename tAlloc>
+uint64_t
+AgStringTable<tAlloc>::get_arena_chunk_count () const
+{
+    return mArena.get_chunk_count ();
+}
+
+/**
+ * @brief                   Returns the number of bytes held by the arena (not counting long strings allocated separately)
+ *
+ * @return uint64_t         Number of bytes held by the arena
+ */
+template <typename tAlloc>
+uint64_t
+AgStringTable<tAlloc>::get_arena_reserved_amount () const
+{
+    return mArena.get_reserved_amount ();
+}
+
+/**
+ * @brief                   Returns the number of bytes of the arena which have been freed and are waiting to be reused
+ *
+ * @return uint64_t         Number of bytes waiting to be reused
+ */
+template <typename tAlloc>
+uint64_t
+AgStringTable<tAlloc>::get_arena_free_amount () const
+{
+    return mArena.get_free_amount ();
+}
+)
+
+#undef  DBG_MODE
+#undef  NO_DBG_MODE
+#undef  MULTITHREADED_MODE
+#undef  NO_MULTITHREADED_MODE
+
+#endif          // Header Guard
@@ -13,11 +13,69 @@
 
 #include <gtest/gtest.h>
 #include <type_traits>
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <vector>
+#include <list>
+#include <string>
+#include <set>
+#include <string_view>
 
 #define AG_DBG_MODE
 // #define AG_PRINT_INIT_INFO
 #include "AgHashTable.h"
+#include "AgHashMap.h"
+#include "AgStringTable.h"
+#include "AgFrozenHashTable.h"
+
+static size_t           gFailAllocationsFrom    = std::numeric_limits<size_t>::max ();  /** Allocations of atleast this many bytes fail (used to stop tables from growing) */
+
+/**
+ * @brief                   Replacement of the global nothrow allocation function (used by the tables), which fails allocations of
+ *                          atleast gFailAllocationsFrom bytes
+ *
+ * @param pSize             Number of bytes to allocate
+ *
+ * @return void*            Pointer to the allocated storage (nullptr on failure)
+ */
+void *
+operator new (size_t pSize, const std::nothrow_t &) noexcept
+{
+    if (pSize >= gFailAllocationsFrom) {
+        return nullptr;
+    }
+
+    try {
+        return ::operator new (pSize);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief                   Replacement of the global nothrow array allocation function (used by the tables), which fails allocations of
+ *                          atleast gFailAllocationsFrom bytes
+ *
+ * @param pSize             Number of bytes to allocate
+ *
+ * @return void*            Pointer to the allocated storage (nullptr on failure)
+ */
+void *
+operator new[] (size_t pSize, const std::nothrow_t &) noexcept
+{
+    if (pSize >= gFailAllocationsFrom) {
+        return nullptr;
+    }
+
+    try {
+        return ::operator new[] (pSize);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
 
 /**
  * @brief                   Returns the absoulute value of an integer
@@ -51,6 +109,22 @@ mod2 (const int_t *pKey)
     return abs (pKey) & 1;
 }
 
+/**
+ * @brief                   Returns the lowest byte of an integer (a hash narrower than the tag bits of the flat layouts)
+ *
+ * @tparam int_t            Type of integer being supplied
+ *
+ * @param pKey              Pointer to the integer whose lowest byte is to be found
+ *
+ * @return uint8_t          Lowest byte of the supplied integer
+ */
+template <typename int_t>
+inline uint8_t
+low_byte (const int_t *pKey)
+{
+    return (uint8_t)(*pKey & 0xFF);
+}
+
 /**
  * @brief                   Returns an unsigned integer of any bitness as a an unsigned 64 bit integer
  *
@@ -860,3 +934,2002 @@ TEST (Find, multiAggregateMultiNode)
         }
     }
 }
+
+/**
+ * @brief                   Fixture for tests which are run on every flat layout (open addressing with every probe strategy and group probing)
+ *
+ * @tparam layout_t         Storage layout to use
+ */
+template <typename layout_t>
+class FlatLayout : public ::testing::Test {};
+
+using FlatLayouts = ::testing::Types<AgOpenAddressingLayout<AgProbeLinear>, AgOpenAddressingLayout<AgProbeQuadratic>,
+                                     AgOpenAddressingLayout<AgProbeRobinHood>, AgSwissLayout>;
+TYPED_TEST_SUITE (FlatLayout, FlatLayouts);
+
+/**
+ * @brief                   Smoke test with the flat layouts (includes growing the table)
+ *
+ */
+TYPED_TEST (FlatLayout, SmokeTest)
+{
+    constexpr int64_t                                                                               lo  = -100'000;
+    constexpr int64_t                                                                               hi  = 100'000;
+
+    AgHashTable<int64_t, ag_fnv1a<int64_t, size_t>, ag_hashtable_default_equals<int64_t>, TypeParam>      table;
+
+    ASSERT_TRUE (table.initialized ());
+
+    for (auto i = lo; i <= hi; ++i) {
+        ASSERT_TRUE (table.insert (i)) << "i: " << i << '\n';
+        ASSERT_EQ (table.size (), i - lo + 1);
+    }
+
+    // the table should have grown to accomodate all the keys
+    ASSERT_GT (table.get_resize_count (), 0);
+    ASSERT_GT (table.get_bucket_count (), table.size ());
+
+    for (auto i = lo; i <= hi; ++i) {
+        ASSERT_TRUE (table.exists (i)) << "i: " << i << '\n';
+        ASSERT_FALSE (table.insert (i)) << "i: " << i << '\n';
+        ASSERT_NE (table.find (i), table.end ());
+        ASSERT_EQ (*(table.find (i)), i);
+    }
+
+    for (auto i = lo; i <= hi; ++i) {
+        ASSERT_TRUE (table.erase (i)) << "i: " << i << '\n';
+        ASSERT_FALSE (table.exists (i)) << "i: " << i << '\n';
+        ASSERT_EQ (table.size (), hi - i) << i << '\n';
+    }
+
+    for (auto i = lo; i <= hi; ++i) {
+        ASSERT_FALSE (table.erase (i)) << "i: " << i << '\n';
+        ASSERT_EQ (table.find (i), table.end ());
+    }
+}
+
+/**
+ * @brief                   Test the flat layouts with many keys sharing the same home slot and hash (long probe sequences)
+ *
+ */
+TYPED_TEST (FlatLayout, collisions)
+{
+    AgHashTable<int64_t, mod2<int64_t>, ag_hashtable_default_equals<int64_t>, TypeParam>            table;
+
+    // insert keys which all hash to either 0 or 1
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+    ASSERT_EQ (table.size (), 1'000);
+
+    // erase the even keys, which leaves gaps (or tombstones) in the middle of the probe sequences of the odd keys
+    for (int64_t i = 0; i < 1'000; i += 2) {
+        ASSERT_TRUE (table.erase (i));
+    }
+    ASSERT_EQ (table.size (), 500);
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_EQ (table.exists (i), (i & 1) == 1) << "i: " << i << '\n';
+    }
+
+    // re-insert the even keys and make sure that no key is duplicated
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_EQ (table.insert (i), (i & 1) == 0) << "i: " << i << '\n';
+    }
+    ASSERT_EQ (table.size (), 1'000);
+}
+
+/**
+ * @brief                   Test that the flat layouts spread keys with a hash narrower than 32 bits over all of its values, and round
+ *                          the number of slots up to a power of 2
+ *
+ */
+TYPED_TEST (FlatLayout, narrowHashes)
+{
+    AgHashTable<int64_t, low_byte<int64_t>, ag_hashtable_default_equals<int64_t>, TypeParam>        table   {1'000};
+    std::set<uint64_t>                                                                              homes;
+
+    ASSERT_EQ (table.get_bucket_count (), 1'024ULL);
+
+    for (int64_t i = 0; i < 256; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        homes.insert (table.get_bucket_of_key (i));
+    }
+
+    // every hash has its own home slot (instead of the 2 left after skipping the low 7 bits of an 8 bit hash)
+    ASSERT_EQ (homes.size (), 256ULL);
+
+    for (int64_t i = 0; i < 2'048; ++i) {
+        ASSERT_EQ (table.insert (i), i >= 256) << "i: " << i << '\n';
+    }
+    for (int64_t i = 0; i < 2'048; ++i) {
+        ASSERT_TRUE (table.exists (i)) << "i: " << i << '\n';
+    }
+}
+
+/**
+ * @brief                   Test that the group probing layout uses every slot once it can not grow any further, including the last one
+ *
+ */
+TEST (SwissLayout, fillsEveryFreeSlot)
+{
+    AgHashTable<int64_t, ag_fnv1a<int64_t, size_t>, ag_hashtable_default_equals<int64_t>, AgSwissLayout>     table   {16};
+    uint64_t                                                                                                capacity;
+
+    capacity    = table.get_bucket_count ();
+
+    // inserts a key while the allocation of any larger slot array fails, so that the table stays at its current size
+    auto    insert_without_growing  = [&table, capacity] (const int64_t &pKey) {
+        bool    inserted;
+
+        gFailAllocationsFrom    = sizeof (int64_t) * capacity * 2;
+        inserted                = table.insert (pKey);
+        gFailAllocationsFrom    = std::numeric_limits<size_t>::max ();
+
+        return inserted;
+    };
+
+    for (int64_t i = 0; i < (int64_t)capacity - 1; ++i) {
+        ASSERT_TRUE (insert_without_growing (i)) << "i: " << i << '\n';
+    }
+    ASSERT_EQ (table.get_bucket_count (), capacity);
+    ASSERT_EQ (table.size (), capacity - 1);
+
+    // the single free slot left can still be used, after which the table is full
+    ASSERT_TRUE (insert_without_growing ((int64_t)capacity - 1));
+    ASSERT_FALSE (insert_without_growing ((int64_t)capacity));
+    ASSERT_FALSE (insert_without_growing (0));
+
+    // and a slot freed by an erasure can be used again
+    ASSERT_TRUE (table.erase (0));
+    ASSERT_TRUE (insert_without_growing ((int64_t)capacity));
+
+    ASSERT_EQ (table.get_bucket_count (), capacity);
+    ASSERT_EQ (table.size (), capacity);
+    for (int64_t i = 1; i <= (int64_t)capacity; ++i) {
+        ASSERT_TRUE (table.exists (i)) << "i: " << i << '\n';
+    }
+
+    // the table grows again once allocations succeed
+    ASSERT_TRUE (table.insert (0));
+    ASSERT_GT (table.get_bucket_count (), capacity);
+}
+
+/**
+ * @brief                   Test iterating over all keys in the flat layouts
+ *
+ */
+TYPED_TEST (FlatLayout, iteration)
+{
+    AgHashTable<int64_t, ag_fnv1a<int64_t, size_t>, ag_hashtable_default_equals<int64_t>, TypeParam>      table;
+    int64_t                                                                                                 sum     {0};
+    uint64_t                                                                                                count   {0};
+
+    ASSERT_EQ (table.begin (), table.end ());
+
+    for (int64_t i = 1; i <= 1'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+
+    for (auto it = table.begin (); it != table.end (); ++it) {
+        sum     += *it;
+        ++count;
+    }
+
+    ASSERT_EQ (count, 1'000);
+    ASSERT_EQ (sum, 500'500);
+}
+
+/**
+ * @brief                   Fixture for tests which are run on the bucketized cuckoo layout with the smallest and largest buckets
+ *
+ * @tparam layout_t         Storage layout to use
+ */
+template <typename layout_t>
+class CuckooLayout : public ::testing::Test {};
+
+using CuckooLayouts = ::testing::Types<AgCuckooLayout<4>, AgCuckooLayout<8>>;
+TYPED_TEST_SUITE (CuckooLayout, CuckooLayouts);
+
+/**
+ * @brief                   Smoke test with the cuckoo layout (includes growing the table), which also checks that every key is in
+ *                          one of its two buckets when the hash function is good
+ *
+ */
+TYPED_TEST (CuckooLayout, SmokeTest)
+{
+    constexpr int64_t                                                                               lo  = -100'000;
+    constexpr int64_t                                                                               hi  = 100'000;
+
+    AgHashTable<int64_t, ag_fnv1a<int64_t, size_t>, ag_hashtable_default_equals<int64_t>, TypeParam>      table;
+    uint64_t                                                                                        keyCount    {0};
+
+    ASSERT_TRUE (table.initialized ());
+
+    for (auto i = lo; i <= hi; ++i) {
+        ASSERT_TRUE (table.insert (i)) << "i: " << i << '\n';
+        ASSERT_EQ (table.size (), i - lo + 1);
+    }
+
+    // the table should have grown to accomodate all the keys, without needing the stash
+    ASSERT_GT (table.get_resize_count (), 0);
+    ASSERT_GT (table.get_slot_count (), table.size ());
+    ASSERT_EQ (table.get_stash_count (), 0);
+
+    for (uint64_t bucketId = 0; bucketId < table.get_bucket_count (); ++bucketId) {
+        keyCount    += table.get_bucket_key_count (bucketId);
+    }
+    ASSERT_EQ (keyCount, table.size ());
+
+    for (auto i = lo; i <= hi; ++i) {
+        ASSERT_TRUE (table.exists (i)) << "i: " << i << '\n';
+        ASSERT_FALSE (table.insert (i)) << "i: " << i << '\n';
+        ASSERT_NE (table.find (i), table.end ());
+        ASSERT_EQ (*(table.find (i)), i);
+    }
+
+    for (auto i = lo; i <= hi; ++i) {
+        ASSERT_TRUE (table.erase (i)) << "i: " << i << '\n';
+        ASSERT_FALSE (table.exists (i)) << "i: " << i << '\n';
+        ASSERT_EQ (table.size (), hi - i) << i << '\n';
+    }
+
+    for (auto i = lo; i <= hi; ++i) {
+        ASSERT_FALSE (table.erase (i)) << "i: " << i << '\n';
+        ASSERT_EQ (table.find (i), table.end ());
+    }
+}
+
+/**
+ * @brief                   Test the cuckoo layout with many keys sharing the same hash (only a few of which fit in their two buckets
+ *                          and the stash, since they all share the same two buckets, so inserting the rest fails)
+ *
+ */
+TYPED_TEST (CuckooLayout, collisions)
+{
+    AgHashTable<int64_t, mod2<int64_t>, ag_hashtable_default_equals<int64_t>, TypeParam>            table;
+    std::vector<bool>                                                                               inserted    (1'000);
+    uint64_t                                                                                        count       {0};
+    uint64_t                                                                                        iterated    {0};
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        inserted[i]     = table.insert (i);
+        count           += inserted[i];
+    }
+    ASSERT_EQ (table.size (), count);
+    ASSERT_LT (count, 1'000ULL);
+    ASSERT_GT (table.get_stash_count (), 0ULL);
+
+    // the stash does not grow beyond its capacity, so lookups stay bounded however many keys share their buckets
+    ASSERT_EQ (table.get_stash_count (), table.get_stash_capacity ());
+
+    // growing the table does not help keys which share their buckets, so it should not have grown much
+    ASSERT_LT (table.get_bucket_count (), 1'000ULL);
+
+    for (auto it = table.begin (); it != table.end (); ++it) {
+        ASSERT_TRUE (inserted[*it]);
+        ++iterated;
+    }
+    ASSERT_EQ (iterated, count);
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_EQ (table.exists (i), inserted[i]) << "i: " << i << '\n';
+    }
+
+    // keys which were erased make room for others with the same hash
+    for (int64_t i = 0; i < 1'000; ++i) {
+        if (inserted[i]) {
+            ASSERT_TRUE (table.erase (i));
+            ASSERT_TRUE (table.insert (i + 1'000'000));
+            ASSERT_FALSE (table.exists (i));
+            ASSERT_TRUE (table.exists (i + 1'000'000));
+        }
+    }
+    ASSERT_EQ (table.size (), count);
+}
+
+/**
+ * @brief                   Test that growing a small cuckoo table whose stash is full never loses a key, by checking every key which
+ *                          could be inserted after each insertion
+ *
+ */
+TYPED_TEST (CuckooLayout, resizeKeepsKeys)
+{
+    AgHashTable<int64_t, mod2<int64_t>, ag_hashtable_default_equals<int64_t>, TypeParam>            table   {2};
+    std::vector<int64_t>                                                                            keys;
+
+    for (int64_t i = 0; i < 2'000; ++i) {
+        if (table.insert (i)) {
+            keys.push_back (i);
+        }
+
+        ASSERT_EQ (table.size (), keys.size ());
+        ASSERT_LE (table.get_stash_count (), table.get_stash_capacity ());
+        for (auto &key : keys) {
+            ASSERT_TRUE (table.exists (key)) << "i: " << i << ", key: " << key << '\n';
+        }
+    }
+    ASSERT_GT (table.get_resize_count (), 0ULL);
+}
+
+/**
+ * @brief                   Test that the cuckoo layout fills most of its slots before growing, by moving keys between their buckets
+ *
+ */
+TYPED_TEST (CuckooLayout, highLoad)
+{
+    AgHashTable<uint64_t, ag_murmur_hash<uint64_t, size_t>, ag_hashtable_default_equals<uint64_t>, TypeParam>     table   {1'024};
+
+    // insert keys until just before the table has to grow
+    for (uint64_t i = 0; table.get_resize_count () == 0; ++i) {
+        ASSERT_TRUE (table.insert (i * 0x9E3779B97F4A7C15ULL));
+    }
+
+    // the last key needed a resize, so all the others fit in the original slots
+    ASSERT_GT (table.size () - 1, table.get_slot_count () / 2 * 9 / 10);
+    ASSERT_GT (table.get_displacement_count (), 0);
+    ASSERT_EQ (table.get_stash_count (), 0);
+}
+
+/**
+ * @brief                   Test iterating over all keys with a hash function whose values are spread over the entire 64 bit range
+ *
+ */
+TEST (Iterate, allKeys)
+{
+    AgHashTable<int64_t>                    table;
+    int64_t                                 sum     {0};
+    uint64_t                                count   {0};
+
+    ASSERT_EQ (table.begin (), table.end ());
+
+    for (int64_t i = 1; i <= 10'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+
+    for (auto it = table.begin (); it != table.end (); ++it) {
+        sum     += *it;
+        ++count;
+    }
+
+    ASSERT_EQ (count, 10'000);
+    ASSERT_EQ (sum, 50'005'000);
+}
+
+/**
+ * @brief                   Test iterating over keys spread across multiple aggregate nodes and multiple nodes per aggregate node
+ *
+ */
+TEST (Iterate, multiAggregateMultiNode)
+{
+    AgHashTable<int64_t, abs<int64_t>>      table;
+    int64_t                                 sum     {0};
+    uint64_t                                count   {0};
+
+    // insert the following keys into the table
+    // i and -i             (hash=i,                position=i)
+    // i + bucket count     (hash=i + bucket count, position=i)
+    // -i - bucket count    (hash=i + bucket count, position=i)
+    for (int64_t i = 1; i < 3; ++i) {
+        for (auto &e : {i, -i, i + (int64_t)table.get_bucket_count (), -i - (int64_t)table.get_bucket_count ()}) {
+            ASSERT_TRUE (table.insert (e));
+        }
+    }
+
+    // every key should be visited exactly once (the positive and negative keys cancel out)
+    for (auto it = table.begin (); it != table.end (); it++) {
+        sum     += *it;
+        ++count;
+    }
+
+    ASSERT_EQ (count, 8);
+    ASSERT_EQ (sum, 0);
+}
+
+/**
+ * @brief                   Checks that every key can be found, erased and iterated over while an incremental resize is in progress
+ *
+ */
+TEST (IncrementalResize, duringMigration)
+{
+    AgHashTable<int64_t>                    table;
+    int64_t                                 key     {0};
+    int64_t                                 sum     {0};
+    uint64_t                                count   {0};
+
+    ASSERT_TRUE (table.set_incremental_resize (true));
+    ASSERT_TRUE (table.get_incremental_resize ());
+
+    // insert keys until an incremental resize starts
+    while (table.get_pending_bucket_count () == 0) {
+        ASSERT_TRUE (table.insert (key++));
+    }
+
+    ASSERT_EQ (table.get_resize_count (), 1ULL);
+
+    // every key must be visible through both arrays while the migration is in progress
+    for (int64_t i = 0; i < key; ++i) {
+        ASSERT_TRUE (table.exists (i));
+        ASSERT_NE (table.find (i), table.end ());
+        ASSERT_EQ (*table.find (i), i);
+    }
+
+    for (auto it = table.begin (); it != table.end (); ++it) {
+        sum     += *it;
+        ++count;
+    }
+
+    ASSERT_EQ (count, (uint64_t)key);
+    ASSERT_EQ (sum, (key * (key - 1)) / 2);
+
+    // erasing a key moves its bucket over, after which it must not be found in either array
+    ASSERT_TRUE (table.erase (0));
+    ASSERT_FALSE (table.exists (0));
+    ASSERT_FALSE (table.erase (0));
+
+    // keep inserting until the migration completes, after which every key must still be present
+    while (table.get_pending_bucket_count () != 0) {
+        ASSERT_TRUE (table.insert (key++));
+    }
+
+    for (int64_t i = 1; i < key; ++i) {
+        ASSERT_TRUE (table.exists (i));
+    }
+
+    ASSERT_EQ (table.get_key_count (), (uint64_t)(key - 1));
+}
+
+/**
+ * @brief                   Checks that a table grown incrementally ends up with the same keys and bucket count as one which is not, and
+ *                          that turning incremental mode off finishes the migration in progress
+ *
+ */
+TEST (IncrementalResize, matchesFullResize)
+{
+    AgHashTable<int64_t>                    incremental;
+    AgHashTable<int64_t>                    full;
+
+    ASSERT_TRUE (incremental.set_incremental_resize (true));
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (incremental.insert (i));
+        ASSERT_TRUE (full.insert (i));
+
+        if (i % 3 == 0) {
+            ASSERT_TRUE (incremental.erase (i / 3));
+            ASSERT_TRUE (full.erase (i / 3));
+        }
+    }
+
+    ASSERT_TRUE (incremental.set_incremental_resize (false));
+    ASSERT_EQ (incremental.get_pending_bucket_count (), 0ULL);
+
+    ASSERT_EQ (incremental.get_key_count (), full.get_key_count ());
+    ASSERT_EQ (incremental.get_bucket_count (), full.get_bucket_count ());
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_EQ (incremental.exists (i), full.exists (i));
+    }
+}
+
+/**
+ * @brief                   Checks that the batched operations give the same results as the scalar operations, including for duplicate
+ *                          keys inside the same batch and keys which share a hash
+ *
+ */
+TEST (Batch, matchesScalar)
+{
+    AgHashTable<int32_t, mod2<int32_t>>     batched;
+    AgHashTable<int32_t, mod2<int32_t>>     scalar;
+
+    std::vector<int32_t>                    keys;
+    std::vector<int32_t>                    queries;
+    std::vector<AgHashTable<int32_t, mod2<int32_t>>::iterator>  iters;
+    bool                                    results[300];
+
+    // 200 keys with 100 duplicates, so that some duplicates fall inside the same group
+    for (int32_t i = 0; i < 300; ++i) {
+        keys.push_back ((i * 7) % 200);
+    }
+
+    ASSERT_EQ (batched.insert_batch (keys.data (), keys.size (), results), 200ULL);
+
+    for (int32_t i = 0; i < 300; ++i) {
+        ASSERT_EQ (results[i], scalar.insert (keys[i]));
+    }
+
+    ASSERT_EQ (batched.get_key_count (), scalar.get_key_count ());
+
+    for (int32_t i = -50; i < 250; ++i) {
+        queries.push_back (i);
+    }
+    iters.resize (queries.size ());
+
+    ASSERT_EQ (batched.exists_batch (queries.data (), queries.size (), results), 200ULL);
+    ASSERT_EQ (batched.exists_batch (queries.data (), queries.size (), nullptr), 200ULL);
+    ASSERT_EQ (batched.find_batch (queries.data (), queries.size (), iters.data ()), 200ULL);
+
+    for (uint64_t i = 0; i < queries.size (); ++i) {
+        ASSERT_EQ (results[i], scalar.exists (queries[i]));
+        ASSERT_EQ (iters[i], batched.find (queries[i]));
+    }
+}
+
+/**
+ * @brief                   Checks the batched operations while an incremental resize is in progress, where keys can be in either array
+ *
+ */
+TEST (Batch, duringMigration)
+{
+    AgHashTable<int64_t>                    table   {2};
+    std::vector<int64_t>                    keys;
+    std::vector<uint8_t>                    found;
+    bool                                    results[1'000];
+
+    table.set_incremental_resize (true);
+
+    for (int64_t i = 0; i < 20'000; ++i) {
+        keys.push_back (i);
+    }
+
+    ASSERT_EQ (table.insert_batch (keys.data (), keys.size ()), 20'000ULL);
+    ASSERT_GT (table.get_resize_count (), 0ULL);
+
+    // look the keys up in small batches, inserting a few keys in between to keep the migration going
+    for (int64_t base = 0; base < 40'000; base += 1'000) {
+
+        std::vector<int64_t>    queries;
+
+        for (int64_t i = base; i < base + 1'000; ++i) {
+            queries.push_back (i);
+        }
+
+        ASSERT_EQ (table.exists_batch (queries.data (), queries.size (), results), (base < 20'000) ? (1'000ULL) : (0ULL));
+
+        for (int64_t i = 0; i < 1'000; ++i) {
+            ASSERT_EQ (results[i], table.exists (base + i));
+        }
+
+        ASSERT_TRUE (table.insert (-1 - base));
+    }
+}
+
+/**
+ * @brief                   Returns the FNV-1a hash of the contents of a string
+ *
+ * @param pKey              Pointer to the string
+ *
+ * @return uint64_t         Hash of the string's contents
+ */
+inline uint64_t
+string_hash (const std::string *pKey)
+{
+    return ag_fnv1a_n<char, uint64_t> (pKey->data (), pKey->size ());
+}
+
+/**
+ * @brief                   Checks that the slab allocator carves nodes out of chunks, and reuses erased nodes instead of allocating new ones
+ *
+ */
+TEST (Allocator, slabRecyclesNodes)
+{
+    AgHashTable<int64_t, ag_fnv1a<int64_t, size_t>, ag_hashtable_default_equals<int64_t>, AgChainedLayout, AgSlabAllocator<64>>    table;
+    uint64_t                                chunkCount;
+    uint64_t                                aggregateCount;
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+
+    // 1000 nodes and (at most) 1000 aggregate nodes need far fewer chunks than nodes
+    chunkCount      = table.get_pool_alloc_count ();
+    aggregateCount  = table.get_aggregate_count ();
+
+    ASSERT_GE (chunkCount, 2ULL * (1'000 / 64));
+    ASSERT_LE (chunkCount, 2ULL * (1'000 / 64 + 1));
+    ASSERT_EQ (table.get_pool_free_count (), 0ULL);
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.erase (i));
+    }
+
+    // every node and aggregate node is kept for reuse
+    ASSERT_EQ (table.get_pool_free_count (), 1'000ULL + aggregateCount);
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.exists (i));
+    }
+
+    ASSERT_EQ (table.get_pool_alloc_count (), chunkCount);
+    ASSERT_EQ (table.get_pool_free_count (), 0ULL);
+}
+
+/**
+ * @brief                   Checks that keys which own memory are destroyed properly when nodes come from the slab allocator
+ *
+ */
+TEST (Allocator, slabNonTrivialKeys)
+{
+    AgHashTable<std::string, string_hash, ag_hashtable_default_equals<std::string>, AgChainedLayout, AgSlabAllocator<>>   table;
+
+    for (int32_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.insert (std::string (64, 'a') + std::to_string (i)));
+    }
+
+    for (int32_t i = 0; i < 1'000; i += 2) {
+        ASSERT_TRUE (table.erase (std::string (64, 'a') + std::to_string (i)));
+    }
+
+    for (int32_t i = 0; i < 1'000; ++i) {
+        ASSERT_EQ (table.exists (std::string (64, 'a') + std::to_string (i)), (i % 2) == 1);
+    }
+}
+
+/**
+ * @brief                   Checks that keys which own memory are moved and destroyed properly when the cuckoo layout moves them
+ *                          between buckets and into a larger bucket array
+ *
+ */
+TEST (Cuckoo, nonTrivialKeys)
+{
+    AgHashTable<std::string, string_hash, ag_hashtable_default_equals<std::string>, AgCuckooLayout<4>>   table   {2};
+
+    for (int32_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.insert (std::string (64, 'a') + std::to_string (i)));
+    }
+
+    ASSERT_GT (table.get_displacement_count (), 0);
+
+    for (int32_t i = 0; i < 1'000; i += 2) {
+        ASSERT_TRUE (table.erase (std::string (64, 'a') + std::to_string (i)));
+    }
+
+    for (int32_t i = 0; i < 1'000; ++i) {
+        ASSERT_EQ (table.exists (std::string (64, 'a') + std::to_string (i)), (i % 2) == 1);
+    }
+}
+
+/**
+ * @brief                   Checks that a frozen table built from a range holds every key exactly once, at a distinct position of the
+ *                          dense array, whether it is built on one thread or several
+ *
+ */
+TEST (Frozen, fromRange)
+{
+    std::vector<uint64_t>   keys;
+
+    for (uint64_t i = 0; i < 200'000; ++i) {
+        keys.push_back (i * 7 + 3);
+    }
+
+    for (uint64_t threadCount : {1ULL, 4ULL}) {
+
+        AgFrozenHashTable<uint64_t>     frozen  {keys.begin (), keys.end (), threadCount};
+        std::vector<bool>               seen    (keys.size (), false);
+
+        ASSERT_TRUE (frozen.initialized ());
+        ASSERT_EQ (frozen.size (), keys.size ());
+        ASSERT_EQ (frozen.get_fallback_count (), 0ULL);
+
+        // the perfect hash function should take well under a byte per key
+        ASSERT_LT (frozen.get_overhead_bytes (), keys.size ());
+
+        for (auto &key : keys) {
+            uint64_t    index   = frozen.get_index (key);
+
+            ASSERT_LT (index, keys.size ());
+            ASSERT_FALSE (seen[index]);
+            seen[index]     = true;
+
+            ASSERT_TRUE (frozen.exists (key));
+            ASSERT_EQ (*frozen.find (key), key);
+        }
+
+        for (uint64_t i = 0; i < 200'000; ++i) {
+            ASSERT_FALSE (frozen.exists (i * 7 + 4));
+            ASSERT_EQ (frozen.find (i * 7 + 4), frozen.end ());
+        }
+    }
+}
+
+/**
+ * @brief                   Checks that freezing tables of different layouts gives frozen tables holding the same keys
+ *
+ */
+TEST (Frozen, freezeTables)
+{
+    AgHashTable<int64_t>                                                                                chained;
+    AgHashTable<int64_t, ag_default_hash<int64_t, size_t> (), ag_hashtable_default_equals<int64_t>, AgCuckooLayout<>>    cuckoo;
+    int64_t                                                                                             sum     {0};
+
+    for (int64_t i = -5'000; i < 5'000; ++i) {
+        ASSERT_TRUE (chained.insert (i));
+        ASSERT_TRUE (cuckoo.insert (i));
+    }
+
+    auto        frozenChained   = ag_freeze (chained);
+    auto        frozenCuckoo    = ag_freeze (cuckoo, 2);
+
+    ASSERT_EQ (frozenChained.size (), 10'000ULL);
+    ASSERT_EQ (frozenCuckoo.size (), 10'000ULL);
+
+    for (int64_t i = -6'000; i < 6'000; ++i) {
+        ASSERT_EQ (frozenChained.exists (i), i >= -5'000 && i < 5'000) << "i: " << i << '\n';
+        ASSERT_EQ (frozenCuckoo.exists (i), i >= -5'000 && i < 5'000) << "i: " << i << '\n';
+    }
+
+    for (auto it = frozenChained.begin (); it != frozenChained.end (); ++it) {
+        sum     += *it;
+    }
+    ASSERT_EQ (sum, -5'000);
+}
+
+/**
+ * @brief                   Checks that keys sharing their hash (which never get a bit of their own) and duplicate keys are still held
+ *                          exactly once
+ *
+ */
+TEST (Frozen, sharedHashes)
+{
+    std::vector<int64_t>    keys;
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        keys.push_back (i);
+        keys.push_back (i);
+    }
+
+    AgFrozenHashTable<int64_t, mod2<int64_t>>       frozen  {keys.begin (), keys.end ()};
+
+    ASSERT_EQ (frozen.size (), 1'000ULL);
+    ASSERT_EQ (frozen.get_fallback_count (), 1'000ULL);
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (frozen.exists (i));
+        ASSERT_EQ (*frozen.find (i), i);
+    }
+    ASSERT_FALSE (frozen.exists (1'000));
+}
+
+/**
+ * @brief                   Checks that keys which own memory are copied into (and destroyed with) the frozen table
+ *
+ */
+TEST (Frozen, nonTrivialKeys)
+{
+    std::vector<std::string>    keys;
+
+    for (int32_t i = 0; i < 1'000; ++i) {
+        keys.push_back (std::string (64, 'a') + std::to_string (i));
+    }
+
+    AgFrozenHashTable<std::string, string_hash>     frozen  {keys.begin (), keys.end ()};
+
+    keys.clear ();
+
+    for (int32_t i = 0; i < 2'000; ++i) {
+        ASSERT_EQ (frozen.exists (std::string (64, 'a') + std::to_string (i)), i < 1'000);
+    }
+}
+
+/**
+ * @brief                   Checks that operator[] inserts value initialized values, and that the returned references stay valid across resizes
+ *
+ */
+TEST (HashMap, subscript)
+{
+    AgHashMap<int64_t, int64_t>             map     {2};
+    int64_t                                 *first;
+
+    first           = &(map[0]);
+    ASSERT_EQ (*first, 0);
+
+    *first          = 42;
+
+    for (int64_t i = 1; i < 10'000; ++i) {
+        map[i]      = 2 * i;
+    }
+
+    ASSERT_GT (map.get_resize_count (), 0ULL);
+    ASSERT_EQ (map.get_key_count (), 10'000ULL);
+
+    // nodes are never moved, so the reference taken before resizing still refers to the value of 0
+    ASSERT_EQ (first, &(map[0]));
+    ASSERT_EQ (map[0], 42);
+
+    for (int64_t i = 1; i < 10'000; ++i) {
+        ASSERT_EQ (map[i], 2 * i);
+    }
+
+    ASSERT_EQ (map.get_key_count (), 10'000ULL);
+}
+
+/**
+ * @brief                   Checks that try_emplace never overwrites an existing value, while insert_or_assign always does
+ *
+ */
+TEST (HashMap, emplaceAndAssign)
+{
+    AgHashMap<std::string, std::string, string_hash>    map;
+
+    ASSERT_TRUE (map.try_emplace ("a", 3, 'x'));
+    ASSERT_FALSE (map.try_emplace ("a", 5, 'y'));
+    ASSERT_EQ ((*map.find ("a")).value, "xxx");
+
+    ASSERT_TRUE (map.insert ("b", "first"));
+    ASSERT_FALSE (map.insert ("b", "second"));
+    ASSERT_EQ ((*map.find ("b")).value, "first");
+
+    ASSERT_FALSE (map.insert_or_assign ("b", "second"));
+    ASSERT_EQ ((*map.find ("b")).value, "second");
+
+    ASSERT_TRUE (map.insert_or_assign ("c", std::string ("third")));
+    ASSERT_EQ ((*map.find ("c")).value, "third");
+
+    ASSERT_EQ (map.get_key_count (), 3ULL);
+
+    ASSERT_TRUE (map.erase ("a"));
+    ASSERT_FALSE (map.erase ("a"));
+    ASSERT_FALSE (map.exists ("a"));
+    ASSERT_EQ (map.find ("a"), map.end ());
+    ASSERT_TRUE (map.exists ("b"));
+
+    ASSERT_EQ (map.get_key_count (), 2ULL);
+}
+
+/**
+ * @brief                   Counts the frequency of keys with update (), and checks the counts through iteration
+ *
+ */
+TEST (HashMap, updateCounts)
+{
+    AgHashMap<int32_t, uint64_t, mod2<int32_t>>     map;
+    uint64_t                                        total   {0ULL};
+
+    // every key shares one of two hashes, so the map also has to tell keys apart within aggregate nodes
+    for (int32_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (map.update (i % 10, [] (uint64_t &pCount) { ++pCount; }));
+    }
+
+    ASSERT_EQ (map.get_key_count (), 10ULL);
+    ASSERT_EQ (map.get_aggregate_count (), 2ULL);
+
+    for (auto &entry : map) {
+        ASSERT_EQ (entry.value, 100ULL);
+        total       += entry.value;
+    }
+
+    ASSERT_EQ (total, 1'000ULL);
+}
+
+/**
+ * @brief                   Checks that ag_fnv1a_str gives the same hash for the same characters held in different types of strings
+ *
+ */
+TEST (Transparent, stringHashAgrees)
+{
+    const char              *cStr   = "hello@example.com";
+    std::string             str     {cStr};
+    std::string_view        view    {str};
+
+    ASSERT_EQ ((ag_fnv1a_str<const char *, size_t> (&cStr)), (ag_fnv1a_str<std::string, size_t> (&str)));
+    ASSERT_EQ ((ag_fnv1a_str<const char *, size_t> (&cStr)), (ag_fnv1a_str<std::string_view, size_t> (&view)));
+
+    ASSERT_TRUE (ag_hashtable_str_equals (view, cStr));
+    ASSERT_FALSE (ag_hashtable_str_equals (view.substr (1), cStr));
+}
+
+/**
+ * @brief                   Searches for and erases C-style string keys using slices of a larger buffer, without NUL-terminating them
+ *
+ */
+TEST (Transparent, sliceLookup)
+{
+    AgHashTable<const char *, ag_fnv1a_str<const char *, size_t>>  table;
+
+    const char              *keys[]     = {"alpha", "beta", "gamma", "delta"};
+    std::string_view        buffer      {"alphabetagammadeltaepsilon"};
+
+    for (auto &key : keys) {
+        ASSERT_TRUE (table.insert (key));
+    }
+
+    ASSERT_TRUE (table.exists (buffer.substr (0, 5)));
+    ASSERT_TRUE (table.exists (buffer.substr (5, 4)));
+    ASSERT_TRUE (table.exists (buffer.substr (9, 5)));
+    ASSERT_FALSE (table.exists (buffer.substr (0, 4)));
+    ASSERT_FALSE (table.exists (buffer.substr (19)));
+
+    // the iterator refers to the stored key, not to the slice
+    ASSERT_EQ (*table.find (buffer.substr (14, 5)), keys[3]);
+    ASSERT_EQ (table.find (buffer.substr (14, 4)), table.end ());
+
+    ASSERT_TRUE (table.erase (buffer.substr (5, 4)));
+    ASSERT_FALSE (table.erase (buffer.substr (5, 4)));
+    ASSERT_FALSE (table.exists ("beta"));
+    ASSERT_EQ (table.get_key_count (), 3ULL);
+}
+
+/**
+ * @brief                   Searches for std::string keys using std::string_view, and for std::string_view keys using std::string
+ *
+ */
+TEST (Transparent, stdStrings)
+{
+    AgHashTable<std::string, ag_fnv1a_str<std::string, size_t>>     strings;
+    AgHashTable<std::string_view, ag_fnv1a_str<std::string_view, size_t>>   views;
+
+    for (int32_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (strings.insert (std::string (32, 'k') + std::to_string (i)));
+    }
+
+    for (int32_t i = 0; i < 2'000; ++i) {
+
+        std::string         key     = std::string (32, 'k') + std::to_string (i);
+
+        ASSERT_EQ (strings.exists (std::string_view {key}), i < 1'000);
+    }
+
+    ASSERT_TRUE (views.insert ("first"));
+    ASSERT_TRUE (views.insert ("second"));
+
+    ASSERT_TRUE (views.exists (std::string ("second")));
+    ASSERT_FALSE (views.exists (std::string ("third")));
+}
+
+TEST (StringTable, ownsKeys)
+{
+    AgStringTable<>         table;
+
+    {
+        std::string         shortKey    {"inline"};
+        std::string         longKey     (100, 'x');
+
+        ASSERT_TRUE (table.insert (shortKey));
+        ASSERT_TRUE (table.insert (longKey));
+        ASSERT_FALSE (table.insert (longKey));
+
+        // the table keeps its own copies, so the originals can be changed and destroyed
+        shortKey[0]     = 'o';
+        longKey[0]      = 'y';
+    }
+
+    ASSERT_TRUE (table.exists ("inline"));
+    ASSERT_TRUE (table.exists (std::string (100, 'x')));
+    ASSERT_FALSE (table.exists ("onlined"));
+    ASSERT_FALSE (table.exists ("y" + std::string (99, 'x')));
+
+    ASSERT_TRUE ((*table.find ("inline")).is_inline ());
+    ASSERT_FALSE ((*table.find (std::string (100, 'x'))).is_inline ());
+    ASSERT_EQ ((*table.find ("inline")).view (), "inline");
+    ASSERT_EQ (table.find ("missing"), table.end ());
+}
+
+TEST (StringTable, lengthBoundaries)
+{
+    AgStringTable<>             table   {1ULL};
+    std::vector<std::string>    keys;
+
+    // lengths around the inline capacity, the granule size and the largest pooled block, including the empty string
+    for (uint64_t len = 0; len <= 1100; len += ((len < 64) ? (1) : (37))) {
+        keys.push_back (std::string (len, (char)('a' + len % 26)));
+    }
+
+    for (auto &key : keys) {
+        ASSERT_TRUE (table.insert (key));
+    }
+    for (auto &key : keys) {
+        ASSERT_TRUE (table.exists (key));
+        ASSERT_EQ ((*table.find (key)).view (), key);
+    }
+
+    // strings which share a prefix but differ in length are different keys
+    ASSERT_FALSE (table.exists (std::string_view (keys[30]).substr (0, 29)));
+
+    for (uint64_t i = 0; i < keys.size (); i += 2) {
+        ASSERT_TRUE (table.erase (keys[i]));
+    }
+    for (uint64_t i = 0; i < keys.size (); ++i) {
+        ASSERT_EQ (table.exists (keys[i]), (i % 2) == 1);
+    }
+    ASSERT_EQ (table.get_key_count (), keys.size () / 2);
+}
+
+TEST (StringTable, arenaReuse)
+{
+    AgStringTable<>         table;
+    std::string             key;
+
+    for (uint64_t i = 0; i < 1000; ++i) {
+        key     = std::string (40, 'k') + std::to_string (i);
+        ASSERT_TRUE (table.insert (key));
+    }
+
+    uint64_t                reserved    = table.get_arena_reserved_amount ();
+
+    // erased characters are recycled by later keys needing as many granules, so churn does not grow the arena
+    for (uint64_t round = 0; round < 10; ++round) {
+        for (uint64_t i = 0; i < 1000; ++i) {
+            key     = std::string (40, 'k') + std::to_string (i);
+            ASSERT_TRUE (table.erase (key));
+        }
+        ASSERT_GT (table.get_arena_free_amount (), 0ULL);
+
+        for (uint64_t i = 0; i < 1000; ++i) {
+            key     = std::string (40, 'k') + std::to_string (i);
+            ASSERT_TRUE (table.insert (key));
+        }
+        ASSERT_EQ (table.get_arena_free_amount (), 0ULL);
+    }
+
+    ASSERT_EQ (table.get_arena_reserved_amount (), reserved);
+    ASSERT_EQ (table.get_key_count (), 1000ULL);
+}
+
+TEST (HashFunctions, wyhashVariantsAgree)
+{
+    struct triple_t {
+        uint64_t    a;
+        uint64_t    b;
+        uint64_t    c;
+    };
+
+    int64_t                 num     = 0x0123456789ABCDEFLL;
+    triple_t                triple  {1ULL, 2ULL, 3ULL};
+    const char              *str    = "the quick brown fox jumps over the lazy dog";
+    std::string             stdStr  {str};
+
+    ASSERT_EQ ((ag_wyhash<int64_t, uint64_t> (&num)), (ag_wyhash_n<int64_t, uint64_t> (&num, sizeof (num))));
+    ASSERT_EQ ((ag_wyhash<triple_t, uint64_t> (&triple)), (ag_wyhash_n<triple_t, uint64_t> (&triple, sizeof (triple))));
+    ASSERT_EQ ((ag_wyhash_str<const char *, uint64_t> (&str)), (ag_wyhash_n<char, uint64_t> (str, strlen (str))));
+    ASSERT_EQ ((ag_wyhash_str<const char *, uint64_t> (&str)), (ag_wyhash_str<std::string, uint64_t> (&stdStr)));
+
+    // narrower hashes are the low bits of the 64 bit hash
+    ASSERT_EQ ((ag_wyhash<int64_t, uint32_t> (&num)), (uint32_t)(ag_wyhash<int64_t, uint64_t> (&num)));
+}
+
+TEST (HashFunctions, wyhashEveryLength)
+{
+    std::vector<uint8_t>    buffer  (256);
+    std::vector<uint64_t>   hashes;
+
+    for (uint64_t i = 0; i < buffer.size (); ++i) {
+        buffer[i]   = (uint8_t)(i * 131 + 7);
+    }
+
+    // every length exercises a different path (upto 3, upto 16, upto 48 and longer), and prefixes must not collide
+    for (uint64_t len = 0; len <= buffer.size (); ++len) {
+        hashes.push_back (ag_wyhash_n<uint8_t, uint64_t> (buffer.data (), len));
+    }
+    std::sort (hashes.begin (), hashes.end ());
+    ASSERT_EQ (std::unique (hashes.begin (), hashes.end ()), hashes.end ());
+
+    // flipping any single bit changes the hash
+    for (uint64_t len : {1ULL, 3ULL, 4ULL, 8ULL, 15ULL, 16ULL, 17ULL, 48ULL, 49ULL, 200ULL}) {
+
+        uint64_t            original    = ag_wyhash_n<uint8_t, uint64_t> (buffer.data (), len);
+
+        for (uint64_t bit = 0; bit < len * 8; ++bit) {
+            buffer[bit / 8]     ^= (uint8_t)(1U << (bit % 8));
+            ASSERT_NE ((ag_wyhash_n<uint8_t, uint64_t> (buffer.data (), len)), original);
+            buffer[bit / 8]     ^= (uint8_t)(1U << (bit % 8));
+        }
+    }
+}
+
+TEST (HashFunctions, wyhashLowBitsSpread)
+{
+    std::vector<uint64_t>   counts  (256);
+    std::string             str;
+
+    // sequential integers and short numeric strings must spread over the buckets selected by the low bits
+    for (int64_t i = 0; i < 256 * 64; ++i) {
+        ++counts[ag_wyhash<int64_t, uint64_t> (&i) & 255];
+    }
+    for (auto &count : counts) {
+        ASSERT_GT (count, 24ULL);
+        ASSERT_LT (count, 112ULL);
+        count   = 0;
+    }
+
+    for (int64_t i = 0; i < 256 * 64; ++i) {
+        str     = std::to_string (1'000'000 + i);
+        ++counts[ag_wyhash_n<char, uint64_t> (str.data (), str.size ()) & 255];
+    }
+    for (auto &count : counts) {
+        ASSERT_GT (count, 24ULL);
+        ASSERT_LT (count, 112ULL);
+    }
+}
+
+TEST (HashFunctions, wyhashTables)
+{
+    AgHashTable<int64_t, ag_wyhash<int64_t, size_t>>                 numbers;
+    AgHashTable<const char *, ag_wyhash_str<const char *, size_t>>   strings;
+
+    const char              *keys[]     = {"alpha", "beta", "gamma", "delta"};
+    std::string_view        buffer      {"alphabetagammadeltaepsilon"};
+
+    for (int64_t i = 0; i < 10'000; ++i) {
+        ASSERT_TRUE (numbers.insert (i * 1024));
+    }
+    for (int64_t i = 0; i < 10'000; ++i) {
+        ASSERT_TRUE (numbers.exists (i * 1024));
+        ASSERT_FALSE (numbers.exists (i * 1024 + 1));
+    }
+
+    for (auto &key : keys) {
+        ASSERT_TRUE (strings.insert (key));
+    }
+
+    // slices are hashed with ag_wyhash_str by default, since the stored keys are
+    ASSERT_TRUE (strings.exists (buffer.substr (9, 5)));
+    ASSERT_FALSE (strings.exists (buffer.substr (19)));
+    ASSERT_TRUE (strings.erase (buffer.substr (0, 5)));
+    ASSERT_FALSE (strings.exists ("alpha"));
+}
+
+TEST (HashFunctions, pearsonSpreads)
+{
+    std::vector<uint64_t>   counts  (1ULL << 16);
+    uint64_t                distinct;
+
+    // keys whose 16 bit words repeat used to fold to a single hash
+    for (int64_t i = 0; i < (1LL << 16); ++i) {
+
+        int64_t             key     = i * 65537;
+        ++counts[ag_pearson_16_hash<int64_t> (&key)];
+    }
+
+    distinct    = (uint64_t)std::count_if (counts.begin (), counts.end (), [] (const uint64_t &pCount) { return pCount > 0; });
+
+    // a random function gives about 41,400 distinct hashes for 65,536 keys
+    ASSERT_GT (distinct, 39'000ULL);
+    ASSERT_LT (*std::max_element (counts.begin (), counts.end ()), 16ULL);
+
+    // the hash of every single byte key differs, since the table is a permutation
+    std::fill (counts.begin (), counts.end (), 0ULL);
+    for (uint16_t i = 0; i < 256; ++i) {
+
+        uint8_t             key     = (uint8_t)i;
+        ASSERT_EQ (++counts[ag_pearson_16_hash<uint8_t> (&key)], 1ULL);
+    }
+}
+
+TEST (HashFunctions, pearsonTable)
+{
+    AgHashTable<int64_t, ag_pearson_16_hash<int64_t>>   table;
+
+    for (int64_t i = 0; i < 20'000; ++i) {
+        ASSERT_TRUE (table.insert (i * 65537));
+    }
+    for (int64_t i = 0; i < 20'000; ++i) {
+        ASSERT_TRUE (table.exists (i * 65537));
+        ASSERT_FALSE (table.exists (i * 65537 + 1));
+    }
+    ASSERT_EQ (table.get_key_count (), 20'000ULL);
+}
+
+TEST (HashFunctions, integerDefaults)
+{
+    static_assert (ag_same_function<ag_default_hash<int32_t, size_t> (), ag_fibonacci_hash<int32_t, size_t>> ());
+    static_assert (ag_same_function<ag_default_hash<uint64_t, size_t> (), ag_fibonacci_hash<uint64_t, size_t>> ());
+    static_assert (ag_same_function<ag_default_hash<char, size_t> (), ag_fibonacci_hash<char, size_t>> ());
+    static_assert (ag_same_function<ag_default_hash<double, size_t> (), ag_fnv1a<double, size_t>> ());
+
+    int32_t             key     = 12345;
+    uint64_t            wide    = 0x0123456789ABCDEFULL;
+
+    ASSERT_EQ (ag_byteswap (wide), 0xEFCDAB8967452301ULL);
+    ASSERT_EQ ((ag_map_hash<int32_t, ag_fibonacci_hash<int32_t, size_t>> (wide)), (size_t)0xEFCDAB8967452301ULL);
+    ASSERT_EQ ((ag_map_hash<int32_t, ag_fnv1a<int32_t, size_t>> (wide)), (size_t)wide);
+    ASSERT_EQ ((ag_bucket_hash<int32_t, ag_fibonacci_hash<int32_t, size_t>> (&key)), ag_byteswap (ag_fibonacci_hash<int32_t, size_t> (&key)));
+}
+
+TEST (HashFunctions, integerBucketSpread)
+{
+    // keys whose low bits never change must still be spread over every bucket by the high bits of the product
+    AgHashTable<int64_t>                                    table;
+    uint64_t                                                maxKeys     = 0;
+
+    for (int64_t i = 0; i < 50'000; ++i) {
+        ASSERT_TRUE (table.insert (i * 4096));
+    }
+    for (uint64_t bucketId = 0; bucketId < table.get_bucket_count (); ++bucketId) {
+        maxKeys     = std::max (maxKeys, table.get_bucket_key_count (bucketId));
+    }
+    ASSERT_LE (maxKeys, 8ULL);
+
+    for (int64_t i = 0; i < 50'000; ++i) {
+        ASSERT_TRUE (table.exists (i * 4096));
+        ASSERT_FALSE (table.exists (i * 4096 + 1));
+    }
+    for (int64_t i = 0; i < 50'000; i += 2) {
+        ASSERT_TRUE (table.erase (i * 4096));
+    }
+    ASSERT_EQ (table.get_key_count (), 25'000ULL);
+}
+
+TEST (HashFunctions, integerTables)
+{
+    AgHashTable<uint32_t, ag_murmur_hash<uint32_t, size_t>>                                             table1;
+    AgHashTable<int32_t, ag_fibonacci_hash<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgSwissLayout>   table2;
+    AgHashMap<int16_t, int32_t>                                                                         table3;
+
+    for (int32_t i = -10'000; i < 10'000; ++i) {
+        ASSERT_TRUE (table1.insert ((uint32_t)i));
+        ASSERT_TRUE (table2.insert (i * 256));
+        ASSERT_TRUE (table3.insert ((int16_t)i, i * 2));
+    }
+    for (int32_t i = -10'000; i < 10'000; ++i) {
+        ASSERT_TRUE (table1.exists ((uint32_t)i));
+        ASSERT_TRUE (table2.exists (i * 256));
+        ASSERT_FALSE (table2.exists (i * 256 + 1));
+        ASSERT_EQ ((*table3.find ((int16_t)i)).value, i * 2);
+    }
+    ASSERT_EQ (table1.get_key_count (), 20'000ULL);
+    ASSERT_EQ (table2.get_key_count (), 20'000ULL);
+    ASSERT_EQ (table3.get_key_count (), 20'000ULL);
+}
+
+/**
+ * @brief                   Checks that hashing an array of keys at once gives the same hashes as hashing each key, for every length
+ *                          up to a few registers (so that every combination of full registers and leftover keys is covered)
+ *
+ */
+template <typename key_t>
+void
+check_hash_keys ()
+{
+    std::vector<key_t>      keys;
+    std::vector<uint64_t>   hashes  (64);
+    std::vector<uint32_t>   narrow  (64);
+
+    for (int64_t i = 0; i < 64; ++i) {
+        keys.push_back ((key_t)((i - 20) * 0x12345679LL));
+    }
+
+    for (uint64_t count = 0; count <= keys.size (); ++count) {
+
+        ag_fibonacci_hash_keys<key_t, uint64_t> (keys.data (), count, hashes.data ());
+        for (uint64_t keyId = 0; keyId < count; ++keyId) {
+            ASSERT_EQ (hashes[keyId], (ag_fibonacci_hash<key_t, uint64_t> (&keys[keyId])));
+        }
+
+        ag_murmur_hash_keys<key_t, uint64_t> (keys.data (), count, hashes.data ());
+        for (uint64_t keyId = 0; keyId < count; ++keyId) {
+            ASSERT_EQ (hashes[keyId], (ag_murmur_hash<key_t, uint64_t> (&keys[keyId])));
+        }
+
+        ag_fibonacci_hash_keys<key_t, uint32_t> (keys.data (), count, narrow.data ());
+        for (uint64_t keyId = 0; keyId < count; ++keyId) {
+            ASSERT_EQ (narrow[keyId], (ag_fibonacci_hash<key_t, uint32_t> (&keys[keyId])));
+        }
+
+        ag_bucket_hash_keys<key_t, ag_fibonacci_hash<key_t, uint64_t>> (keys.data (), count, hashes.data ());
+        for (uint64_t keyId = 0; keyId < count; ++keyId) {
+            ASSERT_EQ (hashes[keyId], (ag_bucket_hash<key_t, ag_fibonacci_hash<key_t, uint64_t>> (&keys[keyId])));
+        }
+    }
+}
+
+TEST (HashFunctions, hashKeysAgree)
+{
+    check_hash_keys<int32_t> ();
+    check_hash_keys<uint32_t> ();
+    check_hash_keys<int64_t> ();
+    check_hash_keys<uint64_t> ();
+    check_hash_keys<int16_t> ();
+    check_hash_keys<uint8_t> ();
+}
+
+TEST (Batch, insertRange)
+{
+    std::vector<int32_t>                                    keys;
+    std::list<int32_t>                                      listed;
+
+    AgHashTable<int32_t>                                    table1;
+    AgHashTable<int32_t, ag_murmur_hash<int32_t, size_t>>   table2;
+    AgHashTable<int64_t>                                    table3;
+    AgHashTable<std::string, ag_fnv1a_str<std::string, size_t>>     table4;
+    std::vector<std::string>                                strings {"a", "b", "a", "c", "b"};
+
+    // every key appears twice, and the array is not a multiple of the batch width
+    for (int32_t i = 0; i < 10'003; ++i) {
+        keys.push_back (i * 7);
+        keys.push_back (i * 7);
+        listed.push_back (-i);
+    }
+
+    ASSERT_EQ (table1.insert_range (keys.data (), keys.data () + keys.size ()), 10'003ULL);
+    ASSERT_EQ (table1.insert_range (keys.data (), keys.data () + keys.size ()), 0ULL);
+    ASSERT_EQ (table1.insert_range (listed.begin (), listed.end ()), 10'002ULL);
+    ASSERT_EQ (table1.get_key_count (), 20'005ULL);
+
+    ASSERT_EQ (table2.insert_range (keys.begin (), keys.end ()), 10'003ULL);
+    ASSERT_EQ (table3.insert_range (keys.begin (), keys.end ()), 10'003ULL);
+    ASSERT_EQ (table4.insert_range (strings.begin (), strings.end ()), 3ULL);
+    ASSERT_EQ (table4.insert_range (strings.begin (), strings.begin ()), 0ULL);
+
+    for (int32_t i = 0; i < 10'003; ++i) {
+        ASSERT_TRUE (table1.exists (i * 7));
+        ASSERT_TRUE (table1.exists (-i));
+        ASSERT_TRUE (table2.exists (i * 7));
+        ASSERT_FALSE (table2.exists (i * 7 + 1));
+        ASSERT_TRUE (table3.exists (i * 7));
+    }
+    ASSERT_TRUE (table4.exists ("c"));
+}
+
+uint64_t        equalsCalls     = 0;            /** Number of calls made to counting_equals */
+uint64_t        hashCalls       = 0;            /** Number of calls made to counting_hash */
+
+/**
+ * @brief                   Equals comparator which counts the number of times it is called
+ *
+ */
+bool
+counting_equals (const int64_t &pA, const int64_t &pB)
+{
+    ++equalsCalls;
+    return pA == pB;
+}
+
+/**
+ * @brief                   Hash function which counts the number of times it is called
+ *
+ */
+size_t
+counting_hash (const int64_t *pKey)
+{
+    ++hashCalls;
+    return ag_murmur_hash<int64_t, size_t> (pKey);
+}
+
+TEST (Fingerprint, skipsComparisons)
+{
+    // every key has one of two hashes, so every lookup searches a list with half of the keys
+    AgHashTable<int64_t, mod2<int64_t>, counting_equals, AgChainedFingerprintLayout<ag_murmur_hash<int64_t, uint32_t>>>    table;
+    AgHashTable<int64_t, mod2<int64_t>, counting_equals>                                                                    plain;
+
+    equalsCalls     = 0;
+    for (int64_t i = 0; i < 2'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+    // only the second key of each hash is compared to the first without a fingerprint
+    ASSERT_LE (equalsCalls, 2ULL);
+
+    equalsCalls     = 0;
+    for (int64_t i = 0; i < 2'000; ++i) {
+        ASSERT_TRUE (table.exists (i));
+        ASSERT_FALSE (table.exists (i + 2'000));
+        ASSERT_FALSE (table.insert (i));
+    }
+    // a fingerprint collision between different keys is possible, but very unlikely
+    ASSERT_LE (equalsCalls, 4'010ULL);
+
+    equalsCalls     = 0;
+    for (int64_t i = 0; i < 200; ++i) {
+        ASSERT_TRUE (plain.insert (i));
+    }
+    ASSERT_GE (equalsCalls, 9'000ULL);
+
+    equalsCalls     = 0;
+    for (int64_t i = 0; i < 2'000; i += 2) {
+        ASSERT_TRUE (table.erase (i));
+        ASSERT_FALSE (table.erase (i));
+    }
+    ASSERT_LE (equalsCalls, 1'010ULL);
+    ASSERT_EQ (table.get_key_count (), 1'000ULL);
+
+    for (auto it = table.begin (); it != table.end (); ++it) {
+        ASSERT_EQ (*it % 2, 1);
+    }
+}
+
+TEST (Fingerprint, batchedAndMigration)
+{
+    AgHashTable<int64_t, ag_pearson_16_hash<int64_t>, ag_hashtable_default_equals<int64_t>, AgChainedFingerprintLayout<ag_wyhash<int64_t, uint16_t>>>  table;
+
+    std::vector<int64_t>    keys;
+    std::vector<decltype (table)::iterator>     iters (40'000);
+
+    // more keys than 16 bit hashes, so that aggregate nodes hold several keys
+    for (int64_t i = 0; i < 80'000; ++i) {
+        keys.push_back (i * 3);
+    }
+
+    ASSERT_TRUE (table.set_incremental_resize (true));
+    ASSERT_EQ (table.insert_batch (keys.data (), 40'000), 40'000ULL);
+    for (int64_t i = 40'000; i < 80'000; ++i) {
+        ASSERT_TRUE (table.insert (keys[i]));
+    }
+
+    ASSERT_EQ (table.find_batch (keys.data () + 20'000, 40'000, iters.data ()), 40'000ULL);
+    for (uint64_t keyId = 0; keyId < iters.size (); ++keyId) {
+        ASSERT_EQ (*iters[keyId], keys[20'000 + keyId]);
+    }
+    ASSERT_EQ (table.exists_batch (keys.data (), 80'000, nullptr), 80'000ULL);
+    ASSERT_FALSE (table.exists (1));
+    ASSERT_EQ (table.get_key_count (), 80'000ULL);
+}
+
+TEST (Fingerprint, resizeReusesHashes)
+{
+    AgHashTable<int64_t, counting_hash>     table;
+    AgHashTable<int64_t, counting_hash>     incremental;
+    uint64_t                                bucketCountInit;
+
+    ASSERT_TRUE (incremental.set_incremental_resize (true));
+    bucketCountInit = table.get_bucket_count ();
+
+    // every key is hashed exactly once, no matter how many times the table is resized
+    hashCalls       = 0;
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        ASSERT_TRUE (incremental.insert (i));
+    }
+    ASSERT_GT (table.get_bucket_count (), bucketCountInit);
+    ASSERT_EQ (hashCalls, 200'000ULL);
+}
+
+TEST (GrowthPolicy, presets)
+{
+    AgHashTable<int64_t>    lean;
+    AgHashTable<int64_t>    balanced;
+    AgHashTable<int64_t>    fast;
+
+    ASSERT_EQ (balanced.get_growth_policy ().resizeFactor, AgGrowthPolicy::balanced ().resizeFactor);
+    ASSERT_TRUE (lean.set_growth_policy (AgGrowthPolicy::memory_lean ()));
+    ASSERT_TRUE (fast.set_growth_policy (AgGrowthPolicy::latency_lean ()));
+    ASSERT_EQ (lean.get_growth_policy ().numKeysAllowed, AgGrowthPolicy::memory_lean ().numKeysAllowed);
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (lean.insert (i));
+        ASSERT_TRUE (balanced.insert (i));
+        ASSERT_TRUE (fast.insert (i));
+    }
+
+    ASSERT_LT (lean.get_bucket_count (), fast.get_bucket_count ());
+    ASSERT_LE (lean.get_bucket_count (), balanced.get_bucket_count ());
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (lean.exists (i));
+        ASSERT_TRUE (fast.exists (i));
+    }
+}
+
+TEST (GrowthPolicy, limits)
+{
+    AgHashTable<int64_t>    table;
+    AgHashTable<int64_t>    incremental;
+    AgGrowthPolicy          growth      = AgGrowthPolicy::balanced ();
+
+    // the resize factor and maximum number of buckets must be powers of 2, and the table must be able to grow
+    growth.resizeFactor     = 3;
+    ASSERT_FALSE (table.set_growth_policy (growth));
+    growth.resizeFactor     = 1;
+    ASSERT_FALSE (table.set_growth_policy (growth));
+    growth.resizeFactor     = 8;
+    growth.maxBucketCount   = 1000;
+    ASSERT_FALSE (table.set_growth_policy (growth));
+    ASSERT_EQ (table.get_growth_policy ().maxBucketCount, AgGrowthPolicy::balanced ().maxBucketCount);
+
+    // the last step is cut short so that the table ends up with exactly the maximum number of buckets
+    growth.maxBucketCount   = 1024;
+    ASSERT_TRUE (table.set_growth_policy (growth));
+    ASSERT_TRUE (incremental.set_growth_policy (growth));
+    ASSERT_TRUE (incremental.set_incremental_resize (true));
+    ASSERT_EQ (table.get_max_bucket_count (), 1024ULL);
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        ASSERT_TRUE (incremental.insert (i));
+    }
+    ASSERT_EQ (table.get_bucket_count (), 1024ULL);
+    ASSERT_EQ (incremental.get_bucket_count (), 1024ULL);
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (table.exists (i));
+        ASSERT_TRUE (incremental.exists (i));
+    }
+}
+
+TEST (Shrink, reserveAndRehash)
+{
+    AgHashTable<int64_t>    table;
+    uint64_t                resizeCount;
+    uint64_t                allocAmount;
+
+    // room for the keys at two keys per bucket (the target load of the default policy), so inserting them never grows the table
+    ASSERT_TRUE (table.reserve (100'000));
+    ASSERT_EQ (table.get_bucket_count (), 65536ULL);
+    resizeCount     = table.get_resize_count ();
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+    ASSERT_EQ (table.get_resize_count (), resizeCount);
+
+    // reserve never shrinks the table, while rehash never leaves it with fewer buckets than its keys need
+    ASSERT_TRUE (table.reserve (10));
+    ASSERT_EQ (table.get_bucket_count (), 65536ULL);
+    ASSERT_TRUE (table.rehash (1000));
+    ASSERT_EQ (table.get_bucket_count (), 65536ULL);
+    ASSERT_TRUE (table.rehash (100'000));
+    ASSERT_EQ (table.get_bucket_count (), 131072ULL);
+
+    for (int64_t i = 0; i < 99'990; ++i) {
+        ASSERT_TRUE (table.erase (i));
+    }
+
+    // the policy does not shrink the table on its own
+    ASSERT_EQ (table.get_bucket_count (), 131072ULL);
+    allocAmount     = table.get_alloc_amount ();
+    ASSERT_TRUE (table.shrink_to_fit ());
+    ASSERT_EQ (table.get_bucket_count (), 8ULL);
+    ASSERT_LT (table.get_alloc_amount (), allocAmount);
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_EQ (table.exists (i), i >= 99'990);
+    }
+}
+
+TEST (Shrink, automatic)
+{
+    AgHashTable<int64_t>    table;
+    AgHashTable<int64_t>    incremental;
+    AgGrowthPolicy          growth      = AgGrowthPolicy::balanced ();
+    uint64_t                resizeCount;
+
+    // the shrink load can be atmost half of the target load (two keys per bucket)
+    growth.shrinkLoadPercent    = 101;
+    ASSERT_FALSE (table.set_growth_policy (growth));
+    ASSERT_EQ (table.get_growth_policy ().shrinkLoadPercent, 0ULL);
+
+    growth.shrinkLoadPercent    = 25;
+    ASSERT_TRUE (table.set_growth_policy (growth));
+    ASSERT_TRUE (incremental.set_growth_policy (growth));
+    ASSERT_TRUE (incremental.set_incremental_resize (true));
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        ASSERT_TRUE (incremental.insert (i));
+    }
+
+    for (int64_t i = 0; i < 99'990; ++i) {
+        ASSERT_TRUE (table.erase (i));
+        ASSERT_TRUE (incremental.erase (i));
+
+        // the table never holds fewer keys than a quarter of its buckets
+        ASSERT_GE (table.size () * 4, table.get_bucket_count ());
+    }
+    ASSERT_EQ (table.get_bucket_count (), 8ULL);
+    ASSERT_LE (incremental.get_bucket_count (), 64ULL);
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_EQ (table.exists (i), i >= 99'990);
+        ASSERT_EQ (incremental.exists (i), i >= 99'990);
+    }
+
+    // a shrunk table holds more than twice the shrink load, so it takes many erasures (or insertions) before it is resized again
+    resizeCount     = table.get_resize_count ();
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        ASSERT_TRUE (table.erase (i));
+    }
+    ASSERT_EQ (table.get_resize_count (), resizeCount);
+}
+
+TEST (Move, moveAndSwap)
+{
+    using               slab_table_t    = AgHashTable<std::string, ag_wyhash_str<std::string, size_t>, ag_hashtable_default_equals<std::string>, AgChainedLayout, AgSlabAllocator<64>>;
+
+    std::vector<slab_table_t>   tables;
+    slab_table_t                other;
+    uint64_t                    allocCount;
+
+    static_assert (std::is_nothrow_move_constructible<slab_table_t>::value, "Tables must be movable without throwing");
+    static_assert (std::is_nothrow_move_assignable<slab_table_t>::value, "Tables must be movable without throwing");
+
+    // tables can be kept in a vector, which moves them every time it grows
+    for (int32_t tableId = 0; tableId < 16; ++tableId) {
+        tables.emplace_back ();
+        for (int32_t i = 0; i < 1000; ++i) {
+            ASSERT_TRUE (tables.back ().insert (std::to_string (tableId * 1000 + i)));
+        }
+    }
+
+    for (int32_t tableId = 0; tableId < 16; ++tableId) {
+        ASSERT_EQ (tables[tableId].size (), 1000ULL);
+        ASSERT_TRUE (tables[tableId].exists (std::to_string (tableId * 1000 + 999)));
+        ASSERT_FALSE (tables[tableId].exists (std::to_string ((tableId + 1) * 1000)));
+    }
+
+    // moving takes the nodes along with their pool, without allocating anything
+    allocCount      = tables[0].get_alloc_count ();
+    other           = std::move (tables[0]);
+    ASSERT_EQ (other.size (), 1000ULL);
+    ASSERT_EQ (other.get_alloc_count (), allocCount);
+    ASSERT_TRUE (other.erase ("999"));
+    ASSERT_TRUE (other.insert ("abc"));
+
+    slab_table_t                moved       {std::move (other)};
+    ASSERT_TRUE (other.initialized ());
+    ASSERT_EQ (other.size (), 0ULL);
+    ASSERT_TRUE (moved.exists ("abc"));
+    ASSERT_FALSE (moved.exists ("999"));
+
+    // swapping exchanges every key
+    moved.swap (other);
+    ASSERT_TRUE (other.exists ("abc"));
+    ASSERT_EQ (moved.size (), 0ULL);
+
+    tables[1].swap (tables[2]);
+    ASSERT_TRUE (tables[1].exists ("2000"));
+    ASSERT_TRUE (tables[2].exists ("1000"));
+    ASSERT_FALSE (tables[1].exists ("1000"));
+}
+
+/**
+ * @brief                   Checks that a table which has been moved from is left as an empty table, which can be searched and
+ *                          modified like a newly constructed one
+ *
+ */
+TEST (Move, usableAfterMove)
+{
+    AgHashTable<int64_t>                table;
+    AgHashMap<int64_t, std::string>     map;
+
+    for (int64_t i = 0; i < 1000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        ASSERT_TRUE (map.insert (i, std::to_string (i)));
+    }
+
+    AgHashTable<int64_t>                moved       {std::move (table)};
+    AgHashMap<int64_t, std::string>     movedMap    {std::move (map)};
+
+    ASSERT_EQ (moved.size (), 1000ULL);
+    ASSERT_EQ (movedMap.size (), 1000ULL);
+
+    ASSERT_TRUE (table.initialized ());
+    ASSERT_EQ (table.size (), 0ULL);
+    ASSERT_TRUE (table.begin () == table.end ());
+    ASSERT_FALSE (table.exists (5));
+    ASSERT_TRUE (table.find (5) == table.end ());
+    ASSERT_FALSE (table.erase (5));
+    ASSERT_FALSE (map.exists (5));
+
+    // the moved from table grows like any other
+    for (int64_t i = 0; i < 1000; ++i) {
+        ASSERT_TRUE (table.insert (-i));
+        ASSERT_TRUE (map.insert (-i, "moved"));
+    }
+    ASSERT_TRUE (table.erase (-5));
+    ASSERT_EQ (table.size (), 999ULL);
+    ASSERT_EQ (map[-7], "moved");
+    ASSERT_TRUE (moved.exists (5));
+    ASSERT_FALSE (moved.exists (-5));
+
+    // moving in the other direction hands the present keys to the moved from table
+    moved           = std::move (table);
+    ASSERT_TRUE (moved.exists (-6));
+    ASSERT_TRUE (table.exists (6));
+}
+
+TEST (Move, clone)
+{
+    AgHashTable<int64_t, mod2<int64_t>, counting_equals, AgChainedFingerprintLayout<ag_murmur_hash<int64_t, uint32_t>>>    table;
+    AgHashTable<int64_t>    incremental;
+    AgHashMap<int64_t, std::string>                 map;
+
+    for (int64_t i = 0; i < 1000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        ASSERT_TRUE (map.insert (i, std::to_string (i)));
+    }
+
+    // the copy is made without comparing a single key, and is independent of the table
+    equalsCalls     = 0;
+    auto            copy        = table.clone ();
+    ASSERT_EQ (equalsCalls, 0ULL);
+    ASSERT_TRUE (copy.initialized ());
+    ASSERT_EQ (copy.size (), 1000ULL);
+    ASSERT_EQ (copy.get_bucket_count (), table.get_bucket_count ());
+    ASSERT_EQ (copy.get_bucket_key_count (0), table.get_bucket_key_count (0));
+
+    ASSERT_TRUE (table.erase (5));
+    ASSERT_TRUE (copy.exists (5));
+    ASSERT_TRUE (copy.erase (6));
+    ASSERT_TRUE (table.exists (6));
+
+    // a table in the middle of an incremental resize is copied with the resize finished
+    ASSERT_TRUE (incremental.set_incremental_resize (true));
+    for (int64_t i = 0; i < 10'000; ++i) {
+        ASSERT_TRUE (incremental.insert (i));
+        if (incremental.get_pending_bucket_count () > 0) {
+            break;
+        }
+    }
+    ASSERT_GT (incremental.get_pending_bucket_count (), 0ULL);
+
+    AgHashTable<int64_t>    other;
+    ASSERT_TRUE (other.insert (-1));
+    ASSERT_TRUE (other.copy_from (incremental));
+    ASSERT_EQ (other.get_pending_bucket_count (), 0ULL);
+    ASSERT_EQ (other.size (), incremental.size ());
+    ASSERT_FALSE (other.exists (-1));
+    for (int64_t i = 0; i < (int64_t)incremental.size (); ++i) {
+        ASSERT_TRUE (other.exists (i));
+    }
+
+    // maps copy their values along with their keys
+    auto            mapCopy     = map.clone ();
+    map[7]          = "changed";
+    ASSERT_EQ (mapCopy[7], "7");
+    ASSERT_EQ (mapCopy.size (), 1000ULL);
+}
+
+/**
+ * @brief                   Checks that copying into a table which already holds keys releases them (along with their aggregate nodes)
+ *                          from the allocation counters, so the copy accounts for as much memory as the table it copies
+ *
+ */
+TEST (Move, copyAllocations)
+{
+    AgHashTable<int64_t>    source;
+    AgHashTable<int64_t>    copy;
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (source.insert (i));
+    }
+    for (int64_t i = 0; i < 5'000; ++i) {
+        ASSERT_TRUE (copy.insert (-i - 1));
+    }
+
+    ASSERT_TRUE (copy.copy_from (source));
+    ASSERT_EQ (copy.get_bucket_count (), source.get_bucket_count ());
+    ASSERT_EQ (copy.get_alloc_amount (), source.get_alloc_amount ());
+    ASSERT_EQ (copy.get_alloc_count () - copy.get_delete_count (), source.get_alloc_count () - source.get_delete_count ());
+}
+
+/**
+ * @brief                   Checks that clear erases every key while keeping the buckets, including long chains of keys with the same hash and
+ *                          keys in an old bucket array during an incremental resize
+ *
+ */
+TEST (Clear, keepsBuckets)
+{
+    AgHashTable<int64_t, mod2<int64_t>>     chained;
+    AgHashTable<int64_t>                    table;
+    uint64_t                                bucketCount;
+    uint64_t                                resizeCount;
+    uint64_t                                liveCount   = table.get_alloc_count () - table.get_delete_count ();
+
+    // every key shares one of two hashes, so each hash holds a single long list of nodes
+    for (int64_t i = 0; i < 5'000; ++i) {
+        ASSERT_TRUE (chained.insert (i));
+    }
+    chained.clear ();
+    ASSERT_EQ (chained.size (), 0ULL);
+    ASSERT_EQ (chained.get_aggregate_count (), 0ULL);
+    ASSERT_EQ (chained.get_alloc_count () - chained.get_delete_count (), liveCount);
+    ASSERT_TRUE (chained.begin () == chained.end ());
+    ASSERT_FALSE (chained.exists (0));
+    ASSERT_TRUE (chained.insert (0));
+
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+
+    bucketCount     = table.get_bucket_count ();
+    resizeCount     = table.get_resize_count ();
+
+    table.clear ();
+    ASSERT_EQ (table.size (), 0ULL);
+    ASSERT_EQ (table.get_bucket_count (), bucketCount);
+    ASSERT_EQ (table.get_alloc_count () - table.get_delete_count (), liveCount);
+    for (uint64_t bucketId = 0; bucketId < bucketCount; ++bucketId) {
+        ASSERT_EQ (table.get_bucket_key_count (bucketId), 0ULL);
+        ASSERT_EQ (table.get_bucket_hash_count (bucketId), 0ULL);
+    }
+    ASSERT_TRUE (table.begin () == table.end ());
+
+    // the buckets are kept, so inserting the keys back does not resize the table
+    for (int64_t i = 0; i < 100'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+    ASSERT_EQ (table.get_resize_count (), resizeCount);
+    ASSERT_EQ (table.size (), 100'000ULL);
+
+    // clearing in the middle of an incremental resize abandons it
+    table.clear ();
+    ASSERT_TRUE (table.set_incremental_resize (true));
+    for (int64_t i = 0; (i < 1'000'000) && (table.get_pending_bucket_count () == 0); ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+    ASSERT_GT (table.get_pending_bucket_count (), 0ULL);
+
+    table.clear ();
+    ASSERT_EQ (table.get_pending_bucket_count (), 0ULL);
+    ASSERT_EQ (table.get_alloc_count () - table.get_delete_count (), liveCount);
+    ASSERT_EQ (table.size (), 0ULL);
+    ASSERT_FALSE (table.exists (0));
+    ASSERT_TRUE (table.insert (0));
+    ASSERT_TRUE (table.exists (0));
+}
+
+/**
+ * @brief                   Checks that clear releases the chunks of the slab allocator and the arena of string tables at once, and that
+ *                          keys which own memory are still destroyed
+ *
+ */
+TEST (Clear, releasesInBulk)
+{
+    AgHashTable<int64_t, ag_fnv1a<int64_t, size_t>, ag_hashtable_default_equals<int64_t>, AgChainedLayout, AgSlabAllocator<64>>    table;
+    AgHashTable<std::string, string_hash, ag_hashtable_default_equals<std::string>, AgChainedLayout, AgSlabAllocator<>>              strings;
+    AgHashMap<int64_t, std::string>         map;
+    AgStringTable<AgSlabAllocator<>>        stringTable;
+    uint64_t                                liveCount   = table.get_alloc_count () - table.get_delete_count ();
+
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        ASSERT_TRUE (strings.insert (std::string (64, 'a') + std::to_string (i)));
+        ASSERT_TRUE (map.insert (i, std::string (64, 'b')));
+        ASSERT_TRUE (stringTable.insert (std::string (40, 'k') + std::to_string (i)));
+    }
+    ASSERT_GT (table.get_pool_reserved_amount (), 0ULL);
+    ASSERT_GT (stringTable.get_arena_reserved_amount (), 0ULL);
+
+    table.clear ();
+    strings.clear ();
+    map.clear ();
+    stringTable.clear ();
+
+    ASSERT_EQ (table.get_pool_reserved_amount (), 0ULL);
+    ASSERT_EQ (table.get_pool_free_count (), 0ULL);
+    ASSERT_EQ (strings.get_pool_reserved_amount (), 0ULL);
+    ASSERT_EQ (table.get_alloc_count () - table.get_delete_count (), liveCount);
+    ASSERT_EQ (strings.get_alloc_count () - strings.get_delete_count (), liveCount);
+    ASSERT_EQ (stringTable.get_arena_reserved_amount (), 0ULL);
+    ASSERT_EQ (map.size (), 0ULL);
+
+    // the pools and the arena are used again by later insertions
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.insert (i));
+        ASSERT_TRUE (strings.insert (std::string (64, 'a') + std::to_string (i)));
+        ASSERT_TRUE (stringTable.insert (std::string (40, 'k') + std::to_string (i)));
+    }
+    for (int64_t i = 0; i < 1'000; ++i) {
+        ASSERT_TRUE (table.exists (i));
+        ASSERT_TRUE (strings.exists (std::string (64, 'a') + std::to_string (i)));
+        ASSERT_TRUE (stringTable.exists (std::string (40, 'k') + std::to_string (i)));
+    }
+    ASSERT_EQ (stringTable.size (), 1'000ULL);
+}
+
+/**
+ * @brief                   Checks that growing a table across several threads (by rehash () and by insertions) places every key in the same
+ *                          bucket as growing it on a single thread
+ *
+ */
+TEST (ParallelRehash, matchesSerial)
+{
+    AgHashTable<int64_t>    serial;
+    AgHashTable<int64_t>    parallel;
+    AgHashTable<int64_t>    grown;
+    AgGrowthPolicy          growth      = AgGrowthPolicy::memory_lean ();
+    uint64_t                resizeCount;
+
+    // buckets are kept short, so that the table is grown many times and the largest resizes are large enough to be split
+    growth.numKeysAllowed   = 2;
+    ASSERT_TRUE (serial.set_growth_policy (growth));
+    ASSERT_TRUE (parallel.set_growth_policy (growth));
+
+    ASSERT_FALSE (parallel.set_rehash_threads (0));
+    ASSERT_TRUE (parallel.set_rehash_threads (4, true));
+    ASSERT_EQ (parallel.get_rehash_threads (), 4ULL);
+    ASSERT_TRUE (parallel.get_parallel_growth ());
+
+    // only rehash () and reserve () use the threads unless growth is made parallel as well
+    ASSERT_TRUE (grown.set_rehash_threads (8));
+    ASSERT_FALSE (grown.get_parallel_growth ());
+
+    for (int64_t i = 0; i < 200'000; ++i) {
+        ASSERT_TRUE (serial.insert (i * 7));
+        ASSERT_TRUE (parallel.insert (i * 7));
+        ASSERT_TRUE (grown.insert (i * 7));
+    }
+
+    ASSERT_EQ (parallel.get_bucket_count (), serial.get_bucket_count ());
+    ASSERT_EQ (parallel.get_resize_count (), serial.get_resize_count ());
+    for (uint64_t bucketId = 0; bucketId < serial.get_bucket_count (); ++bucketId) {
+        ASSERT_EQ (parallel.get_bucket_key_count (bucketId), serial.get_bucket_key_count (bucketId));
+        ASSERT_EQ (parallel.get_bucket_hash_count (bucketId), serial.get_bucket_hash_count (bucketId));
+    }
+
+    // growing a large table explicitly splits its buckets across the threads
+    resizeCount     = grown.get_resize_count ();
+    ASSERT_TRUE (grown.rehash (serial.get_bucket_count () * 8));
+    ASSERT_TRUE (serial.rehash (serial.get_bucket_count () * 8));
+    ASSERT_EQ (grown.get_resize_count (), resizeCount + 1);
+    ASSERT_EQ (grown.get_bucket_count (), serial.get_bucket_count ());
+
+    for (uint64_t bucketId = 0; bucketId < serial.get_bucket_count (); ++bucketId) {
+        ASSERT_EQ (grown.get_bucket_key_count (bucketId), serial.get_bucket_key_count (bucketId));
+    }
+    for (int64_t i = 0; i < 200'000; ++i) {
+        ASSERT_TRUE (grown.exists (i * 7));
+        ASSERT_TRUE (parallel.exists (i * 7));
+        ASSERT_FALSE (parallel.exists (i * 7 + 1));
+    }
+
+    // shrinking is never split across threads, but must still keep every key
+    ASSERT_TRUE (grown.shrink_to_fit ());
+    ASSERT_EQ (grown.size (), 200'000ULL);
+    ASSERT_TRUE (grown.exists (7 * 199'999));
+}
+
+TEST (InlineHead, followsFirstAggregate)
+{
+    AgHashTable<uint64_t, unsigned_identity<uint64_t>>  table;
+    AgHashTable<int64_t, mod2<int64_t>>                 pairs;
+    AgGrowthPolicy                                      growth      = AgGrowthPolicy::balanced ();
+    uint64_t                                            bucketCount;
+
+    // the table never grows, so that multiples of the bucket count all fall in the first bucket, each with its own hash
+    growth.numDistinctAllowed   = std::numeric_limits<uint64_t>::max ();
+    ASSERT_TRUE (table.set_growth_policy (growth));
+    bucketCount = table.get_bucket_count ();
+
+    for (uint64_t i = 0; i < 8; ++i) {
+        ASSERT_TRUE (table.insert (i * bucketCount));
+    }
+    ASSERT_EQ (table.get_bucket_hash_count (0), 8ULL);
+    ASSERT_FALSE (table.exists (8 * bucketCount));
+    ASSERT_FALSE (table.exists (1));
+
+    // the first aggregate node of the bucket is removed, so the next one has to take its place in the bucket
+    for (uint64_t i = 0; i < 8; ++i) {
+        ASSERT_TRUE (table.erase (i * bucketCount));
+        ASSERT_FALSE (table.exists (i * bucketCount));
+        ASSERT_TRUE (table.find (i * bucketCount) == table.end ());
+
+        for (uint64_t j = i + 1; j < 8; ++j) {
+            ASSERT_TRUE (table.exists (j * bucketCount));
+            ASSERT_EQ (*table.find (j * bucketCount), j * bucketCount);
+        }
+    }
+    ASSERT_EQ (table.get_bucket_key_count (0), 0ULL);
+
+    // resizing and copying place aggregate nodes at the front of their buckets
+    for (uint64_t i = 0; i < 64; ++i) {
+        ASSERT_TRUE (table.insert (i * bucketCount));
+    }
+    ASSERT_TRUE (table.rehash (bucketCount * 4));
+
+    auto    copy    = table.clone ();
+    ASSERT_TRUE (copy.initialized ());
+
+    for (uint64_t i = 0; i < 64; ++i) {
+        ASSERT_TRUE (table.exists (i * bucketCount));
+        ASSERT_TRUE (copy.exists (i * bucketCount));
+        ASSERT_FALSE (copy.exists (i * bucketCount + 1));
+    }
+
+    // the first node of the first aggregate node changes as well when it is erased
+    for (int64_t i = 0; i < 100; ++i) {
+        ASSERT_TRUE (pairs.insert (i));
+    }
+    for (int64_t i = 0; i < 100; i += 3) {
+        ASSERT_TRUE (pairs.erase (i));
+        ASSERT_FALSE (pairs.exists (i));
+    }
+    for (int64_t i = 0; i < 100; ++i) {
+        ASSERT_EQ (pairs.exists (i), (i % 3) != 0);
+        ASSERT_EQ (pairs.find (i) != pairs.end (), (i % 3) != 0);
+    }
+    ASSERT_EQ (pairs.exists_batch (std::vector<int64_t> {0, 1, 2, 3, 4}.data (), 5, nullptr), 3ULL);
+}
@@ -0,0 +1,498 @@
+/**
+ * @file            test_concurrent.cpp
+ * @author          Aditya Agarwal (aditya.agarwal@dumblebots.com)
+ *
+ * @brief           Unit tests for AgHashTable class when it is used by multiple threads at the same time
+ *
+ * @note            These tests are built separately from test.cpp, since AG_HASH_TABLE_MULTITHREADED_MODE changes the layout of the class
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#define AG_DBG_MODE
+#define AG_HASH_TABLE_MULTITHREADED_MODE
+#include "AgHashTable.h"
+#include "AgHashMap.h"
+#include "AgConcurrentHashSet.h"
+
+static constexpr int32_t    sThreadCount    = 8;                /** Number of threads to use in each test */
+static constexpr int32_t    sKeysPerThread  = 20000;            /** Number of keys each thread works with */
+
+/**
+ * @brief                   Returns an integer modulo 4 (forces many keys to share the same hash)
+ *
+ * @param pKey              Pointer to the integer
+ *
+ * @return uint8_t          Integer modulo 4
+ */
+inline uint8_t
+mod4 (const int32_t *pKey)
+{
+    return (uint8_t)(*pKey & 3);
+}
+
+/**
+ * @brief                   Runs the given function on sThreadCount threads at the same time and waits for all of them to finish
+ *
+ * @tparam func_t           Type of function to run (must accept the id of the thread as its only parameter)
+ *
+ * @param pFunc             Function to run
+ */
+template <typename func_t>
+void
+run_threads (func_t pFunc)
+{
+    std::vector<std::thread>    threads;
+
+    for (int32_t threadId = 0; threadId < sThreadCount; ++threadId) {
+        threads.emplace_back (pFunc, threadId);
+    }
+
+    for (auto &thread : threads) {
+        thread.join ();
+    }
+}
+
+/**
+ * @brief                   Every thread inserts a disjoint range of keys into a small table (forcing many resizes while
+ *                          other threads are inserting), after which every key must be present exactly once
+ *
+ */
+TEST (Concurrent, disjointInserts)
+{
+    AgHashTable<int32_t>    table   {2};
+
+    run_threads ([&table] (int32_t pThreadId) {
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_TRUE (table.insert (pThreadId * sKeysPerThread + i));
+        }
+    });
+
+    ASSERT_EQ (table.get_key_count (), (uint64_t)(sThreadCount * sKeysPerThread));
+    ASSERT_GT (table.get_resize_count (), 0ULL);
+
+    for (int32_t key = 0; key < sThreadCount * sKeysPerThread; ++key) {
+        ASSERT_TRUE (table.exists (key));
+        ASSERT_FALSE (table.insert (key));
+    }
+}
+
+/**
+ * @brief                   Every thread tries to insert the same keys, so exactly one insertion of each key must succeed
+ *
+ */
+TEST (Concurrent, duplicateInserts)
+{
+    AgHashTable<int32_t>    table;
+    std::atomic<int64_t>    successCnt  {0};
+
+    run_threads ([&table, &successCnt] (int32_t pThreadId) {
+        (void)pThreadId;
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            if (table.insert (i)) {
+                ++successCnt;
+            }
+        }
+    });
+
+    ASSERT_EQ (successCnt.load (), sKeysPerThread);
+    ASSERT_EQ (table.get_key_count (), (uint64_t)sKeysPerThread);
+}
+
+/**
+ * @brief                   Half the threads insert and erase their own keys while the other half keep looking up keys
+ *                          which are never erased, so the lookups must always succeed
+ *
+ */
+TEST (Concurrent, mixedOperations)
+{
+    AgHashTable<int32_t>    table;
+
+    // keys in [0, sKeysPerThread) are never erased
+    for (int32_t i = 0; i < sKeysPerThread; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+
+    run_threads ([&table] (int32_t pThreadId) {
+
+        int32_t     base    = (pThreadId + 1) * sKeysPerThread;
+
+        if (pThreadId % 2 == 0) {
+            for (int32_t i = 0; i < sKeysPerThread; ++i) {
+                ASSERT_TRUE (table.insert (base + i));
+            }
+            for (int32_t i = 0; i < sKeysPerThread; i += 2) {
+                ASSERT_TRUE (table.erase (base + i));
+                ASSERT_FALSE (table.erase (base + i));
+            }
+        }
+        else {
+            for (int32_t i = 0; i < sKeysPerThread; ++i) {
+                ASSERT_TRUE (table.exists (i));
+                ASSERT_NE (table.find (i), table.end ());
+            }
+        }
+    });
+
+    for (int32_t threadId = 0; threadId < sThreadCount; threadId += 2) {
+
+        int32_t     base    = (threadId + 1) * sKeysPerThread;
+
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_EQ (table.exists (base + i), (i % 2) == 1);
+        }
+    }
+
+    ASSERT_EQ (table.get_key_count (), (uint64_t)(sKeysPerThread + ((sThreadCount + 1) / 2) * (sKeysPerThread / 2)));
+}
+
+/**
+ * @brief                   Threads insert and erase their own keys in a table whose nodes come from a slab allocator, so slots are
+ *                          freed into the shard of a different thread than the one which carved them out
+ *
+ */
+TEST (Concurrent, slabAllocator)
+{
+    AgHashTable<int32_t, ag_default_hash<int32_t, size_t> (), ag_hashtable_default_equals<int32_t>, AgChainedLayout, AgSlabAllocator<64>>   table;
+
+    // keys in [0, sKeysPerThread) are inserted here and erased by the threads
+    for (int32_t i = 0; i < sKeysPerThread; ++i) {
+        ASSERT_TRUE (table.insert (i));
+    }
+
+    run_threads ([&table] (int32_t pThreadId) {
+
+        int32_t     base    = (pThreadId + 1) * sKeysPerThread;
+
+        for (int32_t i = pThreadId; i < sKeysPerThread; i += sThreadCount) {
+            ASSERT_TRUE (table.erase (i));
+        }
+        for (int32_t round = 0; round < 4; ++round) {
+            for (int32_t i = 0; i < sKeysPerThread; ++i) {
+                ASSERT_TRUE (table.insert (base + i));
+            }
+            for (int32_t i = 0; i < sKeysPerThread; i += (round == 3) ? (2) : (1)) {
+                ASSERT_TRUE (table.erase (base + i));
+            }
+        }
+    });
+
+    ASSERT_EQ (table.get_key_count (), (uint64_t)(sThreadCount * (sKeysPerThread / 2)));
+    for (int32_t threadId = 0; threadId < sThreadCount; ++threadId) {
+
+        int32_t     base    = (threadId + 1) * sKeysPerThread;
+
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_EQ (table.exists (base + i), (i % 2) == 1);
+        }
+    }
+
+    table.clear ();
+    ASSERT_EQ (table.get_pool_reserved_amount (), 0ULL);
+}
+
+/**
+ * @brief                   The flat layouts are guarded by a single lock, but must still be safe to use from multiple threads
+ *
+ */
+TEST (Concurrent, flatLayouts)
+{
+    AgHashTable<int32_t, ag_fnv1a<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgSwissLayout>                                    swiss;
+    AgHashTable<int32_t, ag_fnv1a<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgOpenAddressingLayout<AgProbeRobinHood>>        robinHood;
+    AgHashTable<int32_t, ag_fnv1a<int32_t, size_t>, ag_hashtable_default_equals<int32_t>, AgCuckooLayout<4>>                                cuckoo;
+
+    run_threads ([&swiss, &robinHood, &cuckoo] (int32_t pThreadId) {
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_TRUE (swiss.insert (pThreadId * sKeysPerThread + i));
+            ASSERT_TRUE (robinHood.insert (pThreadId * sKeysPerThread + i));
+            ASSERT_TRUE (cuckoo.insert (pThreadId * sKeysPerThread + i));
+        }
+        for (int32_t i = 0; i < sKeysPerThread; i += 2) {
+            ASSERT_TRUE (swiss.erase (pThreadId * sKeysPerThread + i));
+            ASSERT_TRUE (robinHood.erase (pThreadId * sKeysPerThread + i));
+            ASSERT_TRUE (cuckoo.erase (pThreadId * sKeysPerThread + i));
+        }
+    });
+
+    ASSERT_EQ (swiss.get_key_count (), (uint64_t)(sThreadCount * sKeysPerThread / 2));
+    ASSERT_EQ (robinHood.get_key_count (), (uint64_t)(sThreadCount * sKeysPerThread / 2));
+    ASSERT_EQ (cuckoo.get_key_count (), (uint64_t)(sThreadCount * sKeysPerThread / 2));
+
+    for (int32_t key = 0; key < sThreadCount * sKeysPerThread; ++key) {
+        ASSERT_EQ (swiss.exists (key), (key % 2) == 1);
+        ASSERT_EQ (robinHood.exists (key), (key % 2) == 1);
+        ASSERT_EQ (cuckoo.exists (key), (key % 2) == 1);
+    }
+}
+
+/**
+ * @brief                   The batched operations handle one key at a time in multithreaded mode, but must still be safe to use
+ *                          from multiple threads
+ *
+ */
+TEST (Concurrent, batchOperations)
+{
+    AgHashTable<int32_t>    table   {2};
+
+    run_threads ([&table] (int32_t pThreadId) {
+
+        std::vector<int32_t>    keys;
+
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            keys.push_back (pThreadId * sKeysPerThread + i);
+        }
+
+        ASSERT_EQ (table.insert_batch (keys.data (), keys.size ()), (uint64_t)sKeysPerThread);
+        ASSERT_EQ (table.exists_batch (keys.data (), keys.size (), nullptr), (uint64_t)sKeysPerThread);
+    });
+
+    ASSERT_EQ (table.get_key_count (), (uint64_t)(sThreadCount * sKeysPerThread));
+}
+
+/**
+ * @brief                   Every thread increments the counts of the same keys with update (), so no increment may be lost
+ *
+ */
+TEST (Concurrent, mapUpdate)
+{
+    AgHashMap<int32_t, int64_t>     map     {2};
+
+    run_threads ([&map] (int32_t pThreadId) {
+        (void)pThreadId;
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_TRUE (map.update (i % 1'000, [] (int64_t &pCount) { ++pCount; }));
+        }
+    });
+
+    ASSERT_EQ (map.get_key_count (), 1'000ULL);
+
+    for (int32_t key = 0; key < 1'000; ++key) {
+        ASSERT_EQ ((*map.find (key)).value, (int64_t)(sThreadCount * (sKeysPerThread / 1'000)));
+    }
+}
+
+/**
+ * @brief                   Every thread inserts its own keys and erases all but one of them, so the table shrinks while other threads
+ *                          are still erasing, but never below the number of locks
+ *
+ */
+TEST (Concurrent, shrinkingErases)
+{
+    AgHashTable<int32_t>    table;
+    AgGrowthPolicy          growth      = AgGrowthPolicy::balanced ();
+    uint64_t                peakCount;
+
+    growth.shrinkLoadPercent    = 50;
+    ASSERT_TRUE (table.set_growth_policy (growth));
+
+    run_threads ([&table] (int32_t pThreadId) {
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_TRUE (table.insert (pThreadId * sKeysPerThread + i));
+        }
+    });
+    peakCount   = table.get_bucket_count ();
+
+    run_threads ([&table] (int32_t pThreadId) {
+        for (int32_t i = 1; i < sKeysPerThread; ++i) {
+            ASSERT_TRUE (table.erase (pThreadId * sKeysPerThread + i));
+            ASSERT_TRUE (table.exists (pThreadId * sKeysPerThread));
+        }
+    });
+
+    ASSERT_EQ (table.get_key_count (), (uint64_t)sThreadCount);
+    ASSERT_LT (table.get_bucket_count (), peakCount);
+    ASSERT_EQ (table.get_bucket_count (), 64ULL);
+
+    for (int32_t key = 0; key < sThreadCount * sKeysPerThread; ++key) {
+        ASSERT_EQ (table.exists (key), (key % sKeysPerThread) == 0);
+    }
+}
+
+/**
+ * @brief                   Every thread inserts its own keys into a table whose growth is split across several threads, with buckets kept short
+ *                          so that the table is grown many times (and the largest resizes are large enough to be split)
+ *
+ */
+TEST (Concurrent, parallelGrowth)
+{
+    AgHashTable<int32_t>    table;
+    AgGrowthPolicy          growth      = AgGrowthPolicy::memory_lean ();
+
+    growth.numKeysAllowed   = 2;
+    ASSERT_TRUE (table.set_growth_policy (growth));
+    ASSERT_TRUE (table.set_rehash_threads (4, true));
+
+    run_threads ([&table] (int32_t pThreadId) {
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_TRUE (table.insert (pThreadId * sKeysPerThread + i));
+            ASSERT_TRUE (table.exists (pThreadId * sKeysPerThread + i / 2));
+        }
+    });
+
+    ASSERT_GE (table.get_bucket_count (), 1ULL << 16);
+    ASSERT_EQ (table.get_key_count (), (uint64_t)(sThreadCount * sKeysPerThread));
+    for (int32_t key = 0; key < sThreadCount * sKeysPerThread; ++key) {
+        ASSERT_TRUE (table.exists (key));
+    }
+}
+
+/**
+ * @brief                   One thread keeps cloning the table while the others insert into it, so every clone must be a consistent
+ *                          snapshot (holding exactly as many keys as it claims to), after which the table is moved into place
+ *
+ */
+TEST (Concurrent, cloneDuringInserts)
+{
+    AgHashTable<int32_t>    table   {2};
+    AgHashTable<int32_t>    target;
+
+    run_threads ([&table] (int32_t pThreadId) {
+
+        if (pThreadId == 0) {
+            for (int32_t round = 0; round < 32; ++round) {
+
+                AgHashTable<int32_t>    copy        = table.clone ();
+                uint64_t                iterated    = 0;
+
+                ASSERT_TRUE (copy.initialized ());
+                for (auto it = copy.begin (); it != copy.end (); ++it) {
+                    ASSERT_TRUE (table.exists (*it));
+                    ++iterated;
+                }
+                ASSERT_EQ (iterated, copy.size ());
+            }
+            return;
+        }
+
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_TRUE (table.insert (pThreadId * sKeysPerThread + i));
+        }
+    });
+
+    target      = std::move (table);
+    ASSERT_EQ (target.get_key_count (), (uint64_t)((sThreadCount - 1) * sKeysPerThread));
+    for (int32_t key = sKeysPerThread; key < sThreadCount * sKeysPerThread; ++key) {
+        ASSERT_TRUE (target.exists (key));
+    }
+}
+
+/**
+ * @brief                   Basic operations of the lock-free set from a single thread, with enough keys to double the number of buckets many times
+ *
+ */
+TEST (LockFree, SmokeTest)
+{
+    AgConcurrentHashSet<int32_t>    set     {2};
+
+    for (int32_t key = 0; key < sKeysPerThread; ++key) {
+        ASSERT_TRUE (set.insert (key));
+        ASSERT_FALSE (set.insert (key));
+    }
+
+    ASSERT_EQ (set.get_key_count (), (uint64_t)sKeysPerThread);
+    ASSERT_GT (set.get_bucket_count (), 2ULL);
+
+    for (int32_t key = 0; key < sKeysPerThread; key += 2) {
+        ASSERT_TRUE (set.erase (key));
+        ASSERT_FALSE (set.erase (key));
+    }
+
+    for (int32_t key = 0; key < sKeysPerThread; ++key) {
+        ASSERT_EQ (set.exists (key), (key % 2) == 1);
+    }
+
+    ASSERT_FALSE (set.exists (-1));
+    ASSERT_EQ (set.get_key_count (), (uint64_t)(sKeysPerThread / 2));
+}
+
+/**
+ * @brief                   Keys which share the same hash (and so the same position in the list) must still be told apart
+ *
+ */
+TEST (LockFree, collisions)
+{
+    AgConcurrentHashSet<int32_t, mod4>  set;
+
+    for (int32_t key = 0; key < 64; ++key) {
+        ASSERT_TRUE (set.insert (key));
+    }
+
+    for (int32_t key = 0; key < 64; key += 3) {
+        ASSERT_TRUE (set.erase (key));
+    }
+
+    for (int32_t key = 0; key < 64; ++key) {
+        ASSERT_EQ (set.exists (key), (key % 3) != 0);
+        ASSERT_EQ (set.insert (key), (key % 3) == 0);
+    }
+}
+
+/**
+ * @brief                   Every thread inserts, erases and looks up its own keys while also inserting the same shared keys as
+ *                          every other thread (exactly one insertion of each shared key must succeed)
+ *
+ */
+TEST (LockFree, mixedOperations)
+{
+    AgConcurrentHashSet<int32_t>    set     {2};
+    std::atomic<int64_t>            sharedCnt   {0};
+
+    run_threads ([&set, &sharedCnt] (int32_t pThreadId) {
+
+        int32_t     base    = (pThreadId + 1) * sKeysPerThread;
+
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_TRUE (set.insert (base + i));
+            if (set.insert (i)) {
+                ++sharedCnt;
+            }
+        }
+
+        for (int32_t i = 0; i < sKeysPerThread; i += 2) {
+            ASSERT_TRUE (set.erase (base + i));
+        }
+
+        for (int32_t i = 0; i < sKeysPerThread; ++i) {
+            ASSERT_EQ (set.exists (base + i), (i % 2) == 1);
+            ASSERT_TRUE (set.exists (i));
+        }
+    });
+
+    ASSERT_EQ (sharedCnt.load (), sKeysPerThread);
+    ASSERT_EQ (set.get_key_count (), (uint64_t)(sKeysPerThread + sThreadCount * (sKeysPerThread / 2)));
+}
+
+/**
+ * @brief                   Readers keep looking up keys while writers repeatedly erase and insert them again, so erased nodes are
+ *                          retired while they are being read (run under a sanitizer to catch use after free)
+ *
+ */
+TEST (LockFree, readersDuringErase)
+{
+    AgConcurrentHashSet<int32_t>    set;
+
+    for (int32_t key = 0; key < 1024; ++key) {
+        ASSERT_TRUE (set.insert (key));
+    }
+
+    run_threads ([&set] (int32_t pThreadId) {
+        for (int32_t round = 0; round < 16; ++round) {
+            for (int32_t key = 0; key < 1024; ++key) {
+                if (pThreadId % 2 == 0) {
+                    set.erase (key);
+                    set.insert (key);
+                }
+                else {
+                    set.exists (key);
+                }
+            }
+        }
+    });
+
+    for (int32_t key = 0; key < 1024; ++key) {
+        ASSERT_TRUE (set.exists (key));
+    }
+}